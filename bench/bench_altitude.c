@@ -0,0 +1,143 @@
+/**
+ * @brief fixed point altitude of BMP280_Altitude against the barometric formula with powf, error
+ * and time per sample
+ *
+ * The error is taken against the formula in double over 300 to 1100 hPa in 1 Pa steps, for the
+ * standard sea level reference and two others, timed, then for references across 300 to 1100 hPa
+ * every 1 hPa with pressure in 13 Pa steps, untimed. The fixed point path gets Q24.8 pressure as
+ * bmp280_get_temp_press_fixed returns it, the powf path the float pressure of
+ * bmp280_get_temp_press. On the host both run on hardware floating point, on a soft float target
+ * the gap is wider
+ *
+ * @file bench_altitude.c
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#include <math.h>
+#include <stdio.h>
+
+#include "host/Host_TimeSource.h"
+#include "include/BMP280_Altitude.h"
+
+#define BENCH_EXPONENT 0.1903
+#define BENCH_MIN_PA 30000
+#define BENCH_MAX_PA 110000
+#define BENCH_TOTAL_ROUND 50
+#define BENCH_MAX_ERR_MM 8  // 7 mm measured when the table was made
+#define BENCH_MAX_SWEEP_ERR_MM 9  // 8 mm measured in 1 Pa steps, at the lowest references
+#define BENCH_SWEEP_REF_STEP_PA 100
+#define BENCH_SWEEP_STEP_PA 13
+
+static const uint32_t benchReferencePa[] = {101325, 95000, 85000};
+
+static volatile int64_t benchSink;
+
+static float bench_altitude_powf(const float pressPa, const float referencePa) {
+  return 44330.0f * (1.0f - powf(pressPa / referencePa, (float)BENCH_EXPONENT));
+}
+
+// largest error over the pressure range in stepPa steps, plus a fraction so the Q24.8 fraction bits
+// are exercised
+static double bench_max_err_mm(const Bmp280Altitude* altitude,
+                               const uint32_t        stepPa,
+                               double*               sumErrMm,
+                               int*                  totalStep) {
+  double referencePa = altitude->referenceQ8 / 256.0;
+  double maxErrMm    = 0;
+  for (uint32_t pressPa = BENCH_MIN_PA; pressPa < BENCH_MAX_PA; pressPa += stepPa) {
+    uint32_t pressQ8    = pressPa * 256 + (pressPa * 37) % 256;
+    double   expectedMm = 44330000.0 * (1.0 - pow(pressQ8 / 256.0 / referencePa, BENCH_EXPONENT));
+    double   errMm      = fabs(bmp280_altitude_mm(altitude, pressQ8) - expectedMm);
+    *sumErrMm += errMm;
+    ++*totalStep;
+    if (errMm > maxErrMm) { maxErrMm = errMm; }
+  }
+  return maxErrMm;
+}
+
+// every reference the API takes, the worst of them
+static bool bench_sweep_reference(void) {
+  double   maxErrMm   = 0;
+  uint32_t worstRefQ8 = 0;
+  int      totalRef   = 0;
+  double   sumErrMm   = 0;
+  int      totalStep  = 0;
+  for (uint32_t referencePa = BENCH_MIN_PA; referencePa <= BENCH_MAX_PA;
+       referencePa += BENCH_SWEEP_REF_STEP_PA) {
+    Bmp280Altitude altitude;
+    uint32_t       referenceQ8 = referencePa * 256 + (referencePa * 91) % 256;
+    if (referenceQ8 > BMP280_ALTITUDE_MAX_Q8) { referenceQ8 = BMP280_ALTITUDE_MAX_Q8; }
+    bmp280_altitude_set_reference(&altitude, referenceQ8);
+    double errMm = bench_max_err_mm(&altitude, BENCH_SWEEP_STEP_PA, &sumErrMm, &totalStep);
+    if (errMm > maxErrMm) {
+      maxErrMm   = errMm;
+      worstRefQ8 = referenceQ8;
+    }
+    ++totalRef;
+  }
+
+  bool isOk = maxErrMm <= BENCH_MAX_SWEEP_ERR_MM;
+  printf("%d references over 300 to 1100 hPa: fixed max %.2f mm at p0 %.2f Pa, mean %.2f mm, %s\n",
+         totalRef,
+         maxErrMm,
+         worstRefQ8 / 256.0,
+         sumErrMm / totalStep,
+         isOk ? "ok" : "OVER LIMIT");
+  return isOk;
+}
+
+int main(void) {
+  bool isAllOk = true;
+  for (size_t refIndex = 0; refIndex < sizeof(benchReferencePa) / sizeof(benchReferencePa[0]);
+       ++refIndex) {
+    Bmp280Altitude altitude;
+    uint32_t       referencePa = benchReferencePa[refIndex];
+    bmp280_altitude_set_reference(&altitude, referencePa * 256);
+
+    double sumFixedErrMm = 0;
+    int    totalStep     = 0;
+    double maxFixedErrMm = bench_max_err_mm(&altitude, 1, &sumFixedErrMm, &totalStep);
+    double maxFloatErrMm = 0;
+    for (uint32_t pressPa = BENCH_MIN_PA; pressPa < BENCH_MAX_PA; ++pressPa) {
+      double exactPa    = (pressPa * 256 + (pressPa * 37) % 256) / 256.0;
+      double expectedMm = 44330000.0 * (1.0 - pow(exactPa / referencePa, BENCH_EXPONENT));
+      double floatErrMm =
+          fabs(1000.0 * bench_altitude_powf((float)exactPa, (float)referencePa) - expectedMm);
+      if (floatErrMm > maxFloatErrMm) { maxFloatErrMm = floatErrMm; }
+    }
+
+    int64_t  sum     = 0;
+    uint64_t startNs = host_time_now_ns();
+    for (int round = 0; round < BENCH_TOTAL_ROUND; ++round) {
+      for (uint32_t pressPa = BENCH_MIN_PA; pressPa <= BENCH_MAX_PA; ++pressPa) {
+        sum += bmp280_altitude_mm(&altitude, pressPa * 256);
+      }
+    }
+    uint64_t fixedNs = host_time_now_ns() - startNs;
+    float    sumM    = 0;
+    startNs          = host_time_now_ns();
+    for (int round = 0; round < BENCH_TOTAL_ROUND; ++round) {
+      for (uint32_t pressPa = BENCH_MIN_PA; pressPa <= BENCH_MAX_PA; ++pressPa) {
+        sumM += bench_altitude_powf((float)pressPa, (float)referencePa);
+      }
+    }
+    uint64_t floatNs = host_time_now_ns() - startNs;
+    benchSink        = sum + (int64_t)sumM;
+
+    bool   isOk       = maxFixedErrMm <= BENCH_MAX_ERR_MM;
+    double totalCall  = (double)totalStep * BENCH_TOTAL_ROUND;
+    isAllOk           = isAllOk && isOk;
+    printf("p0 %u Pa: fixed max %.2f mean %.2f mm %.2f ns, powf max %.2f mm %.2f ns, %.2fx, %s\n",
+           referencePa,
+           maxFixedErrMm,
+           sumFixedErrMm / totalStep,
+           fixedNs / totalCall,
+           maxFloatErrMm,
+           floatNs / totalCall,
+           (double)floatNs / (fixedNs ? fixedNs : 1),
+           isOk ? "ok" : "OVER LIMIT");
+  }
+  isAllOk = bench_sweep_reference() && isAllOk;
+  return isAllOk ? 0 : 2;
+}
@@ -0,0 +1,241 @@
+/**
+ * @brief compression ratio and speed of BMP280_Compress on a recorded raw sample stream
+ *
+ * The stream is a raw log from bmp280_rawlog capture when one is given, otherwise the simulated
+ * bmp280 is sampled at 10 Hz in forced mode with sensor noise on its waveforms. Each keyframe
+ * interval is checked for a lossless round trip and timed on the host, the TM4C has no cycle
+ * counter model here so the time per sample is host time. Every truncation of a keyframe block is
+ * also checked to be rejected without moving the decoder
+ *
+ * @code
+ * bench_compress [raw.log]
+ * @endcode
+ *
+ * @file bench_compress.c
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "host/Host_TimeSource.h"
+#include "host/sim/Sim_BMP280.h"
+#include "host/sim/Sim_TM4C.h"
+#include "include/BMP280_Compress.h"
+#include "include/BMP280_Drv.h"
+#include "include/BMP280_RawLog.h"
+#include "include/BMP280_Utils.h"
+
+#define BENCH_I2C_ADDR 0x77
+#define BENCH_PERIOD_NS 100000000ULL
+#define BENCH_SIM_SAMPLE 6000
+#define BENCH_MAX_SAMPLE 100000
+#define BENCH_TIMING_SAMPLE 2000000  // samples encoded per timing run, the stream is repeated
+#define BENCH_PACKED_SAMPLE 5        // the adc values packed like BMP280_RawLog
+#define BENCH_FLOAT_SAMPLE 8         // two floats
+
+static SimBmp280 simSensor;
+static int32_t   rawTemp[BENCH_MAX_SAMPLE];
+static int32_t   rawPress[BENCH_MAX_SAMPLE];
+static int32_t   decodedTemp[BENCH_MAX_SAMPLE];
+static int32_t   decodedPress[BENCH_MAX_SAMPLE];
+static uint8_t   stream[BENCH_MAX_SAMPLE * BMP280_COMPRESS_MAX_BLOCK / BMP280_COMPRESS_BLOCK +
+                      BMP280_COMPRESS_MAX_BLOCK];
+static uint8_t   rawLog[BMP280_RAW_LOG_HEADER_SIZE + BENCH_MAX_SAMPLE * BMP280_RAW_LOG_MAX_RECORD];
+
+static const uint16_t benchKeyInterval[] = {1, 4, 16, 64};
+
+// roughly gaussian with the given standard deviation
+static double bench_noise(const double sigma) {
+  double sum = 0;
+  for (int termIndex = 0; termIndex < 4; ++termIndex) { sum += (double)rand() / RAND_MAX - 0.5; }
+  return sum * sigma * sqrt(3.0);
+}
+
+// a node carried up and down a few floors, over a slow weather drift
+static double bench_temperature(void* context, const uint64_t timeNs) {
+  (void)context;
+  return 22.0 + 0.5 * sin((double)timeNs * 1e-9 * 2 * M_PI / 600) + bench_noise(0.005);
+}
+
+static double bench_pressure(void* context, const uint64_t timeNs) {
+  (void)context;
+  double timeS = (double)timeNs * 1e-9;
+  return 101000.0 + 36.0 * sin(timeS * 2 * M_PI / 120) + 0.01 * timeS + bench_noise(1.3);
+}
+
+static int bench_load(const char* path) {
+  Bmp280RawLogDecoder decoder;
+  Bmp280RawSample     sample;
+  FILE*               file = fopen(path, "rb");
+  if (NULL == file) { return 0; }
+  uint32_t size = (uint32_t)fread(rawLog, 1, sizeof(rawLog), file);
+  fclose(file);
+  if (!bmp280_raw_log_open(&decoder, rawLog, size)) { return 0; }
+
+  int totalSample = 0;
+  for (uint32_t offset = BMP280_RAW_LOG_HEADER_SIZE;
+       offset < size && totalSample < BENCH_MAX_SAMPLE;
+       ++totalSample) {
+    offset = bmp280_raw_log_decode(&decoder, rawLog, size, offset, &sample);
+    if (0 == offset) { break; }
+    rawTemp[totalSample]  = sample.rawTemp;
+    rawPress[totalSample] = sample.rawPress;
+  }
+  return totalSample;
+}
+
+static int bench_capture(void) {
+  bmp280 sensor;
+
+  sim_tm4c_reset();
+  sim_bmp280_init(&simSensor);
+  simSensor.waveform.temperatureC = bench_temperature;
+  simSensor.waveform.pressurePa   = bench_pressure;
+  sim_bmp280_attach_i2c(&simSensor, BENCH_I2C_ADDR);
+
+  Bmp280ErrCode errCode = bmp280_create_predefined_settings(&sensor, WeatherStat);
+  if (ERR_NO_ERR == errCode) { errCode = bmp280_init(&sensor, I2C, BENCH_I2C_ADDR); }
+  if (ERR_NO_ERR == errCode) { errCode = bmp280_open(&sensor); }
+  if (ERR_NO_ERR == errCode) { errCode = bmp280_reset(&sensor); }
+
+  int totalSample = 0;
+  for (; ERR_NO_ERR == errCode && totalSample < BENCH_SIM_SAMPLE; ++totalSample) {
+    uint64_t periodStartNs = sim_now_ns();
+    errCode                = bmp280_update_setting(&sensor);
+    sim_advance_ns((uint64_t)bmp280_measure_time_us(&sensor) * 1000);
+    if (ERR_NO_ERR == errCode) {
+      errCode = bmp280_get_raw_temp_press(&sensor, &rawTemp[totalSample], &rawPress[totalSample]);
+    }
+    sim_advance_ns(BENCH_PERIOD_NS - (sim_now_ns() - periodStartNs));
+  }
+  return (ERR_NO_ERR == errCode) ? totalSample : 0;
+}
+
+static uint32_t bench_encode(const int totalSample, const uint16_t keyInterval) {
+  Bmp280CompressEncoder encoder;
+  uint32_t              size = 0;
+  bmp280_compress_init(&encoder, keyInterval);
+  for (int sampleIndex = 0; sampleIndex < totalSample; ++sampleIndex) {
+    size +=
+        bmp280_compress_add(&encoder, rawTemp[sampleIndex], rawPress[sampleIndex], &stream[size]);
+  }
+  size += bmp280_compress_flush(&encoder, &stream[size]);
+  return size;
+}
+
+static bool bench_decode(const uint32_t size, const int totalSample) {
+  Bmp280CompressDecoder decoder;
+  int                   total = 0;
+  bmp280_decompress_init(&decoder);
+  for (uint32_t offset = 0; offset < size;) {
+    uint8_t  blockSample;
+    uint16_t used = bmp280_decompress_block(&decoder,
+                                            &stream[offset],
+                                            size - offset,
+                                            &decodedTemp[total],
+                                            &decodedPress[total],
+                                            &blockSample);
+    if (0 == used) { return false; }
+    offset += used;
+    total += blockSample;
+  }
+  return total == totalSample;
+}
+
+static bool bench_round_trip(const uint32_t size, const int totalSample) {
+  if (!bench_decode(size, totalSample)) { return false; }
+  for (int sampleIndex = 0; sampleIndex < totalSample; ++sampleIndex) {
+    if (decodedTemp[sampleIndex] != (rawTemp[sampleIndex] & 0xFFFFF) ||
+        decodedPress[sampleIndex] != (rawPress[sampleIndex] & 0xFFFFF)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief feed the second block, a keyframe, cut short at every length, then whole, the cut ones
+ * must be rejected and leave the decoder as the first block left it
+ *
+ */
+static bool bench_truncated_keyframe(const int totalSample) {
+  uint32_t              size = bench_encode(totalSample, 1);
+  Bmp280CompressDecoder decoder;
+  Bmp280CompressDecoder afterFirst;
+  uint8_t               blockSample;
+  bmp280_decompress_init(&decoder);
+  uint16_t firstSize =
+      bmp280_decompress_block(&decoder, stream, size, decodedTemp, decodedPress, &blockSample);
+  if (0 == firstSize) { return false; }
+  afterFirst = decoder;
+
+  const uint8_t* second     = &stream[firstSize];
+  uint16_t       secondSize = bmp280_decompress_block(&decoder,
+                                                second,
+                                                size - firstSize,
+                                                decodedTemp,
+                                                decodedPress,
+                                                &blockSample);
+  for (uint16_t cutSize = 0; cutSize < secondSize; ++cutSize) {
+    decoder       = afterFirst;
+    uint16_t used = bmp280_decompress_block(
+        &decoder, second, cutSize, decodedTemp, decodedPress, &blockSample);
+    if (0 != used || decoder.hasKeyframe != afterFirst.hasKeyframe ||
+        decoder.lastTemp != afterFirst.lastTemp || decoder.lastPress != afterFirst.lastPress) {
+      return false;
+    }
+  }
+  return secondSize > 0 && decodedPress[0] == (rawPress[BMP280_COMPRESS_BLOCK] & 0xFFFFF);
+}
+
+int main(int argc, char** argv) {
+  TimeSource hostTime;
+  int        totalSample = (2 == argc) ? bench_load(argv[1]) : bench_capture();
+  if (totalSample <= BMP280_COMPRESS_BLOCK) {
+    printf("no samples, %s\n", (2 == argc) ? "not a raw log" : "capture failed");
+    return 1;
+  }
+  host_time_source_monotonic(&hostTime);
+  printf("%d samples from %s, block of %d\n",
+         totalSample,
+         (2 == argc) ? argv[1] : "the simulator",
+         BMP280_COMPRESS_BLOCK);
+
+  bool isAllExact = true;
+  for (size_t intervalIndex = 0;
+       intervalIndex < sizeof(benchKeyInterval) / sizeof(benchKeyInterval[0]);
+       ++intervalIndex) {
+    uint16_t keyInterval = benchKeyInterval[intervalIndex];
+    uint32_t size        = bench_encode(totalSample, keyInterval);
+    bool     isExact     = bench_round_trip(size, totalSample);
+    isAllExact           = isAllExact && isExact;
+
+    int      totalRun = BENCH_TIMING_SAMPLE / totalSample + 1;
+    uint32_t startUs  = time_source_now_us(&hostTime);
+    for (int runIndex = 0; runIndex < totalRun; ++runIndex) {
+      bench_encode(totalSample, keyInterval);
+    }
+    uint32_t encodeUs = time_source_now_us(&hostTime) - startUs;
+    startUs           = time_source_now_us(&hostTime);
+    for (int runIndex = 0; runIndex < totalRun; ++runIndex) { bench_decode(size, totalSample); }
+    uint32_t decodeUs = time_source_now_us(&hostTime) - startUs;
+
+    double bytePerSample = (double)size / totalSample;
+    printf("keyframe every %2u blocks: %.2f bytes per sample, %.2fx against packed, "
+           "%.2fx against float, encode %.1f ns, decode %.1f ns per sample, %s\n",
+           keyInterval,
+           bytePerSample,
+           BENCH_PACKED_SAMPLE / bytePerSample,
+           BENCH_FLOAT_SAMPLE / bytePerSample,
+           1000.0 * encodeUs / ((double)totalRun * totalSample),
+           1000.0 * decodeUs / ((double)totalRun * totalSample),
+           isExact ? "lossless" : "MISMATCH");
+  }
+  bool isRejected = bench_truncated_keyframe(totalSample);
+  printf("truncated keyframe blocks: %s\n",
+         isRejected ? "rejected, decoder unchanged" : "MISMATCH");
+  return (isAllExact && isRejected) ? 0 : 2;
+}
@@ -0,0 +1,170 @@
+/**
+ * @brief 64 simulated sensors read from a pool of threads, samples per second against the thread
+ * count
+ *
+ * The sensors are in pairs on 32 I2C buses of host/sim/Sim_Bus.h, each bus with a pthread lock.
+ * Thread t owns the handles t, t + N, t + 2N ... and reads them round robin with
+ * bmp280_get_temp_press, so threads only meet on the bus locks. The run is repeated with instant
+ * transfers, where the host CPU is the limit, and with a 400 kHz bus, where the threads mostly
+ * sleep on the wire and the number of buses is the limit
+ *
+ * @file bench_concurrency.c
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
+
+#include "host/Host_BusLock.h"
+#include "host/Host_TimeSource.h"
+#include "host/sim/Sim_BMP280.h"
+#include "host/sim/Sim_Bus.h"
+#include "include/BMP280_Drv.h"
+#include "include/BMP280_Utils.h"
+
+#define BENCH_TOTAL_SENSOR 64
+#define BENCH_SENSOR_PER_BUS 2  // the two addresses a bmp280 can take
+#define BENCH_TOTAL_BUS (BENCH_TOTAL_SENSOR / BENCH_SENSOR_PER_BUS)
+#define BENCH_RUN_NS 300000000ULL
+#define BENCH_RAW_RESET 0x80000
+
+static const uint8_t  benchAddress[BENCH_SENSOR_PER_BUS] = {0x76, 0x77};
+static const uint32_t benchBitRateHz[]                   = {0, 400000};
+static const uint32_t benchTotalThread[]                 = {1, 2, 4, 8, 16, 32, 64};
+
+static SimBmp280       simSensor[BENCH_TOTAL_SENSOR];
+static SimBus          simBus[BENCH_TOTAL_BUS];
+static pthread_mutex_t busMutex[BENCH_TOTAL_BUS];
+static BusLock         busLock[BENCH_TOTAL_BUS];
+static bmp280          sensor[BENCH_TOTAL_SENSOR];
+static TimeSource      hostTime;
+
+typedef struct {
+  uint32_t  threadIndex;
+  uint32_t  totalThread;
+  uint64_t  endNs;
+  uint64_t  totalSample;
+  uint64_t  totalError;
+  uint64_t  totalWrong;
+  pthread_t thread;
+} BenchWorker;
+
+static Bmp280ErrCode bench_open(bmp280* handle, const SimBus* bus, const uint8_t address) {
+  BMP280_TRY_FUNC(bmp280_create_predefined_settings(handle, HandDynamic));
+  BMP280_TRY_FUNC(bmp280_init(handle, I2C, address));
+  BMP280_TRY_FUNC(bmp280_set_bus(handle, &bus->bus));
+  BMP280_TRY_FUNC(bmp280_set_time_source(handle, &hostTime));
+  BMP280_TRY_FUNC(bmp280_open(handle));
+  BMP280_TRY_FUNC(bmp280_reset(handle));
+  BMP280_TRY_FUNC(bmp280_update_setting(handle));
+  BMP280_TRY_FUNC(bmp280_get_calibration_data(handle, NULL));
+
+  // the data registers hold 0x80000 until the first conversion is done
+  int32_t rawTemp = BENCH_RAW_RESET;
+  int32_t rawPress;
+  while (BENCH_RAW_RESET == rawTemp) {
+    BMP280_TRY_FUNC(bmp280_get_raw_temp_press(handle, &rawTemp, &rawPress));
+  }
+  return ERR_NO_ERR;
+}
+
+static bool bench_setup(void) {
+  host_time_source_monotonic(&hostTime);
+  for (int busIndex = 0; busIndex < BENCH_TOTAL_BUS; ++busIndex) {
+    sim_bus_init(&simBus[busIndex], 0);
+    pthread_mutex_init(&busMutex[busIndex], NULL);
+    host_bus_lock_pthread(&busLock[busIndex], &busMutex[busIndex]);
+    simBus[busIndex].bus.lock = &busLock[busIndex];
+  }
+
+  for (int sensorIndex = 0; sensorIndex < BENCH_TOTAL_SENSOR; ++sensorIndex) {
+    SimBus* bus     = &simBus[sensorIndex / BENCH_SENSOR_PER_BUS];
+    uint8_t address = benchAddress[sensorIndex % BENCH_SENSOR_PER_BUS];
+    sim_bmp280_init(&simSensor[sensorIndex]);
+    simSensor[sensorIndex].nowNs = sim_bus_wall_ns;
+    sim_bmp280_power_on(&simSensor[sensorIndex]);
+    sim_bus_attach(bus, &simBmp280Ops, &simSensor[sensorIndex], address);
+    if (ERR_NO_ERR != bench_open(&sensor[sensorIndex], bus, address)) {
+      printf("sensor %d failed to open\n", sensorIndex);
+      return false;
+    }
+  }
+  return true;
+}
+
+static void* bench_worker(void* argument) {
+  BenchWorker* worker = argument;
+  while (sim_bus_wall_ns() < worker->endNs) {
+    for (uint32_t sensorIndex = worker->threadIndex; sensorIndex < BENCH_TOTAL_SENSOR;
+         sensorIndex += worker->totalThread) {
+      float temperature;
+      float pressure;
+      if (ERR_NO_ERR != bmp280_get_temp_press(&sensor[sensorIndex], &temperature, &pressure)) {
+        ++worker->totalError;
+      } else if (fabsf(temperature - 25.0f) > 0.1f || fabsf(pressure - 101325.0f) > 5.0f) {
+        // the default waveform is a constant 25 C and 101325 Pa
+        ++worker->totalWrong;
+      }
+      ++worker->totalSample;
+    }
+  }
+  return NULL;
+}
+
+static double bench_run(const uint32_t totalThread, uint64_t* totalError, uint64_t* totalWrong) {
+  BenchWorker worker[BENCH_TOTAL_SENSOR] = {{0}};
+  uint64_t    startNs                    = sim_bus_wall_ns();
+  for (uint32_t threadIndex = 0; threadIndex < totalThread; ++threadIndex) {
+    worker[threadIndex].threadIndex = threadIndex;
+    worker[threadIndex].totalThread = totalThread;
+    worker[threadIndex].endNs       = startNs + BENCH_RUN_NS;
+    pthread_create(&worker[threadIndex].thread, NULL, bench_worker, &worker[threadIndex]);
+  }
+
+  uint64_t totalSample = 0;
+  for (uint32_t threadIndex = 0; threadIndex < totalThread; ++threadIndex) {
+    pthread_join(worker[threadIndex].thread, NULL);
+    totalSample += worker[threadIndex].totalSample;
+    *totalError += worker[threadIndex].totalError;
+    *totalWrong += worker[threadIndex].totalWrong;
+  }
+  return totalSample * 1e9 / (double)(sim_bus_wall_ns() - startNs);
+}
+
+int main(void) {
+  if (!bench_setup()) { return 1; }
+  printf("%d sensors on %d buses\n", BENCH_TOTAL_SENSOR, BENCH_TOTAL_BUS);
+
+  uint64_t totalError = 0;
+  uint64_t totalWrong = 0;
+  for (size_t rateIndex = 0; rateIndex < sizeof(benchBitRateHz) / sizeof(benchBitRateHz[0]);
+       ++rateIndex) {
+    for (int busIndex = 0; busIndex < BENCH_TOTAL_BUS; ++busIndex) {
+      uint32_t bitRateHz     = benchBitRateHz[rateIndex];
+      simBus[busIndex].bitNs = bitRateHz ? 1000000000ULL / bitRateHz : 0;
+    }
+    if (0 == benchBitRateHz[rateIndex]) {
+      printf("instant transfers\n");
+    } else {
+      printf("%u kHz bus\n", benchBitRateHz[rateIndex] / 1000);
+    }
+
+    double singleRate = 0;
+    for (size_t threadIndex = 0;
+         threadIndex < sizeof(benchTotalThread) / sizeof(benchTotalThread[0]);
+         ++threadIndex) {
+      double rate = bench_run(benchTotalThread[threadIndex], &totalError, &totalWrong);
+      if (0 == threadIndex) { singleRate = rate; }
+      printf("  %2u threads: %9.0f samples/s, %5.2fx\n",
+             benchTotalThread[threadIndex],
+             rate,
+             rate / singleRate);
+    }
+  }
+  printf("errors %llu, wrong values %llu\n",
+         (unsigned long long)totalError,
+         (unsigned long long)totalWrong);
+  return (0 == totalError && 0 == totalWrong) ? 0 : 2;
+}
@@ -0,0 +1,114 @@
+/**
+ * @brief per-sample cost of the C API and of the C++ template in the host simulator
+ *
+ * Both read the same simulated bmp280 over I2C0, each sample a 6 byte burst of the pressure and
+ * temperature registers followed by the same integer compensation, so the difference is the
+ * overhead of the API. The drivers busy wait on the bus, so the register accesses per sample
+ * (SIM_REG_ACCESS_NS each) are the cpu time a sample costs on the TivaC, host time is the wall
+ * clock spent per sample on the PC. Code size is reported by the bench_footprint target
+ *
+ * @file bench_cpp.cpp
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#include <chrono>
+#include <cstdio>
+
+#include "include/BMP280.hpp"
+
+extern "C" {
+#include "host/sim/Sim_BMP280.h"
+#include "host/sim/Sim_TM4C.h"
+}
+
+#define BENCH_I2C_ADDR 0x77
+#define BENCH_TOTAL_SAMPLE 2000
+
+static SimBmp280 simSensor;
+
+static void bench_power_on(void) {
+  sim_tm4c_reset();
+  sim_bmp280_init(&simSensor);
+  sim_bmp280_attach_i2c(&simSensor, BENCH_I2C_ADDR);
+}
+
+/**
+ * @brief print the cost of one sample, start values are taken after the sensor is set up
+ *
+ */
+static void bench_report(const char*    name,
+                         const uint64_t startNs,
+                         const uint64_t startAccess,
+                         const double   hostNs,
+                         const float    pressure,
+                         const bool     isOk) {
+  double accessPerSample = (sim_reg_access_count() - startAccess) / double(BENCH_TOTAL_SAMPLE);
+  double virtualUs       = (sim_now_ns() - startNs) / 1000.0 / BENCH_TOTAL_SAMPLE;
+  std::printf("%-14s %12.1f %12.1f %12.0f %10.1f %s\n",
+              name,
+              accessPerSample,
+              virtualUs,
+              hostNs / BENCH_TOTAL_SAMPLE,
+              pressure,
+              isOk ? "ok" : "error");
+}
+
+static void bench_c_api(void) {
+  bmp280 sensor;
+  float  temperature = 0;
+  float  pressure    = 0;
+
+  bench_power_on();
+  Bmp280ErrCode errCode = bmp280_create_predefined_settings(&sensor, HandDynamic);
+  if (ERR_NO_ERR == errCode) { errCode = bmp280_init(&sensor, I2C, BENCH_I2C_ADDR); }
+  if (ERR_NO_ERR == errCode) { errCode = bmp280_open(&sensor); }
+  if (ERR_NO_ERR == errCode) { errCode = bmp280_reset(&sensor); }
+  if (ERR_NO_ERR == errCode) { errCode = bmp280_update_setting(&sensor); }
+  if (ERR_NO_ERR == errCode) { errCode = bmp280_get_calibration_data(&sensor, NULL); }
+
+  uint64_t startNs     = sim_now_ns();
+  uint64_t startAccess = sim_reg_access_count();
+  auto     hostStart   = std::chrono::steady_clock::now();
+  for (int sampleIndex = 0; ERR_NO_ERR == errCode && sampleIndex < BENCH_TOTAL_SAMPLE;
+       ++sampleIndex) {
+    errCode = bmp280_get_temp_press(&sensor, &temperature, &pressure);
+  }
+  std::chrono::duration<double, std::nano> hostNs = std::chrono::steady_clock::now() - hostStart;
+  bench_report("C API", startNs, startAccess, hostNs.count(), pressure, ERR_NO_ERR == errCode);
+}
+
+static void bench_cpp_template(void) {
+  Bmp280<Bmp280I2c<BENCH_I2C_ADDR>, Bmp280HandDynamic> sensor;
+  float                                                temperature = 0;
+  float                                                pressure    = 0;
+
+  bench_power_on();
+  Bmp280ErrCode errCode = sensor.open();
+  if (ERR_NO_ERR == errCode) { errCode = sensor.reset(); }
+  if (ERR_NO_ERR == errCode) { errCode = sensor.update_setting(); }
+  if (ERR_NO_ERR == errCode) { errCode = sensor.get_calibration_data(); }
+
+  uint64_t startNs     = sim_now_ns();
+  uint64_t startAccess = sim_reg_access_count();
+  auto     hostStart   = std::chrono::steady_clock::now();
+  for (int sampleIndex = 0; ERR_NO_ERR == errCode && sampleIndex < BENCH_TOTAL_SAMPLE;
+       ++sampleIndex) {
+    errCode = sensor.get_temp_press(&temperature, &pressure);
+  }
+  std::chrono::duration<double, std::nano> hostNs = std::chrono::steady_clock::now() - hostStart;
+  bench_report(
+      "C++ template", startNs, startAccess, hostNs.count(), pressure, ERR_NO_ERR == errCode);
+}
+
+int main(void) {
+  std::printf("%-14s %12s %12s %12s %10s\n",
+              "api",
+              "reg_access",
+              "sample_us",
+              "host_ns",
+              "press_Pa");
+  bench_c_api();
+  bench_cpp_template();
+  return 0;
+}
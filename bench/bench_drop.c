@@ -0,0 +1,251 @@
+/**
+ * @brief detection latency of BMP280_Drop on the simulated bmp280 with the DropDetec preset
+ *
+ * Every scenario waits 1 s at rest then moves, the pressure gets the RMS noise of the datasheet
+ * for x2 pressure oversampling. The samples are read through the driver once per normal mode
+ * cycle and fed to the detector the way the acquisition interrupt would. Reported per scenario
+ * are the drops detected, how many before the impact and the latency of the callback after the
+ * release and after the true speed crossed the threshold, which must stay within the bound of
+ * BMP280_Drop.h plus the sample being read. The scenarios that don't fall, down to an elevator
+ * going down at 1 m/s, must never fire
+ *
+ * @file bench_drop.c
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#include <math.h>
+#include <stdio.h>
+
+#include "host/Host_Random.h"
+#include "host/Host_TimeSource.h"
+#include "host/sim/Sim_BMP280.h"
+#include "host/sim/Sim_TM4C.h"
+#include "include/BMP280_Drop.h"
+#include "include/BMP280_Drv.h"
+#include "include/BMP280_Utils.h"
+
+#define BENCH_I2C_ADDR 0x76
+#define BENCH_GRAVITY_MM_S2 9807
+#define BENCH_REST_NS 1000000000ULL
+#define BENCH_TRIAL_NS 3000000000ULL
+#define BENCH_NOISE_PA (2.62 / sqrt(2.0))  // RMS noise of the datasheet at x2 oversampling
+#define BENCH_TOTAL_TRIAL 50
+#define BENCH_TOTAL_ROUND 200000
+
+typedef struct {
+  const char* name;
+  uint32_t    heightMm;  //!< height of the fall
+  uint32_t    speedMmS;  //!< constant descent speed when not falling, 0 for a free fall
+  bool        isDrop;
+} BenchScenario;
+
+static const BenchScenario benchScenario[] = {{"drop 1.5 m", 1500, 0, true},
+                                              {"drop 1.0 m", 1000, 0, true},
+                                              {"drop 0.8 m", 800, 0, true},
+                                              {"put down 1 m/s", 500, 1000, false},
+                                              {"elevator 1 m/s", 3000, 1000, false},
+                                              {"at rest", 0, 0, false}};
+
+static const Bmp280DropConfig benchConfig = {.periodUs  = 0,
+                                             .ambientQ8 = 101325 * 256,
+                                             .enterMmS  = 2500,
+                                             .exitMmS   = 1000,
+                                             .span      = 16,
+                                             .confirm   = 2};
+
+typedef struct {
+  const BenchScenario* scenario;
+  uint64_t             startNs;  //!< start of the trial
+  uint64_t             startFallNs;
+  uint64_t             firedNs;  //!< first callback of the trial, 0 if none
+  uint32_t             totalFired;
+} BenchTrial;
+
+static SimBmp280  simSensor;
+static uint32_t   benchState = 1;
+static BenchTrial benchTrial;
+
+// seconds the scenario takes to reach the ground
+static double bench_fall_s(const BenchScenario* scenario) {
+  if (scenario->speedMmS) { return (double)scenario->heightMm / scenario->speedMmS; }
+  return sqrt(2.0 * scenario->heightMm / BENCH_GRAVITY_MM_S2);
+}
+
+// height above the ground timeS after the start of the fall
+static double bench_height_mm(const BenchScenario* scenario, const double timeS) {
+  if (timeS <= 0) { return scenario->heightMm; }
+  if (timeS >= bench_fall_s(scenario)) { return 0; }
+  if (scenario->speedMmS) { return scenario->heightMm - scenario->speedMmS * timeS; }
+  return scenario->heightMm - 0.5 * BENCH_GRAVITY_MM_S2 * timeS * timeS;
+}
+
+static double bench_temperature(void* context, const uint64_t timeNs) {
+  (void)context;
+  (void)timeNs;
+  return 22.0;
+}
+
+static double bench_pressure(void* context, const uint64_t timeNs) {
+  const BenchTrial* trial  = context;
+  double            timeS  = ((double)timeNs - (double)trial->startFallNs) * 1e-9;
+  double            height = bench_height_mm(trial->scenario, timeS);
+  double            noise  = BENCH_NOISE_PA * host_random_gaussian(&benchState);
+  return 101325.0 * pow(1.0 - height / 44330000.0, 1.0 / 0.1903) + noise;
+}
+
+static void bench_on_drop(void* context, const bool isFalling) {
+  BenchTrial* trial = context;
+  if (!isFalling) { return; }
+  if (0 == trial->totalFired) { trial->firedNs = sim_now_ns(); }
+  ++trial->totalFired;
+}
+
+/**
+ * @brief one trial of the scenario, sampled once per normal mode cycle until BENCH_TRIAL_NS
+ *
+ */
+static Bmp280ErrCode bench_trial(bmp280*              sensor,
+                                 Bmp280Drop*          drop,
+                                 const BenchScenario* scenario,
+                                 const uint32_t       periodUs) {
+  benchTrial.scenario    = scenario;
+  benchTrial.startNs     = sim_now_ns();
+  benchTrial.startFallNs = benchTrial.startNs + BENCH_REST_NS;
+  benchTrial.firedNs     = 0;
+  benchTrial.totalFired  = 0;
+  bmp280_drop_reset(drop);
+
+  Bmp280ErrCode errCode = ERR_NO_ERR;
+  while (ERR_NO_ERR == errCode && sim_now_ns() - benchTrial.startNs < BENCH_TRIAL_NS) {
+    uint64_t periodStartNs = sim_now_ns();
+    int32_t  temperature;
+    uint32_t pressQ8;
+    errCode = bmp280_get_temp_press_fixed(sensor, &temperature, &pressQ8);
+    if (ERR_NO_ERR == errCode) { bmp280_drop_add(drop, pressQ8); }
+    sim_advance_ns((uint64_t)periodUs * 1000 - (sim_now_ns() - periodStartNs));
+  }
+  return errCode;
+}
+
+/**
+ * @brief the time the true speed reaches enterMmS, the fall never reaches it if it is negative
+ *
+ */
+static double bench_cross_s(const BenchScenario* scenario) {
+  double crossS = (double)benchConfig.enterMmS / BENCH_GRAVITY_MM_S2;
+  return (crossS < bench_fall_s(scenario)) ? crossS : -1;
+}
+
+static bool bench_run(bmp280* sensor, const BenchScenario* scenario, const uint32_t periodUs) {
+  Bmp280Drop drop;
+  bool       isPass     = true;
+  int        totalHit   = 0;
+  int        totalEarly = 0;
+  int        totalFalse = 0;
+  double     sumMs      = 0;
+  double     maxMs      = 0;
+  double     maxCrossMs = 0;
+
+  Bmp280DropConfig config = benchConfig;
+  config.periodUs         = periodUs;
+  bmp280_drop_init(&drop, &config, bench_on_drop, &benchTrial);
+
+  double crossS = bench_cross_s(scenario);
+  double boundMs =
+      (2.0 * config.span + config.confirm) * periodUs * 1e-3;  // one more sample to be read
+  for (int trialIndex = 0; trialIndex < BENCH_TOTAL_TRIAL; ++trialIndex) {
+    if (ERR_NO_ERR != bench_trial(sensor, &drop, scenario, periodUs)) { return false; }
+    if (0 == benchTrial.totalFired) { continue; }
+    if (!scenario->isDrop || benchTrial.firedNs < benchTrial.startFallNs) {
+      totalFalse += benchTrial.totalFired;
+      continue;
+    }
+
+    double latencyMs = (benchTrial.firedNs - benchTrial.startFallNs) * 1e-6;
+    ++totalHit;
+    sumMs += latencyMs;
+    if (latencyMs > maxMs) { maxMs = latencyMs; }
+    if (latencyMs < bench_fall_s(scenario) * 1e3) { ++totalEarly; }
+    if (crossS >= 0 && latencyMs - crossS * 1e3 > maxCrossMs) {
+      maxCrossMs = latencyMs - crossS * 1e3;
+    }
+  }
+
+  printf("  %-15s fall %4.0f ms", scenario->name, bench_fall_s(scenario) * 1e3);
+  if (scenario->isDrop) {
+    printf(", detected %2d/%d, before impact %2d, after release mean %4.0f max %4.0f ms, "
+           "after crossing max %4.0f ms",
+           totalHit,
+           BENCH_TOTAL_TRIAL,
+           totalEarly,
+           totalHit ? sumMs / totalHit : 0,
+           maxMs,
+           maxCrossMs);
+    // a fall too short to reach enterMmS can go unnoticed, the noise may hide one in ten of the
+    // others, the rest must be within the bound
+    if (crossS >= 0 && (totalHit * 10 < BENCH_TOTAL_TRIAL * 9 || maxCrossMs > boundMs)) {
+      isPass = false;
+    }
+  }
+  printf(", false alarms %d\n", totalFalse);
+  return isPass && 0 == totalFalse;
+}
+
+// host time of a sample on the same stream, the ring is full so every call does the whole work
+static double bench_time_ns(const uint32_t periodUs) {
+  Bmp280Drop       drop;
+  Bmp280DropConfig config = benchConfig;
+  config.periodUs         = periodUs;
+  bmp280_drop_init(&drop, &config, NULL, NULL);
+
+  volatile bool isFalling = false;
+  uint64_t      startNs   = host_time_now_ns();
+  for (uint32_t round = 0; round < BENCH_TOTAL_ROUND; ++round) {
+    isFalling = bmp280_drop_add(&drop, 101325 * 256 + (round & 0xFF));
+  }
+  (void)isFalling;
+  return (double)(host_time_now_ns() - startNs) / BENCH_TOTAL_ROUND;
+}
+
+int main(void) {
+  bmp280 sensor;
+
+  sim_tm4c_reset();
+  sim_bmp280_init(&simSensor);
+  simSensor.waveform.temperatureC = bench_temperature;
+  simSensor.waveform.pressurePa   = bench_pressure;
+  simSensor.waveform.context      = &benchTrial;
+  benchTrial.scenario             = &benchScenario[0];  // held before the fall until the trials
+  benchTrial.startFallNs          = UINT64_MAX;
+  sim_bmp280_attach_i2c(&simSensor, BENCH_I2C_ADDR);
+
+  Bmp280ErrCode errCode = bmp280_create_predefined_settings(&sensor, DropDetec);
+  if (ERR_NO_ERR == errCode) { errCode = bmp280_init(&sensor, I2C, BENCH_I2C_ADDR); }
+  if (ERR_NO_ERR == errCode) { errCode = bmp280_open(&sensor); }
+  if (ERR_NO_ERR == errCode) { errCode = bmp280_reset(&sensor); }
+  if (ERR_NO_ERR == errCode) { errCode = bmp280_update_setting(&sensor); }
+  if (ERR_NO_ERR != errCode) {
+    printf("sensor setup failed: %d\n", errCode);
+    return 1;
+  }
+  uint32_t periodUs = bmp280_measure_time_us(&sensor) + bmp280_standby_time_us(&sensor);
+  sim_advance_ns((uint64_t)periodUs * 1000);
+
+  printf("DropDetec, %.1f Hz, span %u, confirm %u, enter %u mm/s, exit %u mm/s, %zu bytes, "
+         "%.1f ns per sample\n",
+         1e6 / periodUs,
+         benchConfig.span,
+         benchConfig.confirm,
+         benchConfig.enterMmS,
+         benchConfig.exitMmS,
+         sizeof(Bmp280Drop),
+         bench_time_ns(periodUs));
+  bool isPass = true;
+  for (size_t scenarioIndex = 0; scenarioIndex < sizeof(benchScenario) / sizeof(benchScenario[0]);
+       ++scenarioIndex) {
+    isPass = bench_run(&sensor, &benchScenario[scenarioIndex], periodUs) && isPass;
+  }
+  printf("%s\n", isPass ? "pass" : "FAIL");
+  return isPass ? 0 : 1;
+}
@@ -0,0 +1,212 @@
+/**
+ * @brief time to fail or recover of bmp280_reset, bmp280_get_calibration_data and
+ * bmp280_get_temp_press under the faults the simulator can inject
+ *
+ * Every fault is swept over the bus operations of the call: for each start offset the sensor is
+ * brought up from scratch, the fault is injected and the call is timed on the virtual clock. The
+ * worst time over the sweep is the number to budget the watchdog with. ok counts calls that
+ * returned correct values, fail calls that returned an error and wrong calls that returned
+ * ERR_NO_ERR with values that differ from a fault free read. bmp280_open only sets up the
+ * peripheral, the calibration read is the first burst of a cold start
+ *
+ * @file bench_faults.c
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "host/sim/Sim_BMP280.h"
+#include "host/sim/Sim_TM4C.h"
+#include "include/BMP280_Drv.h"
+#include "include/BMP280_Utils.h"
+
+#define BENCH_I2C_ADDR 0x77
+#define BENCH_MAX_AFTER_OP 40  // start offsets swept, more than the operations of any call
+#define BENCH_SETTLE_NS 20000000
+
+typedef enum { BenchReset, BenchCalib, BenchRead } BenchCall;
+
+typedef enum { BenchNoFault, BenchBusFault, BenchNvmDelay } BenchFaultKind;
+
+/**
+ * @brief one line of the fault script, fault is used by BenchBusFault and nvmCopyNs by
+ * BenchNvmDelay
+ */
+typedef struct {
+  const char*       name;
+  Bmp280ComProtocol protocol;
+  BenchFaultKind    kind;
+  SimFault          fault;
+  uint64_t          nvmCopyNs;
+} BenchScenario;
+
+typedef struct {
+  uint32_t ok;
+  uint32_t fail;
+  uint32_t wrong;
+  double   worstUs;
+} BenchResult;
+
+static SimBmp280        simSensor;
+static float            refTemperature;
+static float            refPressure;
+static Bmp280CalibParam refCalib;
+
+// a totalOp of 0 never clears the fault, 1 s of busy outlasts any call
+// clang-format off
+static const BenchScenario benchScenarios[] = {
+  {"none",                I2C, BenchNoFault,  {0}, 0},
+  {"addr nack x1",        I2C, BenchBusFault, {SIM_FAULT_I2C_ADDR_NACK, 0, 1, 0}, 0},
+  {"addr nack forever",   I2C, BenchBusFault, {SIM_FAULT_I2C_ADDR_NACK, 0, 0, 0}, 0},
+  {"data nack x1",        I2C, BenchBusFault, {SIM_FAULT_I2C_DATA_NACK, 0, 1, 0}, 0},
+  {"arbitration lost x1", I2C, BenchBusFault, {SIM_FAULT_I2C_ARB_LOST, 0, 1, 0}, 0},
+  {"arbitration lost x4", I2C, BenchBusFault, {SIM_FAULT_I2C_ARB_LOST, 0, 4, 0}, 0},
+  {"busy 200 us x1",      I2C, BenchBusFault, {SIM_FAULT_I2C_STUCK_BUSY, 0, 1, 200}, 0},
+  {"busy forever",        I2C, BenchBusFault, {SIM_FAULT_I2C_STUCK_BUSY, 0, 0, 1000000}, 0},
+  {"sda low 9 pulses",    I2C, BenchBusFault, {SIM_FAULT_I2C_SDA_LOW, 0, 1, 9}, 0},
+  {"sda low 255 pulses",  I2C, BenchBusFault, {SIM_FAULT_I2C_SDA_LOW, 0, 1, 255}, 0},
+  {"corrupt byte x1",     I2C, BenchBusFault, {SIM_FAULT_I2C_CORRUPT, 0, 1, 0x10}, 0},
+  {"nvm copy 4 ms",       I2C, BenchNvmDelay, {0}, 4000000},
+  {"nvm copy 8 ms",       I2C, BenchNvmDelay, {0}, 8000000},
+  {"none",                SPI, BenchNoFault,  {0}, 0},
+  {"busy 200 us x1",      SPI, BenchBusFault, {SIM_FAULT_SSI_STUCK_BUSY, 0, 1, 200}, 0},
+  {"busy forever",        SPI, BenchBusFault, {SIM_FAULT_SSI_STUCK_BUSY, 0, 0, 1000000}, 0},
+  {"corrupt byte x1",     SPI, BenchBusFault, {SIM_FAULT_SSI_CORRUPT, 0, 1, 0x10}, 0},
+  {"nvm copy 8 ms",       SPI, BenchNvmDelay, {0}, 8000000},
+};
+// clang-format on
+
+static const char* benchCallName[] = {
+    "bmp280_reset", "bmp280_get_calibration_data", "bmp280_get_temp_press"};
+
+/**
+ * @brief bring a sensor up to just before call, without faults
+ *
+ */
+static Bmp280ErrCode bench_prepare(bmp280*                 sensor,
+                                   const Bmp280ComProtocol protocol,
+                                   const BenchCall         call) {
+  sim_tm4c_reset();
+  sim_bmp280_init(&simSensor);
+  if (I2C == protocol) {
+    sim_bmp280_attach_i2c(&simSensor, BENCH_I2C_ADDR);
+  } else {
+    sim_bmp280_attach_spi(&simSensor);
+  }
+
+  BMP280_TRY_FUNC(bmp280_create_predefined_settings(sensor, HandDynamic));
+  BMP280_TRY_FUNC(bmp280_init(sensor, protocol, BENCH_I2C_ADDR));
+  BMP280_TRY_FUNC(bmp280_open(sensor));
+  if (BenchReset == call) { return ERR_NO_ERR; }
+  BMP280_TRY_FUNC(bmp280_reset(sensor));
+  BMP280_TRY_FUNC(bmp280_update_setting(sensor));
+  if (BenchCalib == call) { return ERR_NO_ERR; }
+  BMP280_TRY_FUNC(bmp280_get_calibration_data(sensor, NULL));
+  sim_advance_ns(BENCH_SETTLE_NS);
+  return ERR_NO_ERR;
+}
+
+static Bmp280ErrCode bench_call(bmp280*           sensor,
+                                const BenchCall   call,
+                                Bmp280CalibParam* calib,
+                                float*            temperature,
+                                float*            pressure) {
+  switch (call) {
+    case BenchReset:
+      return bmp280_reset(sensor);
+    case BenchCalib:
+      return bmp280_get_calibration_data(sensor, calib);
+    default:
+      return bmp280_get_temp_press(sensor, temperature, pressure);
+  }
+}
+
+/**
+ * @brief compare the coefficients only, t_fine is not part of the calibration read
+ */
+static bool bench_calib_equal(Bmp280CalibParam calib, Bmp280CalibParam ref) {
+  calib.t_fine = 0;
+  ref.t_fine   = 0;
+  return 0 == memcmp(&calib, &ref, sizeof(calib));
+}
+
+/**
+ * @brief sweep the start of the fault over the operations of call
+ *
+ */
+static BenchResult bench_sweep(const BenchScenario* scenario, const BenchCall call) {
+  BenchResult result = {0, 0, 0, 0};
+  for (uint32_t afterOp = 0; afterOp < BENCH_MAX_AFTER_OP; ++afterOp) {
+    bmp280           sensor;
+    Bmp280CalibParam calib       = {0};
+    float            temperature = 0;
+    float            pressure    = 0;
+    if (ERR_NO_ERR != bench_prepare(&sensor, scenario->protocol, call)) {
+      ++result.fail;
+      continue;
+    }
+
+    if (BenchBusFault == scenario->kind) {
+      SimFault fault = scenario->fault;
+      fault.afterOp  = afterOp;
+      sim_fault_inject(&fault);
+    } else if (BenchNvmDelay == scenario->kind) {
+      simSensor.nvmCopyNs = scenario->nvmCopyNs;
+    }
+
+    uint64_t      startNs = sim_now_ns();
+    Bmp280ErrCode errCode = bench_call(&sensor, call, &calib, &temperature, &pressure);
+    double        callUs  = (double)(sim_now_ns() - startNs) / 1000;
+    if (callUs > result.worstUs) { result.worstUs = callUs; }
+
+    if (ERR_NO_ERR != errCode) {
+      ++result.fail;
+    } else if (BenchRead == call && (fabsf(temperature - refTemperature) > 0.005f ||
+                                     fabsf(pressure - refPressure) > 0.05f)) {
+      ++result.wrong;
+    } else if (BenchCalib == call && !bench_calib_equal(calib, refCalib)) {
+      ++result.wrong;
+    } else {
+      ++result.ok;
+    }
+  }
+  return result;
+}
+
+int main(void) {
+  bmp280 sensor;
+  if (ERR_NO_ERR != bench_prepare(&sensor, I2C, BenchRead) ||
+      ERR_NO_ERR != bmp280_get_calibration_data(&sensor, &refCalib) ||
+      ERR_NO_ERR != bmp280_get_temp_press(&sensor, &refTemperature, &refPressure)) {
+    printf("fault free read failed\n");
+    return 1;
+  }
+
+  printf("%-20s %-4s %-28s %4s %5s %6s %10s\n",
+         "fault",
+         "bus",
+         "call",
+         "ok",
+         "fail",
+         "wrong",
+         "worst_us");
+  for (size_t scenarioIndex = 0;
+       scenarioIndex < sizeof(benchScenarios) / sizeof(benchScenarios[0]); ++scenarioIndex) {
+    const BenchScenario* scenario = &benchScenarios[scenarioIndex];
+    for (int call = BenchReset; call <= BenchRead; ++call) {
+      BenchResult result = bench_sweep(scenario, (BenchCall)call);
+      printf("%-20s %-4s %-28s %4u %5u %6u %10.1f\n",
+             scenario->name,
+             (I2C == scenario->protocol) ? "i2c" : "spi",
+             benchCallName[call],
+             result.ok,
+             result.fail,
+             result.wrong,
+             result.worstUs);
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,286 @@
+/**
+ * @brief accuracy and throughput of every compensation path against the double precision formula
+ * of the Bosch datasheet, over a generated corpus of calibrations and raw values
+ *
+ * The corpus is the datasheet example calibration and BENCH_TOTAL_CALIB - 1 others spread around
+ * it by more than parts vary, each with raw values for -40 to 85 C and 300 to 1100 hPa plus a few
+ * counts of jitter. The paths are:
+ *
+ *   ware.int     bmp280_compensate_T_int32 / 100 and bmp280_compensate_P_int64 / 256 in double
+ *   drv.float    the float conversion of bmp280_get_temp_press, what users see
+ *   multi.lanes  bmp280_multi_compensate with one lane per calibration
+ *
+ * Each is checked against BENCH_MAX_TEMP_ERR_C and BENCH_MAX_PRESS_ERR_PA, the errors of the
+ * integer formulas measured when this harness was added, and the program exits with 2 if one is
+ * exceeded. bench_golden corpus.csv also writes the corpus with the reference results, C++
+ * front end reads go through the same two functions as drv.float
+ *
+ * @file bench_golden.c
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#include <math.h>
+#include <stdio.h>
+
+#include "host/Host_Random.h"
+#include "host/Host_TimeSource.h"
+#include "host/sim/Sim_BMP280.h"
+#include "include/BMP280_Multi.h"
+#include "include/BMP280_Ware.h"
+
+#define BENCH_TOTAL_CALIB 64
+#define BENCH_TOTAL_TEMP 26   // -40 to 85 C every 5 C
+#define BENCH_TOTAL_PRESS 41  // 300 to 1100 hPa every 20 hPa
+#define BENCH_RAW_JITTER 16   // counts added to each raw value, so the grid isn't too regular
+#define BENCH_TOTAL_POINT (BENCH_TOTAL_TEMP * BENCH_TOTAL_PRESS)
+#define BENCH_TOTAL_VECTOR (BENCH_TOTAL_CALIB * BENCH_TOTAL_POINT)
+#define BENCH_RUN_NS 100000000ULL
+#define BENCH_MAX_TEMP_ERR_C 0.008  // 0.0075 C measured, half the 0.01 C step plus t_fine
+#define BENCH_MAX_PRESS_ERR_PA 0.5  // 0.48 Pa measured
+
+typedef struct {
+  const char* name;
+  // temperature and pressure of every vector, in corpus order
+  void (*run)(float* temperatureC, float* pressurePa);
+  bool isDouble;  //!< ware.int results are exact integers scaled in double, not floats
+} BenchPath;
+
+typedef struct {
+  double maxTempErr;
+  double sumTempErr;
+  double maxPressErr;
+  double sumPressErr;
+} BenchError;
+
+static Bmp280CalibParam calibParam[BENCH_TOTAL_CALIB];
+static int32_t          rawTemp[BENCH_TOTAL_CALIB][BENCH_TOTAL_POINT];
+static int32_t          rawPress[BENCH_TOTAL_CALIB][BENCH_TOTAL_POINT];
+static double           refTemp[BENCH_TOTAL_CALIB][BENCH_TOTAL_POINT];
+static double           refPress[BENCH_TOTAL_CALIB][BENCH_TOTAL_POINT];
+static double           intTemp[BENCH_TOTAL_VECTOR];
+static double           intPress[BENCH_TOTAL_VECTOR];
+static float            outTemp[BENCH_TOTAL_VECTOR];
+static float            outPress[BENCH_TOTAL_VECTOR];
+static Bmp280MultiCalib multiCalib;
+
+/**
+ * @brief the double precision compensation of the datasheet, section 8.1
+ *
+ */
+static void bench_reference(const Bmp280CalibParam* calib,
+                            const int32_t           adcT,
+                            const int32_t           adcP,
+                            double*                 temperatureC,
+                            double*                 pressurePa) {
+  double var1  = ((double)adcT / 16384.0 - (double)calib->dig_t1 / 1024.0) * (double)calib->dig_t2;
+  double var2  = ((double)adcT / 131072.0 - (double)calib->dig_t1 / 8192.0) *
+                ((double)adcT / 131072.0 - (double)calib->dig_t1 / 8192.0) * (double)calib->dig_t3;
+  double tFine = var1 + var2;
+
+  *temperatureC = tFine / 5120.0;
+  var1          = tFine / 2.0 - 64000.0;
+  var2          = var1 * var1 * (double)calib->dig_p6 / 32768.0;
+  var2          = var2 + var1 * (double)calib->dig_p5 * 2.0;
+  var2          = var2 / 4.0 + (double)calib->dig_p4 * 65536.0;
+
+  var1 = ((double)calib->dig_p3 * var1 * var1 / 524288.0 + (double)calib->dig_p2 * var1) / 524288.0;
+  var1 = (1.0 + var1 / 32768.0) * (double)calib->dig_p1;
+  if (0.0 == var1) {
+    *pressurePa = 0;
+    return;
+  }
+
+  double p    = 1048576.0 - (double)adcP;
+  p           = (p - var2 / 4096.0) * 6250.0 / var1;
+  var1        = (double)calib->dig_p9 * p * p / 2147483648.0;
+  var2        = p * (double)calib->dig_p8 / 32768.0;
+  *pressurePa = p + (var1 + var2 + (double)calib->dig_p7) / 16.0;
+}
+
+static void bench_setup(void) {
+  SimBmp280 reference;
+  uint32_t  state = 7;
+  sim_bmp280_init(&reference);
+  bmp280_multi_init(&multiCalib);
+
+  for (int calibIndex = 0; calibIndex < BENCH_TOTAL_CALIB; ++calibIndex) {
+    Bmp280CalibParam* calib = &calibParam[calibIndex];
+    *calib                  = reference.calibParam;
+    if (calibIndex > 0) {
+      calib->dig_t1 += host_random_spread(&state, 1500);
+      calib->dig_t2 += host_random_spread(&state, 1000);
+      calib->dig_t3 += host_random_spread(&state, 1000);
+      calib->dig_p1 += host_random_spread(&state, 2000);
+      calib->dig_p2 += host_random_spread(&state, 300);
+      calib->dig_p3 += host_random_spread(&state, 200);
+      calib->dig_p4 += host_random_spread(&state, 2500);
+      calib->dig_p5 += host_random_spread(&state, 200);
+      calib->dig_p6 += host_random_spread(&state, 10);
+      calib->dig_p7 += host_random_spread(&state, 500);
+      calib->dig_p8 += host_random_spread(&state, 500);
+      calib->dig_p9 += host_random_spread(&state, 500);
+    }
+    bmp280_multi_add(&multiCalib, calib, NULL);
+
+    for (int tempIndex = 0; tempIndex < BENCH_TOTAL_TEMP; ++tempIndex) {
+      for (int pressIndex = 0; pressIndex < BENCH_TOTAL_PRESS; ++pressIndex) {
+        int     point = tempIndex * BENCH_TOTAL_PRESS + pressIndex;
+        int32_t adcT  = sim_bmp280_raw_temp(calib, -40.0 + 5.0 * tempIndex);
+        int32_t adcP  = sim_bmp280_raw_press(calib, adcT, 30000.0 + 2000.0 * pressIndex);
+        rawTemp[calibIndex][point]  = adcT + host_random_spread(&state, BENCH_RAW_JITTER);
+        rawPress[calibIndex][point] = adcP + host_random_spread(&state, BENCH_RAW_JITTER);
+        bench_reference(calib,
+                        rawTemp[calibIndex][point],
+                        rawPress[calibIndex][point],
+                        &refTemp[calibIndex][point],
+                        &refPress[calibIndex][point]);
+      }
+    }
+  }
+}
+
+static void bench_ware_int(float* temperatureC, float* pressurePa) {
+  (void)temperatureC;
+  (void)pressurePa;
+  for (int calibIndex = 0; calibIndex < BENCH_TOTAL_CALIB; ++calibIndex) {
+    Bmp280CalibParam* calib = &calibParam[calibIndex];
+    for (int point = 0; point < BENCH_TOTAL_POINT; ++point) {
+      int vector       = calibIndex * BENCH_TOTAL_POINT + point;
+      intTemp[vector]  = bmp280_compensate_T_int32(rawTemp[calibIndex][point], calib) / 100.0;
+      intPress[vector] = bmp280_compensate_P_int64(rawPress[calibIndex][point], calib) / 256.0;
+    }
+  }
+}
+
+static void bench_drv_float(float* temperatureC, float* pressurePa) {
+  for (int calibIndex = 0; calibIndex < BENCH_TOTAL_CALIB; ++calibIndex) {
+    Bmp280CalibParam* calib = &calibParam[calibIndex];
+    for (int point = 0; point < BENCH_TOTAL_POINT; ++point) {
+      int vector = calibIndex * BENCH_TOTAL_POINT + point;
+      temperatureC[vector] =
+          (float)bmp280_compensate_T_int32(rawTemp[calibIndex][point], calib) * 0.01;
+      pressurePa[vector] =
+          (float)bmp280_compensate_P_int64(rawPress[calibIndex][point], calib) / 256.0;
+    }
+  }
+}
+
+/**
+ * @brief every lane is one calibration, so a call compensates one grid point of all of them
+ *
+ */
+static void bench_multi_lanes(float* temperatureC, float* pressurePa) {
+  int32_t laneTemp[BENCH_TOTAL_CALIB];
+  int32_t lanePress[BENCH_TOTAL_CALIB];
+  float   laneTempOut[BENCH_TOTAL_CALIB];
+  float   lanePressOut[BENCH_TOTAL_CALIB];
+  for (int point = 0; point < BENCH_TOTAL_POINT; ++point) {
+    for (int calibIndex = 0; calibIndex < BENCH_TOTAL_CALIB; ++calibIndex) {
+      laneTemp[calibIndex]  = rawTemp[calibIndex][point];
+      lanePress[calibIndex] = rawPress[calibIndex][point];
+    }
+    bmp280_multi_compensate(&multiCalib, laneTemp, lanePress, laneTempOut, lanePressOut);
+    for (int calibIndex = 0; calibIndex < BENCH_TOTAL_CALIB; ++calibIndex) {
+      temperatureC[calibIndex * BENCH_TOTAL_POINT + point] = laneTempOut[calibIndex];
+      pressurePa[calibIndex * BENCH_TOTAL_POINT + point]   = lanePressOut[calibIndex];
+    }
+  }
+}
+
+static const BenchPath benchPath[] = {{"ware.int", bench_ware_int, true},
+                                      {"drv.float", bench_drv_float, false},
+                                      {"multi.lanes", bench_multi_lanes, false}};
+
+static void bench_error(const BenchPath* path, BenchError* error) {
+  error->maxTempErr  = 0;
+  error->sumTempErr  = 0;
+  error->maxPressErr = 0;
+  error->sumPressErr = 0;
+  for (int calibIndex = 0; calibIndex < BENCH_TOTAL_CALIB; ++calibIndex) {
+    for (int point = 0; point < BENCH_TOTAL_POINT; ++point) {
+      int    vector      = calibIndex * BENCH_TOTAL_POINT + point;
+      double temperature = path->isDouble ? intTemp[vector] : outTemp[vector];
+      double pressure    = path->isDouble ? intPress[vector] : outPress[vector];
+      double tempErr     = fabs(temperature - refTemp[calibIndex][point]);
+      double pressErr    = fabs(pressure - refPress[calibIndex][point]);
+      error->sumTempErr += tempErr;
+      error->sumPressErr += pressErr;
+      if (tempErr > error->maxTempErr) { error->maxTempErr = tempErr; }
+      if (pressErr > error->maxPressErr) { error->maxPressErr = pressErr; }
+    }
+  }
+}
+
+static bool bench_write_corpus(const char* path) {
+  FILE* file = fopen(path, "w");
+  if (NULL == file) { return false; }
+  fprintf(file,
+          "dig_t1,dig_t2,dig_t3,dig_p1,dig_p2,dig_p3,dig_p4,dig_p5,dig_p6,dig_p7,dig_p8,dig_p9,"
+          "adc_t,adc_p,temperature_c,pressure_pa\n");
+  for (int calibIndex = 0; calibIndex < BENCH_TOTAL_CALIB; ++calibIndex) {
+    const Bmp280CalibParam* calib = &calibParam[calibIndex];
+    for (int point = 0; point < BENCH_TOTAL_POINT; ++point) {
+      fprintf(file,
+              "%u,%d,%d,%u,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%.9f,%.6f\n",
+              calib->dig_t1,
+              calib->dig_t2,
+              calib->dig_t3,
+              calib->dig_p1,
+              calib->dig_p2,
+              calib->dig_p3,
+              calib->dig_p4,
+              calib->dig_p5,
+              calib->dig_p6,
+              calib->dig_p7,
+              calib->dig_p8,
+              calib->dig_p9,
+              rawTemp[calibIndex][point],
+              rawPress[calibIndex][point],
+              refTemp[calibIndex][point],
+              refPress[calibIndex][point]);
+    }
+  }
+  return 0 == fclose(file);
+}
+
+int main(int argc, char** argv) {
+  bench_setup();
+  if (2 == argc && !bench_write_corpus(argv[1])) {
+    perror(argv[1]);
+    return 1;
+  }
+  printf("%d calibrations x %d raw pairs, errors against the double precision formula\n",
+         BENCH_TOTAL_CALIB,
+         BENCH_TOTAL_POINT);
+
+  bool isAllOk = true;
+  for (size_t pathIndex = 0; pathIndex < sizeof(benchPath) / sizeof(benchPath[0]); ++pathIndex) {
+    const BenchPath* path = &benchPath[pathIndex];
+    BenchError       error;
+    path->run(outTemp, outPress);
+    bench_error(path, &error);
+
+    int      totalRound = 0;
+    uint64_t startNs    = host_time_now_ns();
+    uint64_t elapsedNs  = 0;
+    while (elapsedNs < BENCH_RUN_NS) {
+      path->run(outTemp, outPress);
+      ++totalRound;
+      elapsedNs = host_time_now_ns() - startNs;
+    }
+
+    bool isOk =
+        error.maxTempErr <= BENCH_MAX_TEMP_ERR_C && error.maxPressErr <= BENCH_MAX_PRESS_ERR_PA;
+    isAllOk = isAllOk && isOk;
+    printf("%-12s T max %.5f mean %.5f C, P max %.4f mean %.4f Pa, %.1f Msamples/s, %s\n",
+           path->name,
+           error.maxTempErr,
+           error.sumTempErr / BENCH_TOTAL_VECTOR,
+           error.maxPressErr,
+           error.sumPressErr / BENCH_TOTAL_VECTOR,
+           (double)totalRound * BENCH_TOTAL_VECTOR * 1e3 / elapsedNs,
+           isOk ? "ok" : "OVER LIMIT");
+  }
+  return isAllOk ? 0 : 2;
+}
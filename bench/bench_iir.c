@@ -0,0 +1,255 @@
+/**
+ * @brief BMP280_Iir against the step response table of the datasheet and the exact recurrence
+ *
+ * The step response is checked first: a stage per coefficient is fed a step and has to reach 75 %
+ * of it after the number of samples the datasheet gives (table 7: 1, 2, 5, 11 and 22 samples for
+ * the filter off, x2, x4, x8 and x16).
+ *
+ * Then for a few pressure oversampling settings the simulated sensor is run with its filter off,
+ * the raw values going through the stages. The pressure waveform holds, steps up by 50 Pa and
+ * comes back, with the RMS noise of the datasheet drawn from the conversion time so every run sees
+ * the same values. Each stage is compared with the recurrence computed in double without rounding,
+ * which a chip keeping more bits in its filter memory approaches, and has to stay within c - 1 raw
+ * LSB of it. Also reported are how far filtering the compensated Q24.8 pressure is from
+ * compensating the filtered raw value, and the host time of a sample through all the stages
+ *
+ * @file bench_iir.c
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "host/Host_TimeSource.h"
+#include "host/sim/Sim_BMP280.h"
+#include "host/sim/Sim_TM4C.h"
+#include "include/BMP280_Drv.h"
+#include "include/BMP280_Iir.h"
+#include "include/BMP280_Utils.h"
+
+#define BENCH_I2C_ADDR 0x76
+#define BENCH_TOTAL_SAMPLE 1500
+#define BENCH_STEP_PA 50.0
+#define BENCH_NOISE_X1_PA 2.62  // RMS noise of the datasheet at x1 pressure oversampling
+#define BENCH_TOTAL_ROUND 200
+#define BENCH_STEP_BASE 0x40000  // raw values of the step response check
+#define BENCH_STEP_SIZE 0x10000
+#define BENCH_STEP_MAX_SAMPLE 64
+
+static const Bmp280Coeff benchStage[]          = {x0, x2, x4, x8, x16};
+static const uint8_t     benchStepSample[]     = {1, 2, 5, 11, 22};  // datasheet table 7
+static const Bmp280Coeff benchOsrs[]           = {x1, x4, x16};
+static const uint8_t     benchOsrsMultiplier[] = {[x1] = 1, [x4] = 4, [x16] = 16};
+
+#define BENCH_TOTAL_STAGE (sizeof(benchStage) / sizeof(benchStage[0]))
+
+static SimBmp280 simSensor;
+static double    benchNoisePa;
+static uint64_t  benchStartNs;  //!< first sample of the run
+static int32_t   rawTemp[BENCH_TOTAL_SAMPLE];
+static int32_t   rawPress[BENCH_TOTAL_SAMPLE];
+static int32_t   softTemp[BENCH_TOTAL_STAGE][BENCH_TOTAL_SAMPLE];
+static int32_t   softPress[BENCH_TOTAL_STAGE][BENCH_TOTAL_SAMPLE];
+static int32_t   softCompPress[BENCH_TOTAL_STAGE][BENCH_TOTAL_SAMPLE];
+static double    exactTemp[BENCH_TOTAL_STAGE][BENCH_TOTAL_SAMPLE];
+static double    exactPress[BENCH_TOTAL_STAGE][BENCH_TOTAL_SAMPLE];
+
+// uniform in (0, 1) from a hash of the key, splitmix64
+static double bench_uniform(uint64_t key) {
+  key = (key ^ (key >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  key = (key ^ (key >> 27)) * 0x94D049BB133111EBULL;
+  key = key ^ (key >> 31);
+  return ((key >> 11) + 0.5) / 9007199254740992.0;
+}
+
+static double bench_temperature(void* context, const uint64_t timeNs) {
+  (void)context;
+  return 22.0 + 0.02 * sqrt(-2 * log(bench_uniform(2 * timeNs))) *
+                    cos(2 * M_PI * bench_uniform(2 * timeNs + 1));
+}
+
+// the step lasts the middle third of the run
+static double bench_pressure(void* context, const uint64_t timeNs) {
+  (void)context;
+  double gaussian = sqrt(-2 * log(bench_uniform(~timeNs))) * cos(2 * M_PI * bench_uniform(timeNs));
+  double stepPa   = 0;
+  double runS     = (double)(timeNs - benchStartNs) * 1e-9;
+  if (timeNs > benchStartNs && runS > 1.0 && runS < 2.0) { stepPa = BENCH_STEP_PA; }
+  return 101325.0 + stepPa + benchNoisePa * gaussian;
+}
+
+static int bench_coeff(const uint8_t stage) {
+  return (x0 == benchStage[stage]) ? 1 : 1 << (benchStage[stage] - x1);
+}
+
+/**
+ * @brief samples after a step until each stage first reaches 75 % of it, against the datasheet
+ *
+ */
+static bool bench_step_response(void) {
+  Bmp280Iir iir;
+  uint8_t   totalSample[BENCH_TOTAL_STAGE] = {0};
+  bmp280_iir_init(&iir, benchStage, BENCH_TOTAL_STAGE);
+  bmp280_iir_add(&iir, BENCH_STEP_BASE);
+  for (uint8_t sampleIndex = 1; sampleIndex <= BENCH_STEP_MAX_SAMPLE; ++sampleIndex) {
+    bmp280_iir_add(&iir, BENCH_STEP_BASE + BENCH_STEP_SIZE);
+    for (uint8_t stage = 0; stage < BENCH_TOTAL_STAGE; ++stage) {
+      int32_t risen = bmp280_iir_get(&iir, stage) - BENCH_STEP_BASE;
+      if (0 == totalSample[stage] && 4 * risen >= 3 * BENCH_STEP_SIZE) {
+        totalSample[stage] = sampleIndex;
+      }
+    }
+  }
+
+  bool isPass = true;
+  printf("step response, samples to 75 %%:");
+  for (uint8_t stage = 0; stage < BENCH_TOTAL_STAGE; ++stage) {
+    printf(" x%d %d/%d", bench_coeff(stage), totalSample[stage], benchStepSample[stage]);
+    isPass = isPass && totalSample[stage] == benchStepSample[stage];
+  }
+  printf(" (datasheet), %s\n", isPass ? "ok" : "FAIL");
+  return isPass;
+}
+
+/**
+ * @brief BENCH_TOTAL_SAMPLE raw samples of a sensor in normal mode with its filter off, one per
+ * conversion
+ *
+ */
+static Bmp280ErrCode bench_capture(const Bmp280Coeff osrs) {
+  bmp280 sensor;
+
+  sim_tm4c_reset();
+  sim_bmp280_init(&simSensor);
+  simSensor.waveform.temperatureC = bench_temperature;
+  simSensor.waveform.pressurePa   = bench_pressure;
+  sim_bmp280_attach_i2c(&simSensor, BENCH_I2C_ADDR);
+
+  Bmp280ErrCode errCode =
+      bmp280_create_custom_setting(&sensor, x1, osrs, x0, Standard, Normal, t0_5ms);
+  if (ERR_NO_ERR == errCode) { errCode = bmp280_init(&sensor, I2C, BENCH_I2C_ADDR); }
+  if (ERR_NO_ERR == errCode) { errCode = bmp280_open(&sensor); }
+  if (ERR_NO_ERR == errCode) { errCode = bmp280_reset(&sensor); }
+  if (ERR_NO_ERR == errCode) { errCode = bmp280_update_setting(&sensor); }
+
+  uint32_t periodUs = bmp280_measure_time_us(&sensor) + bmp280_standby_time_us(&sensor);
+  sim_advance_ns((uint64_t)periodUs * 1000);
+  benchStartNs = sim_now_ns();
+  for (int sampleIndex = 0; ERR_NO_ERR == errCode && sampleIndex < BENCH_TOTAL_SAMPLE;
+       ++sampleIndex) {
+    uint64_t periodStartNs = sim_now_ns();
+    errCode = bmp280_get_raw_temp_press(&sensor, &rawTemp[sampleIndex], &rawPress[sampleIndex]);
+    sim_advance_ns((uint64_t)periodUs * 1000 - (sim_now_ns() - periodStartNs));
+  }
+  return errCode;
+}
+
+static uint32_t bench_compensate(int32_t temp, int32_t press) {
+  Bmp280CalibParam calib = simSensor.calibParam;
+  bmp280_compensate_T_int32(temp, &calib);
+  return bmp280_compensate_P_int64(press, &calib);
+}
+
+// every stage of the run, on raw and on compensated values, and the recurrence without rounding
+static void bench_filter(void) {
+  Bmp280Iir tempIir;
+  Bmp280Iir pressIir;
+  Bmp280Iir compIir;
+  bmp280_iir_init(&tempIir, benchStage, BENCH_TOTAL_STAGE);
+  bmp280_iir_init(&pressIir, benchStage, BENCH_TOTAL_STAGE);
+  bmp280_iir_init(&compIir, benchStage, BENCH_TOTAL_STAGE);
+  for (int sampleIndex = 0; sampleIndex < BENCH_TOTAL_SAMPLE; ++sampleIndex) {
+    uint32_t compPress = bench_compensate(rawTemp[sampleIndex], rawPress[sampleIndex]);
+    bmp280_iir_add(&tempIir, rawTemp[sampleIndex]);
+    bmp280_iir_add(&pressIir, rawPress[sampleIndex]);
+    bmp280_iir_add(&compIir, (int32_t)compPress);
+    for (uint8_t stage = 0; stage < BENCH_TOTAL_STAGE; ++stage) {
+      softTemp[stage][sampleIndex]      = bmp280_iir_get(&tempIir, stage);
+      softPress[stage][sampleIndex]     = bmp280_iir_get(&pressIir, stage);
+      softCompPress[stage][sampleIndex] = bmp280_iir_get(&compIir, stage);
+
+      double coeff                   = bench_coeff(stage);
+      exactTemp[stage][sampleIndex]  = rawTemp[sampleIndex];
+      exactPress[stage][sampleIndex] = rawPress[sampleIndex];
+      if (sampleIndex > 0) {
+        exactTemp[stage][sampleIndex] =
+            (exactTemp[stage][sampleIndex - 1] * (coeff - 1) + rawTemp[sampleIndex]) / coeff;
+        exactPress[stage][sampleIndex] =
+            (exactPress[stage][sampleIndex - 1] * (coeff - 1) + rawPress[sampleIndex]) / coeff;
+      }
+    }
+  }
+}
+
+// the run through all the stages again, on the host clock
+static double bench_time_ns(void) {
+  Bmp280Iir        pressIir;
+  volatile int32_t output = 0;
+  bmp280_iir_init(&pressIir, benchStage, BENCH_TOTAL_STAGE);
+  uint64_t startNs = host_time_now_ns();
+  for (int round = 0; round < BENCH_TOTAL_ROUND; ++round) {
+    for (int sampleIndex = 0; sampleIndex < BENCH_TOTAL_SAMPLE; ++sampleIndex) {
+      bmp280_iir_add(&pressIir, rawPress[sampleIndex]);
+    }
+    output = bmp280_iir_get(&pressIir, BENCH_TOTAL_STAGE - 1);
+  }
+  (void)output;
+  return (double)(host_time_now_ns() - startNs) / ((double)BENCH_TOTAL_ROUND * BENCH_TOTAL_SAMPLE);
+}
+
+/**
+ * @brief compare a stage with the recurrence without rounding and with filtering after the
+ * compensation
+ *
+ */
+static bool bench_check(const uint8_t stage) {
+  double maxRawLsb = 0;
+  double maxCompPa = 0;
+  for (int sampleIndex = 0; sampleIndex < BENCH_TOTAL_SAMPLE; ++sampleIndex) {
+    double tempLsb  = fabs(softTemp[stage][sampleIndex] - exactTemp[stage][sampleIndex]);
+    double pressLsb = fabs(softPress[stage][sampleIndex] - exactPress[stage][sampleIndex]);
+    if (tempLsb > maxRawLsb) { maxRawLsb = tempLsb; }
+    if (pressLsb > maxRawLsb) { maxRawLsb = pressLsb; }
+
+    uint32_t filtered =
+        bench_compensate(softTemp[stage][sampleIndex], softPress[stage][sampleIndex]);
+    double diffPa = fabs((double)softCompPress[stage][sampleIndex] - (double)filtered) / 256;
+    if (diffPa > maxCompPa) { maxCompPa = diffPa; }
+  }
+  bool isPass = maxRawLsb <= bench_coeff(stage) - 1;
+  printf("  filter x%-2d within %.2f raw LSB of the exact recurrence, compensated then filtered "
+         "within %.3f Pa, %s\n",
+         bench_coeff(stage),
+         maxRawLsb,
+         maxCompPa,
+         isPass ? "ok" : "FAIL");
+  return isPass;
+}
+
+int main(void) {
+  bool   isPass = bench_step_response();
+  double timeNs = 0;
+  for (size_t osrsIndex = 0; osrsIndex < sizeof(benchOsrs) / sizeof(benchOsrs[0]); ++osrsIndex) {
+    Bmp280Coeff osrs = benchOsrs[osrsIndex];
+    benchNoisePa     = BENCH_NOISE_X1_PA / sqrt(benchOsrsMultiplier[osrs]);
+    if (ERR_NO_ERR != bench_capture(osrs)) {
+      printf("capture failed\n");
+      return 1;
+    }
+    bench_filter();
+    timeNs = bench_time_ns();
+
+    printf("pressure oversampling x%d, noise %.2f Pa:\n", benchOsrsMultiplier[osrs], benchNoisePa);
+    for (uint8_t stage = 1; stage < BENCH_TOTAL_STAGE; ++stage) {
+      isPass = bench_check(stage) && isPass;
+    }
+  }
+  printf("%zu stages %.1f ns per sample, %zu bytes\n",
+         BENCH_TOTAL_STAGE,
+         timeNs,
+         sizeof(Bmp280Iir));
+  printf("%s\n", isPass ? "pass" : "FAIL");
+  return isPass ? 0 : 1;
+}
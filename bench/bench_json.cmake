@@ -0,0 +1,15 @@
+# runs bench_micro with the commit the tree is at, called by the bench_json target
+execute_process(
+  COMMAND ${GIT} rev-parse --short HEAD
+  WORKING_DIRECTORY ${SOURCE_DIR}
+  OUTPUT_VARIABLE COMMIT
+  OUTPUT_STRIP_TRAILING_WHITESPACE
+  ERROR_QUIET)
+if(NOT COMMIT)
+  set(COMMIT unknown)
+endif()
+execute_process(COMMAND ${BENCH} ${OUTPUT} ${COMMIT} RESULT_VARIABLE RESULT)
+if(NOT RESULT EQUAL 0)
+  message(FATAL_ERROR "bench_micro failed: ${RESULT}")
+endif()
+message(STATUS "wrote ${OUTPUT} for ${COMMIT}")
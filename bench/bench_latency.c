@@ -0,0 +1,116 @@
+/**
+ * @brief latency histograms of a sensor timed with the virtual clock of the host simulator
+ *
+ * Samples are read at pseudo random intervals in normal mode and right after the trigger in forced
+ * mode. The driver's sample age, estimated from the datasheet schedule, is compared with the true
+ * age the simulator knows from when it latched the data registers
+ *
+ * @file bench_latency.c
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "host/sim/Sim_BMP280.h"
+#include "host/sim/Sim_TM4C.h"
+#include "include/BMP280_Drv.h"
+#include "include/BMP280_Utils.h"
+#include "include/Latency_Hist.h"
+#include "include/Time_Source.h"
+
+#define BENCH_I2C_ADDR 0x77
+#define BENCH_TOTAL_SAMPLE 500
+#define BENCH_MAX_GAP_US 20000  // longest pause between two normal mode reads
+
+static SimBmp280 simSensor;
+
+static void bench_print_hist(const char* name, const LatencyHist* hist) {
+  printf("  %-12s p50 %7u us, p99 %7u us, max %7u us\n",
+         name,
+         latency_hist_percentile_us(hist, 50),
+         latency_hist_percentile_us(hist, 99),
+         hist->maxUs);
+}
+
+/**
+ * @brief the estimated age is trusted to within one bus read, the registers are locked somewhere
+ * inside it
+ * @return whether the estimate held for every sample
+ */
+static bool bench_run(const char* name, const Bmp280MeasureSettings settings) {
+  bmp280      sensor;
+  Bmp280Stats stats;
+  TimeSource  timeSource;
+  LatencyHist trueAge;
+  float       temperature = 0;
+  float       pressure    = 0;
+  uint32_t    maxErrorUs  = 0;
+
+  sim_tm4c_reset();
+  sim_bmp280_init(&simSensor);
+  sim_bmp280_attach_i2c(&simSensor, BENCH_I2C_ADDR);
+  sim_time_source(&timeSource);
+  latency_hist_reset(&trueAge);
+  srand(1);
+
+  Bmp280ErrCode errCode = bmp280_create_predefined_settings(&sensor, settings);
+  if (ERR_NO_ERR == errCode) { errCode = bmp280_init(&sensor, I2C, BENCH_I2C_ADDR); }
+  if (ERR_NO_ERR == errCode) { errCode = bmp280_set_time_source(&sensor, &timeSource); }
+  if (ERR_NO_ERR == errCode) { errCode = bmp280_open(&sensor); }
+  if (ERR_NO_ERR == errCode) { errCode = bmp280_reset(&sensor); }
+  if (ERR_NO_ERR == errCode) { errCode = bmp280_get_calibration_data(&sensor, NULL); }
+  if (ERR_NO_ERR == errCode) { errCode = bmp280_update_setting(&sensor); }
+  if (ERR_NO_ERR == errCode) { errCode = bmp280_reset_stats(&sensor); }
+
+  for (int sampleIndex = 0; ERR_NO_ERR == errCode && sampleIndex < BENCH_TOTAL_SAMPLE;
+       ++sampleIndex) {
+    if (Forced == sensor.mode) {
+      // trigger, wait out the typical conversion time and read
+      errCode = bmp280_update_setting(&sensor);
+      sim_advance_ns((uint64_t)bmp280_measure_time_us(&sensor) * 1000);
+    } else {
+      sim_advance_ns((uint64_t)(rand() % BENCH_MAX_GAP_US) * 1000);
+    }
+    if (ERR_NO_ERR == errCode) {
+      errCode = bmp280_get_temp_press(&sensor, &temperature, &pressure);
+    }
+
+    // a read before the first conversion ended returns the reset values, nothing to compare
+    if (false == simSensor.hasLatched && Normal == sensor.mode) { continue; }
+
+    uint32_t conversionDoneUs;
+    uint32_t deliveredUs;
+    bmp280_get_sample_time(&sensor, &conversionDoneUs, &deliveredUs);
+    uint32_t trueDoneUs = (uint32_t)(simSensor.latchedAtNs / 1000);
+    int32_t  errorUs    = time_source_diff_us(conversionDoneUs, trueDoneUs);
+    if (errorUs < 0) { errorUs = -errorUs; }
+    if ((uint32_t)errorUs > maxErrorUs) { maxErrorUs = (uint32_t)errorUs; }
+    latency_hist_add(&trueAge, time_source_diff_us(deliveredUs, trueDoneUs));
+  }
+  bmp280_get_stats(&sensor, &stats);
+
+  printf("%s: %u samples, %s\n",
+         name,
+         stats.sensor.readLatency.count,
+         (ERR_NO_ERR == errCode) ? "ok" : "error");
+  bench_print_hist("readLatency", &stats.sensor.readLatency);
+  bench_print_hist("busTime", &stats.sensor.busTime);
+  bench_print_hist("compTime", &stats.sensor.compTime);
+  bench_print_hist("sampleAge", &stats.sensor.sampleAge);
+  bench_print_hist("trueAge", &trueAge);
+  bool isOk = ERR_NO_ERR == errCode && maxErrorUs <= stats.sensor.busTime.maxUs;
+  printf("  largest error of the estimated age %u us, one bus read %u us, %s\n",
+         maxErrorUs,
+         stats.sensor.busTime.maxUs,
+         isOk ? "ok" : "FAIL");
+  return isOk;
+}
+
+int main(void) {
+  bool isOk = bench_run("normal, HandDynamic", HandDynamic);
+  isOk      = bench_run("forced, WeatherStat", WeatherStat) && isOk;
+  return isOk ? 0 : 1;
+}
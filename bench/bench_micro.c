@@ -0,0 +1,306 @@
+/**
+ * @brief microbenchmarks of every driver layer, written as JSON to track regressions per commit
+ *
+ * Covers the BMP280_Ware compensation and calibration parsing, the register byte builders of
+ * BMP280_Utils, the SPI prescaler search and full bmp280_get_temp_press reads over the simulated
+ * I2C0 and SPI0 peripherals. Every benchmark is sized to run for about BENCH_RUN_NS and repeated
+ * BENCH_TOTAL_REPEAT times, the minimum and median host ns per operation are reported, along with
+ * the simulated bus time of one operation for the reads. The build type and C flags are recorded
+ * with the results since numbers from different optimization levels can't be compared
+ *
+ * @code
+ * bench_micro > bench_micro.json
+ * bench_micro bench_micro.json $(git rev-parse --short HEAD)
+ * @endcode
+ *
+ * @file bench_micro.c
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "host/Host_Random.h"
+#include "host/Host_TimeSource.h"
+#include "host/sim/Sim_BMP280.h"
+#include "host/sim/Sim_TM4C.h"
+#include "include/BMP280_Drv.h"
+#include "include/BMP280_Utils.h"
+#include "include/BMP280_Ware.h"
+#include "include/TivaC_SPI_utils.h"
+
+#define BENCH_I2C_ADDR 0x77
+#define BENCH_CALIB_START_ADDR 0x88
+#define BENCH_TOTAL_PATTERN 64  // inputs cycled through so the compiler can't fold them
+#define BENCH_TOTAL_REPEAT 5
+#define BENCH_RUN_NS 20000000ULL
+
+// set by CMakeLists.txt
+#ifndef BENCH_BUILD_TYPE
+#define BENCH_BUILD_TYPE "unknown"
+#endif
+#ifndef BENCH_C_FLAGS
+#define BENCH_C_FLAGS "unknown"
+#endif
+
+typedef struct {
+  const char* name;
+  bool (*setup)(void);  //!< NULL if there is nothing to prepare
+  bool (*run)(const uint32_t totalOperation);
+  bool isSimulated;     //!< also report the simulated time of one operation
+} BenchMicro;
+
+static SimBmp280        simSensor;
+static bmp280           sensor;
+static Bmp280CalibParam calibParam;
+static uint8_t          rawCalibData[BENCH_TOTAL_PATTERN][BMP280_CALIB_DATA_SIZE];
+static int32_t          rawTemp[BENCH_TOTAL_PATTERN];
+static int32_t          rawPress[BENCH_TOTAL_PATTERN];
+static SpiSettings      spiSetting[BENCH_TOTAL_PATTERN];
+static volatile int64_t benchSink;  // results go here so the loops aren't optimized away
+
+/**
+ * @brief inputs shared by the benchmarks that don't touch the simulated bus
+ *
+ */
+static void bench_setup_inputs(void) {
+  static const double spiBitRateMbits[] = {0.1, 0.3, 0.5, 1.0};
+  uint32_t            state             = 1;
+
+  sim_bmp280_init(&simSensor);
+  calibParam = simSensor.calibParam;
+  for (int pattern = 0; pattern < BENCH_TOTAL_PATTERN; ++pattern) {
+    // -40 to 85 C and 300 to 1100 hPa with the datasheet calibration
+    rawTemp[pattern]  = 519888 - 120000 + (int32_t)(host_random(&state) % 240001);
+    rawPress[pattern] = 415148 - 250000 + (int32_t)(host_random(&state) % 500001);
+    for (int byteIndex = 0; byteIndex < BMP280_CALIB_DATA_SIZE; ++byteIndex) {
+      rawCalibData[pattern][byteIndex] = simSensor.regs[BENCH_CALIB_START_ADDR + byteIndex];
+    }
+    rawCalibData[pattern][0] ^= (uint8_t)pattern;  // dig_t1 LSB, so the patterns differ
+
+    SpiSettings* setting     = &spiSetting[pattern];
+    setting->spiBitRateMbits = spiBitRateMbits[pattern % 4];
+    setting->cpuClockMHz     = 16;
+    setting->cpol            = 1;
+    setting->cpha            = 1;
+    setting->operMode        = Freescale;
+    setting->isLoopBack      = false;
+    setting->transferSizeBit = 8;
+    setting->role            = Master;
+    setting->clockSource     = Systemclock;
+  }
+}
+
+static bool bench_compensate_t(const uint32_t totalOperation) {
+  float sum = 0;
+  for (uint32_t operation = 0; operation < totalOperation; ++operation) {
+    sum += bmp280_compensate_T_int32(rawTemp[operation % BENCH_TOTAL_PATTERN], &calibParam);
+  }
+  benchSink = (int64_t)sum;
+  return true;
+}
+
+static bool bench_compensate_p(const uint32_t totalOperation) {
+  float sum = 0;
+  bmp280_compensate_T_int32(rawTemp[0], &calibParam);  // sets t_fine
+  for (uint32_t operation = 0; operation < totalOperation; ++operation) {
+    sum += bmp280_compensate_P_int64(rawPress[operation % BENCH_TOTAL_PATTERN], &calibParam);
+  }
+  benchSink = (int64_t)sum;
+  return true;
+}
+
+// the compensation and conversion of one bmp280_get_temp_press
+static bool bench_compensate_t_p(const uint32_t totalOperation) {
+  float sum = 0;
+  for (uint32_t operation = 0; operation < totalOperation; ++operation) {
+    uint32_t pattern = operation % BENCH_TOTAL_PATTERN;
+    sum += (float)bmp280_compensate_T_int32(rawTemp[pattern], &calibParam) * 0.01;
+    sum += (float)bmp280_compensate_P_int64(rawPress[pattern], &calibParam) / 256.0;
+  }
+  benchSink = (int64_t)sum;
+  return true;
+}
+
+static bool bench_get_calib_param(const uint32_t totalOperation) {
+  Bmp280CalibParam parsed;
+  int64_t          sum = 0;
+  for (uint32_t operation = 0; operation < totalOperation; ++operation) {
+    if (0 != bmp280_get_calib_param(rawCalibData[operation % BENCH_TOTAL_PATTERN], &parsed)) {
+      return false;
+    }
+    sum += parsed.dig_t1 + parsed.dig_p9;
+  }
+  benchSink = sum;
+  return true;
+}
+
+static bool bench_setup_settings(void) {
+  return ERR_NO_ERR == bmp280_create_predefined_settings(&sensor, HandDynamic);
+}
+
+static bool bench_make_ctrl_byte(const uint32_t totalOperation) {
+  int64_t sum = 0;
+  for (uint32_t operation = 0; operation < totalOperation; ++operation) {
+    uint8_t controlByte;
+    if (ERR_NO_ERR != bmp280_make_ctrl_byte(&sensor, &controlByte)) { return false; }
+    sum += controlByte;
+  }
+  benchSink = sum;
+  return true;
+}
+
+static bool bench_make_cfg_byte(const uint32_t totalOperation) {
+  int64_t sum = 0;
+  for (uint32_t operation = 0; operation < totalOperation; ++operation) {
+    uint8_t configByte;
+    if (ERR_NO_ERR != bmp280_make_cfg_byte(&sensor, &configByte)) { return false; }
+    sum += configByte;
+  }
+  benchSink = sum;
+  return true;
+}
+
+static bool bench_spi_calc_clock_prescalc(const uint32_t totalOperation) {
+  int64_t sum = 0;
+  for (uint32_t operation = 0; operation < totalOperation; ++operation) {
+    uint8_t preScalc;
+    uint8_t scr;
+    if (SPI_ERR_NO_ERR !=
+        spi_calc_clock_prescalc(spiSetting[operation % BENCH_TOTAL_PATTERN], &preScalc, &scr)) {
+      return false;
+    }
+    sum += preScalc + scr;
+  }
+  benchSink = sum;
+  return true;
+}
+
+static bool bench_setup_sensor(const Bmp280ComProtocol protocol) {
+  sim_tm4c_reset();
+  sim_bmp280_init(&simSensor);
+  if (I2C == protocol) {
+    sim_bmp280_attach_i2c(&simSensor, BENCH_I2C_ADDR);
+  } else {
+    sim_bmp280_attach_spi(&simSensor);
+  }
+
+  Bmp280ErrCode errCode = bmp280_create_predefined_settings(&sensor, HandDynamic);
+  if (ERR_NO_ERR == errCode) { errCode = bmp280_init(&sensor, protocol, BENCH_I2C_ADDR); }
+  if (ERR_NO_ERR == errCode) { errCode = bmp280_open(&sensor); }
+  if (ERR_NO_ERR == errCode) { errCode = bmp280_reset(&sensor); }
+  if (ERR_NO_ERR == errCode) { errCode = bmp280_update_setting(&sensor); }
+  if (ERR_NO_ERR == errCode) { errCode = bmp280_get_calibration_data(&sensor, NULL); }
+  return ERR_NO_ERR == errCode;
+}
+
+static bool bench_setup_i2c(void) { return bench_setup_sensor(I2C); }
+
+static bool bench_setup_spi(void) { return bench_setup_sensor(SPI); }
+
+static bool bench_get_temp_press(const uint32_t totalOperation) {
+  float sum = 0;
+  for (uint32_t operation = 0; operation < totalOperation; ++operation) {
+    float temperature;
+    float pressure;
+    if (ERR_NO_ERR != bmp280_get_temp_press(&sensor, &temperature, &pressure)) { return false; }
+    sum += temperature + pressure;
+  }
+  benchSink = (int64_t)sum;
+  return true;
+}
+
+static const BenchMicro benchMicro[] = {
+    {"ware.compensate_T_int32", NULL, bench_compensate_t, false},
+    {"ware.compensate_P_int64", NULL, bench_compensate_p, false},
+    {"ware.compensate_T_P_float", NULL, bench_compensate_t_p, false},
+    {"ware.get_calib_param", NULL, bench_get_calib_param, false},
+    {"utils.make_ctrl_byte", bench_setup_settings, bench_make_ctrl_byte, false},
+    {"utils.make_cfg_byte", bench_setup_settings, bench_make_cfg_byte, false},
+    {"spi.calc_clock_prescalc", NULL, bench_spi_calc_clock_prescalc, false},
+    {"drv.get_temp_press_i2c", bench_setup_i2c, bench_get_temp_press, true},
+    {"drv.get_temp_press_spi", bench_setup_spi, bench_get_temp_press, true}};
+
+static int bench_compare_double(const void* left, const void* right) {
+  double difference = *(const double*)left - *(const double*)right;
+  return (difference > 0) - (difference < 0);
+}
+
+/**
+ * @brief double the operation count until one run takes BENCH_RUN_NS, then time the repeats
+ *
+ */
+static bool bench_measure(const BenchMicro* bench,
+                          uint32_t*         totalOperation,
+                          double            nsPerOperation[BENCH_TOTAL_REPEAT],
+                          double*           simNsPerOperation) {
+  if (NULL != bench->setup && !bench->setup()) { return false; }
+  *totalOperation = 1;
+  while (true) {
+    uint64_t startNs = host_time_now_ns();
+    if (!bench->run(*totalOperation)) { return false; }
+    if (host_time_now_ns() - startNs >= BENCH_RUN_NS || *totalOperation >= (1u << 30)) { break; }
+    *totalOperation *= 2;
+  }
+
+  uint64_t simStartNs = sim_now_ns();
+  for (int repeat = 0; repeat < BENCH_TOTAL_REPEAT; ++repeat) {
+    uint64_t startNs = host_time_now_ns();
+    if (!bench->run(*totalOperation)) { return false; }
+    nsPerOperation[repeat] = (double)(host_time_now_ns() - startNs) / *totalOperation;
+  }
+  *simNsPerOperation =
+      (double)(sim_now_ns() - simStartNs) / ((double)*totalOperation * BENCH_TOTAL_REPEAT);
+  qsort(nsPerOperation, BENCH_TOTAL_REPEAT, sizeof(double), bench_compare_double);
+  return true;
+}
+
+int main(int argc, char** argv) {
+  FILE*       output = stdout;
+  const char* commit = (3 == argc) ? argv[2] : "unknown";
+  if (argc > 3) {
+    printf("usage: %s [output.json] [commit]\n", argv[0]);
+    return 1;
+  }
+  if (argc >= 2 && NULL == (output = fopen(argv[1], "w"))) {
+    perror(argv[1]);
+    return 1;
+  }
+
+  bench_setup_inputs();
+  fprintf(output, "{\n");
+  fprintf(output, "  \"commit\": \"%s\",\n", commit);
+  fprintf(output, "  \"build_type\": \"%s\",\n", BENCH_BUILD_TYPE);
+  fprintf(output, "  \"c_flags\": \"%s\",\n", BENCH_C_FLAGS);
+  fprintf(output, "  \"bus_stats\": %s,\n", BUS_STATS_ENABLE ? "true" : "false");
+  fprintf(output, "  \"repeat\": %d,\n", BENCH_TOTAL_REPEAT);
+  fprintf(output, "  \"results\": [\n");
+
+  bool         isAllOk    = true;
+  const size_t totalBench = sizeof(benchMicro) / sizeof(benchMicro[0]);
+  for (size_t benchIndex = 0; benchIndex < totalBench; ++benchIndex) {
+    const BenchMicro* bench = &benchMicro[benchIndex];
+    uint32_t          totalOperation                     = 0;
+    double            nsPerOperation[BENCH_TOTAL_REPEAT] = {0};
+    double            simNsPerOperation                  = 0;
+
+    bool isOk = bench_measure(bench, &totalOperation, nsPerOperation, &simNsPerOperation);
+    isAllOk   = isAllOk && isOk;
+
+    fprintf(output,
+            "    {\"name\": \"%s\", \"ok\": %s, \"operations\": %u, \"ns_per_op_min\": %.3f, "
+            "\"ns_per_op_median\": %.3f",
+            bench->name,
+            isOk ? "true" : "false",
+            totalOperation,
+            nsPerOperation[0],
+            nsPerOperation[BENCH_TOTAL_REPEAT / 2]);
+    if (bench->isSimulated) { fprintf(output, ", \"sim_ns_per_op\": %.0f", simNsPerOperation); }
+    fprintf(output, "}%s\n", (benchIndex + 1 < totalBench) ? "," : "");
+  }
+
+  fprintf(output, "  ]\n}\n");
+  if (stdout != output) { fclose(output); }
+  return isAllOk ? 0 : 2;
+}
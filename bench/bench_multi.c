@@ -0,0 +1,117 @@
+/**
+ * @brief compensation of many sensors, the lanes of BMP280_Multi against a loop over one
+ * Bmp280CalibParam per sensor calling the BMP280_Ware functions
+ *
+ * Each sensor gets its own calibration spread around the datasheet example and a new raw sample
+ * every round. Both ways are timed on the host and their outputs compared bit for bit
+ *
+ * @file bench_multi.c
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "host/Host_Random.h"
+#include "host/Host_TimeSource.h"
+#include "host/sim/Sim_BMP280.h"
+#include "include/BMP280_Multi.h"
+
+#define BENCH_TOTAL_ROUND 20000
+#define BENCH_TOTAL_PATTERN 64  // raw sample sets cycled through, so the inputs keep changing
+
+static Bmp280MultiCalib multiCalib;
+static Bmp280CalibParam sensorCalib[BMP280_MULTI_MAX_SENSOR];
+static int32_t          rawTemp[BENCH_TOTAL_PATTERN][BMP280_MULTI_MAX_SENSOR];
+static int32_t          rawPress[BENCH_TOTAL_PATTERN][BMP280_MULTI_MAX_SENSOR];
+static float            structTemperature[BMP280_MULTI_MAX_SENSOR];
+static float            structPressure[BMP280_MULTI_MAX_SENSOR];
+static float            laneTemperature[BMP280_MULTI_MAX_SENSOR];
+static float            lanePressure[BMP280_MULTI_MAX_SENSOR];
+
+static const uint16_t benchTotalSensor[] = {16, 64, BMP280_MULTI_MAX_SENSOR};
+
+static void bench_setup(void) {
+  SimBmp280 reference;
+  uint32_t  state = 1;
+  sim_bmp280_init(&reference);
+  bmp280_multi_init(&multiCalib);
+  for (uint16_t sensorIndex = 0; sensorIndex < BMP280_MULTI_MAX_SENSOR; ++sensorIndex) {
+    Bmp280CalibParam* calibParam = &sensorCalib[sensorIndex];
+    *calibParam                  = reference.calibParam;
+    calibParam->dig_t1 += host_random_spread(&state, 400);
+    calibParam->dig_t2 += host_random_spread(&state, 400);
+    calibParam->dig_p1 += host_random_spread(&state, 800);
+    calibParam->dig_p2 += host_random_spread(&state, 400);
+    calibParam->dig_p4 += host_random_spread(&state, 200);
+    calibParam->dig_p8 += host_random_spread(&state, 200);
+    bmp280_multi_add(&multiCalib, calibParam, NULL);
+  }
+  // -40 to 85 C and 300 to 1100 hPa with the datasheet calibration
+  for (int patternIndex = 0; patternIndex < BENCH_TOTAL_PATTERN; ++patternIndex) {
+    for (uint16_t sensorIndex = 0; sensorIndex < BMP280_MULTI_MAX_SENSOR; ++sensorIndex) {
+      rawTemp[patternIndex][sensorIndex]  = 519888 + host_random_spread(&state, 120000);
+      rawPress[patternIndex][sensorIndex] = 415148 + host_random_spread(&state, 250000);
+    }
+  }
+}
+
+// what bmp280_get_temp_press does for each sensor
+static void bench_struct(const uint16_t totalSensor, const int pattern) {
+  for (uint16_t sensorIndex = 0; sensorIndex < totalSensor; ++sensorIndex) {
+    Bmp280CalibParam* calibParam = &sensorCalib[sensorIndex];
+    structTemperature[sensorIndex] =
+        (float)bmp280_compensate_T_int32(rawTemp[pattern][sensorIndex], calibParam) * 0.01;
+    structPressure[sensorIndex] =
+        (float)bmp280_compensate_P_int64(rawPress[pattern][sensorIndex], calibParam) / 256.0;
+  }
+}
+
+static void bench_lane(const uint16_t totalSensor, const int pattern) {
+  multiCalib.totalSensor = totalSensor;
+  bmp280_multi_compensate(
+      &multiCalib, rawTemp[pattern], rawPress[pattern], laneTemperature, lanePressure);
+}
+
+int main(void) {
+  TimeSource hostTime;
+  host_time_source_monotonic(&hostTime);
+  bench_setup();
+
+  bool isAllExact = true;
+  for (size_t sizeIndex = 0; sizeIndex < sizeof(benchTotalSensor) / sizeof(benchTotalSensor[0]);
+       ++sizeIndex) {
+    uint16_t totalSensor = benchTotalSensor[sizeIndex];
+    bool     isExact     = true;
+    for (int pattern = 0; pattern < BENCH_TOTAL_PATTERN; ++pattern) {
+      bench_struct(totalSensor, pattern);
+      bench_lane(totalSensor, pattern);
+      isExact = isExact &&
+                0 == memcmp(structTemperature, laneTemperature, totalSensor * sizeof(float)) &&
+                0 == memcmp(structPressure, lanePressure, totalSensor * sizeof(float));
+    }
+    isAllExact = isAllExact && isExact;
+
+    int      totalRound = BENCH_TOTAL_ROUND * (BMP280_MULTI_MAX_SENSOR / totalSensor);
+    uint32_t startUs    = time_source_now_us(&hostTime);
+    for (int round = 0; round < totalRound; ++round) {
+      bench_struct(totalSensor, round % BENCH_TOTAL_PATTERN);
+    }
+    uint32_t structUs = time_source_now_us(&hostTime) - startUs;
+    startUs           = time_source_now_us(&hostTime);
+    for (int round = 0; round < totalRound; ++round) {
+      bench_lane(totalSensor, round % BENCH_TOTAL_PATTERN);
+    }
+    uint32_t laneUs = time_source_now_us(&hostTime) - startUs;
+
+    double totalSample = (double)totalRound * totalSensor;
+    printf("%3u sensors: struct per sensor %.2f ns, lanes %.2f ns per sample, %.2fx, %s\n",
+           totalSensor,
+           1000.0 * structUs / totalSample,
+           1000.0 * laneUs / totalSample,
+           (double)structUs / (laneUs ? laneUs : 1),
+           isExact ? "bit exact" : "MISMATCH");
+  }
+  return isAllExact ? 0 : 2;
+}
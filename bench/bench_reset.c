@@ -0,0 +1,95 @@
+/**
+ * @brief time to first sample of a duty-cycled node in the host simulator, with the old fixed 5 ms
+ * reset delay and with the status polled reset
+ *
+ * @file bench_reset.c
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "external/TivaC_Utils/include/TivaC_Other_Utils.h"
+#include "host/sim/Sim_BMP280.h"
+#include "host/sim/Sim_TM4C.h"
+#include "include/BMP280_Drv.h"
+#include "include/BMP280_Utils.h"
+
+#define BENCH_I2C_ADDR 0x77
+#define BENCH_FIXED_DELAY_MS 5
+
+static SimBmp280 simSensor;
+
+/**
+ * @brief the reset bmp280_reset used to do, a fixed delay long enough for any NVM copy
+ *
+ */
+static Bmp280ErrCode bench_reset_fixed(bmp280* sensor, uint32_t* wakeTimeUs) {
+  uint8_t resetRegister[1] = {BMP280_RESADDR};
+  uint8_t resetData[1]     = {BMP280_RESET_CMD};
+  BMP280_TRY_FUNC(bmp280_write_register(sensor, resetRegister, 1, resetData));
+  delayms(BENCH_FIXED_DELAY_MS);
+  *wakeTimeUs = BENCH_FIXED_DELAY_MS * 1000;
+  return ERR_NO_ERR;
+}
+
+/**
+ * @brief power the simulated board on, take one forced measurement and report the time it took
+ *
+ */
+static void bench_run(const char*    name,
+                      const uint64_t nvmCopyNs,
+                      Bmp280ErrCode (*reset)(bmp280* sensor, uint32_t* wakeTimeUs)) {
+  bmp280   sensor;
+  float    temperature = 0;
+  float    pressure    = 0;
+  uint32_t wakeTimeUs  = 0;
+
+  sim_tm4c_reset();
+  sim_bmp280_init(&simSensor);
+  simSensor.nvmCopyNs = nvmCopyNs;
+  sim_bmp280_attach_i2c(&simSensor, BENCH_I2C_ADDR);
+
+  Bmp280ErrCode errCode = bmp280_create_predefined_settings(&sensor, WeatherStat);
+  if (ERR_NO_ERR == errCode) { errCode = bmp280_init(&sensor, I2C, BENCH_I2C_ADDR); }
+  if (ERR_NO_ERR == errCode) { errCode = bmp280_open(&sensor); }
+
+  uint64_t resetStartNs = sim_now_ns();
+  if (ERR_NO_ERR == errCode) { errCode = reset(&sensor, &wakeTimeUs); }
+  uint64_t resetNs = sim_now_ns() - resetStartNs;
+
+  // forced mode, the write starts the one conversion
+  if (ERR_NO_ERR == errCode) { errCode = bmp280_update_setting(&sensor); }
+  sensor.lastKnowStatus.isMeasuring = true;
+  while (ERR_NO_ERR == errCode && sensor.lastKnowStatus.isMeasuring) {
+    errCode = bmp280_get_status(&sensor);
+  }
+  if (ERR_NO_ERR == errCode) { errCode = bmp280_get_temp_press(&sensor, &temperature, &pressure); }
+
+  printf("%-26s %8.1f %10u %10.1f %10.1f %8.2f %10.1f %s\n",
+         name,
+         nvmCopyNs / 1000.0,
+         wakeTimeUs,
+         resetNs / 1000.0,
+         sim_now_ns() / 1000.0,
+         temperature,
+         pressure,
+         (ERR_NO_ERR == errCode) ? "ok" : "error");
+}
+
+int main(void) {
+  printf("%-26s %8s %10s %10s %10s %8s %10s\n",
+         "case",
+         "nvm_us",
+         "wake_us",
+         "reset_us",
+         "first_us",
+         "temp_C",
+         "press_Pa");
+  bench_run("fixed 5 ms delay", 2000000, bench_reset_fixed);
+  bench_run("status polled", 2000000, bmp280_reset_wait);
+  bench_run("fixed 5 ms delay, slow nvm", 3500000, bench_reset_fixed);
+  bench_run("status polled, slow nvm", 3500000, bmp280_reset_wait);
+  return 0;
+}
@@ -0,0 +1,95 @@
+/**
+ * @brief time to first sample after power on in the host simulator, with and without the
+ * calibration cache
+ *
+ * @file bench_startup.c
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "host/Host_CalibStore_File.h"
+#include "host/sim/Sim_BMP280.h"
+#include "host/sim/Sim_TM4C.h"
+#include "include/BMP280_CalibCache.h"
+#include "include/BMP280_Drv.h"
+#include "include/TivaC_EEPROM.h"
+
+#define BENCH_I2C_ADDR 0x77
+#define BENCH_EEPROM_ADDR 0x0
+#define BENCH_DEFAULT_CACHE_PATH "bmp280_calib_cache.bin"
+
+static SimBmp280        simSensor;
+static Bmp280CalibStore fileStore;
+static Bmp280CalibStore eepromStore;
+
+static Bmp280ErrCode bench_calib_lazy(bmp280* sensor) {
+  (void)sensor;
+  return ERR_NO_ERR;  // calibration is read by the first bmp280_get_temp_press
+}
+
+static Bmp280ErrCode bench_calib_file(bmp280* sensor) {
+  return bmp280_load_calibration_cached(sensor, &fileStore, NULL);
+}
+
+static Bmp280ErrCode bench_calib_eeprom(bmp280* sensor) {
+  if (EEPROM_NO_ERR != eeprom_open()) { return ERR_CALIB_STORE_FAIL; }
+  return bmp280_load_calibration_cached(sensor, &eepromStore, NULL);
+}
+
+/**
+ * @brief power the simulated board on and time everything up to the first compensated sample
+ *
+ */
+static void bench_run(const char* name, Bmp280ErrCode (*loadCalibration)(bmp280* sensor)) {
+  bmp280 sensor;
+  float  temperature = 0;
+  float  pressure    = 0;
+
+  sim_tm4c_reset();
+  sim_bmp280_init(&simSensor);
+  sim_bmp280_attach_i2c(&simSensor, BENCH_I2C_ADDR);
+
+  Bmp280ErrCode errCode = bmp280_create_predefined_settings(&sensor, HandDynamic);
+  if (ERR_NO_ERR == errCode) { errCode = bmp280_init(&sensor, I2C, BENCH_I2C_ADDR); }
+  if (ERR_NO_ERR == errCode) { errCode = bmp280_open(&sensor); }
+  if (ERR_NO_ERR == errCode) { errCode = bmp280_reset(&sensor); }
+
+  uint64_t calibStartNs = sim_now_ns();
+  if (ERR_NO_ERR == errCode) { errCode = loadCalibration(&sensor); }
+  uint64_t calibNs = sim_now_ns() - calibStartNs;
+
+  if (ERR_NO_ERR == errCode) { errCode = bmp280_update_setting(&sensor); }
+
+  // the data registers only hold a real sample once the first conversion is done
+  sensor.lastKnowStatus.isMeasuring = true;
+  while (ERR_NO_ERR == errCode && sensor.lastKnowStatus.isMeasuring) {
+    errCode = bmp280_get_status(&sensor);
+  }
+  if (ERR_NO_ERR == errCode) { errCode = bmp280_get_temp_press(&sensor, &temperature, &pressure); }
+
+  printf("%-22s %10.1f %12.1f %8.2f %10.1f %s\n",
+         name,
+         sim_now_ns() / 1000.0,
+         calibNs / 1000.0,
+         temperature,
+         pressure,
+         (ERR_NO_ERR == errCode) ? "ok" : "error");
+}
+
+int main(int argc, char** argv) {
+  host_calib_store_file(&fileStore, (argc > 1) ? argv[1] : BENCH_DEFAULT_CACHE_PATH);
+  bmp280_calib_store_eeprom(&eepromStore, BENCH_EEPROM_ADDR);
+  remove((const char*)fileStore.context);
+  sim_eeprom_erase();
+
+  printf("%-22s %10s %12s %8s %10s\n", "case", "first_us", "calib_us", "temp_C", "press_Pa");
+  bench_run("no cache", bench_calib_lazy);
+  bench_run("file cache, miss", bench_calib_file);
+  bench_run("file cache, hit", bench_calib_file);
+  bench_run("eeprom cache, miss", bench_calib_eeprom);
+  bench_run("eeprom cache, hit", bench_calib_eeprom);
+  return 0;
+}
@@ -0,0 +1,83 @@
+/**
+ * @brief bus and sensor counters after a run of samples in the host simulator
+ *
+ * Built twice, bench_stats with the counters and bench_stats_off with BUS_STATS_ENABLE=0, the
+ * register accesses per sample of the two show what the counters cost
+ *
+ * @file bench_stats.c
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#include <stdio.h>
+
+#include "host/sim/Sim_BMP280.h"
+#include "host/sim/Sim_TM4C.h"
+#include "include/BMP280_Drv.h"
+
+#define BENCH_I2C_ADDR 0x77
+#define BENCH_TOTAL_SAMPLE 200
+
+static SimBmp280 simSensor;
+
+static void bench_run(const char* name, const Bmp280ComProtocol protocol) {
+  bmp280      sensor;
+  Bmp280Stats stats;
+  float       temperature = 0;
+  float       pressure    = 0;
+
+  sim_tm4c_reset();
+  sim_bmp280_init(&simSensor);
+  if (I2C == protocol) {
+    sim_bmp280_attach_i2c(&simSensor, BENCH_I2C_ADDR);
+  } else {
+    sim_bmp280_attach_spi(&simSensor);
+  }
+
+  Bmp280ErrCode errCode = bmp280_create_predefined_settings(&sensor, HandDynamic);
+  if (ERR_NO_ERR == errCode) { errCode = bmp280_init(&sensor, protocol, BENCH_I2C_ADDR); }
+  if (ERR_NO_ERR == errCode) { errCode = bmp280_open(&sensor); }
+  if (ERR_NO_ERR == errCode) { errCode = bmp280_reset(&sensor); }
+  if (ERR_NO_ERR == errCode) { errCode = bmp280_update_setting(&sensor); }
+  if (ERR_NO_ERR == errCode) { errCode = bmp280_get_calibration_data(&sensor, NULL); }
+  if (ERR_NO_ERR == errCode) { errCode = bmp280_reset_stats(&sensor); }
+
+  uint64_t startAccess = sim_reg_access_count();
+  for (int sampleIndex = 0; ERR_NO_ERR == errCode && sampleIndex < BENCH_TOTAL_SAMPLE;
+       ++sampleIndex) {
+    errCode = bmp280_get_temp_press(&sensor, &temperature, &pressure);
+  }
+  uint64_t totalAccess = sim_reg_access_count() - startAccess;
+  bmp280_get_stats(&sensor, &stats);
+
+  printf("%s: %.1f register accesses per sample, last %.2f C %.1f Pa, %s\n",
+         name,
+         (double)totalAccess / BENCH_TOTAL_SAMPLE,
+         temperature,
+         pressure,
+         (ERR_NO_ERR == errCode) ? "ok" : "error");
+  printf("  sensor: sample %u, compensation %u, failedRead %u, retry %u\n",
+         stats.sensor.sample,
+         stats.sensor.compensation,
+         stats.sensor.failedRead,
+         stats.sensor.retry);
+  printf("  bus:    transaction %u, byteTx %u, byteRx %u, csAssert %u\n",
+         stats.bus.transaction,
+         stats.bus.byteTx,
+         stats.bus.byteRx,
+         stats.bus.csAssert);
+  printf("          waitCall %u, waitSpinTotal %u, waitSpinMax %u, timeout %u, busError %u\n",
+         stats.bus.waitCall,
+         stats.bus.waitSpinTotal,
+         stats.bus.waitSpinMax,
+         stats.bus.timeout,
+         stats.bus.busError);
+  printf("          recovery %u\n", stats.bus.recovery);
+}
+
+int main(void) {
+  printf("counters %s\n", BUS_STATS_ENABLE ? "enabled" : "compiled out");
+  bench_run("I2C", I2C);
+  bench_run("SPI", SPI);
+  return 0;
+}
@@ -0,0 +1,277 @@
+/**
+ * @brief vertical speed of BMP280_VSpeed against a least squares slope over a 2 s window, on an
+ * elevator ride sampled with the IndoorNav and ElevDetec presets
+ *
+ * The ride waits 3 s, accelerates at 1 m/s^2 to 1.5 m/s, travels for 6 s and stops 4 floors up.
+ * Pressure gets the RMS noise of the datasheet for the oversampling of the preset and goes through
+ * a model of the IIR filter of the chip, then to altitude with BMP280_Altitude. Reported per
+ * estimator are the RMS speed error over the ride, the speed noise while waiting, the lag behind
+ * the true speed crossing 0.75 m/s, which includes the delay of the chip filter, its RAM and its
+ * time per sample on the host. Last, a climb at 5 m/s from 8 to 9 km, past the 8388 m a position
+ * of int32 Q8 mm would hold, must end within 1 m and 0.1 m/s of the truth, and a sample 100 s
+ * after a descent at 100 m/s, a travel past 2^63 in the prediction, must start the filter over at
+ * its altitude
+ *
+ * @file bench_vspeed.c
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#include <math.h>
+#include <stdio.h>
+
+#include "host/Host_Random.h"
+#include "host/Host_TimeSource.h"
+#include "include/BMP280_Altitude.h"
+#include "include/BMP280_Drv.h"
+#include "include/BMP280_Utils.h"
+#include "include/BMP280_VSpeed.h"
+
+#define BENCH_RIDE_US 16000000
+#define BENCH_WAIT_US 3000000
+#define BENCH_ACCEL_MM_S2 1000
+#define BENCH_CRUISE_MM_S 1500
+#define BENCH_CRUISE_US 6000000
+#define BENCH_HALF_SPEED_MM_S 750
+#define BENCH_NOISE_X1_PA 2.62  // RMS noise of the datasheet at x1 pressure oversampling
+#define BENCH_MM_PER_PA 84.3    // near sea level
+#define BENCH_WINDOW_US 2000000
+#define BENCH_MAX_WINDOW 128
+#define BENCH_MAX_SAMPLE 1024
+#define BENCH_TOTAL_ROUND 200
+#define BENCH_CLIMB_START_MM 8000000
+#define BENCH_CLIMB_MM_S 5000
+#define BENCH_CLIMB_PERIOD_US 100000
+#define BENCH_CLIMB_TOTAL_SAMPLE 2000  // 200 s, 8 to 9 km, 356 to 307 hPa
+#define BENCH_GAP_MM_S -100000
+#define BENCH_GAP_US 100000000
+#define BENCH_GAP_TOTAL_SAMPLE 100  // 10 s of descent, the filter is at full speed
+
+typedef struct {
+  const char*           name;
+  Bmp280MeasureSettings setting;
+  uint8_t               osrsP;
+  uint8_t               iirCoeff;  //!< 1 for the filter off
+} BenchPreset;
+
+static const BenchPreset benchPreset[] = {{"IndoorNav", IndoorNav, 16, 16},
+                                          {"ElevDetec", ElevDetec, 4, 4}};
+
+static uint32_t benchState = 1;
+static int32_t  benchAltitudeMm[BENCH_MAX_SAMPLE];
+static int64_t  benchTimeUs[BENCH_MAX_SAMPLE];
+static double   benchSpeedMmS[BENCH_MAX_SAMPLE];
+static double   benchEstimateMmS[BENCH_MAX_SAMPLE];
+static uint32_t benchTotalSample;
+
+// true speed and altitude of the ride at timeUs
+static void bench_ride(const int64_t timeUs, double* altitudeMm, double* speedMmS) {
+  double accelS  = (double)BENCH_CRUISE_MM_S / BENCH_ACCEL_MM_S2;
+  double accelMm = 0.5 * BENCH_ACCEL_MM_S2 * accelS * accelS;
+  double cruiseS = BENCH_CRUISE_US * 1e-6;
+  double t       = (timeUs - BENCH_WAIT_US) * 1e-6;
+  if (t <= 0) {
+    *altitudeMm = 0;
+    *speedMmS   = 0;
+  } else if (t < accelS) {
+    *altitudeMm = 0.5 * BENCH_ACCEL_MM_S2 * t * t;
+    *speedMmS   = BENCH_ACCEL_MM_S2 * t;
+  } else if (t < accelS + cruiseS) {
+    *altitudeMm = accelMm + BENCH_CRUISE_MM_S * (t - accelS);
+    *speedMmS   = BENCH_CRUISE_MM_S;
+  } else if (t < 2 * accelS + cruiseS) {
+    double brake = t - accelS - cruiseS;
+    *altitudeMm  = accelMm + BENCH_CRUISE_MM_S * cruiseS + BENCH_CRUISE_MM_S * brake -
+                  0.5 * BENCH_ACCEL_MM_S2 * brake * brake;
+    *speedMmS = BENCH_CRUISE_MM_S - BENCH_ACCEL_MM_S2 * brake;
+  } else {
+    *altitudeMm = 2 * accelMm + BENCH_CRUISE_MM_S * cruiseS;
+    *speedMmS   = 0;
+  }
+}
+
+/**
+ * @brief least squares slope over the samples of the last BENCH_WINDOW_US, the way it was done
+ * before BMP280_VSpeed
+ *
+ */
+static double bench_window_slope(const int32_t* altitudeMm,
+                                  const int64_t* timeUs,
+                                  const uint32_t total) {
+  double meanT = 0;
+  double meanH = 0;
+  for (uint32_t index = 0; index < total; ++index) {
+    meanT += timeUs[index] * 1e-6;
+    meanH += altitudeMm[index];
+  }
+  meanT /= total;
+  meanH /= total;
+  double covariance = 0;
+  double variance   = 0;
+  for (uint32_t index = 0; index < total; ++index) {
+    covariance += (timeUs[index] * 1e-6 - meanT) * (altitudeMm[index] - meanH);
+    variance += (timeUs[index] * 1e-6 - meanT) * (timeUs[index] * 1e-6 - meanT);
+  }
+  return (variance > 0) ? covariance / variance : 0;
+}
+
+// the speed estimate of every sample of the ride
+static void bench_alpha_beta(Bmp280VSpeed vspeed, const uint32_t periodUs, double* estimateMmS) {
+  for (uint32_t index = 0; index < benchTotalSample; ++index) {
+    bmp280_vspeed_update(&vspeed, benchAltitudeMm[index], periodUs);
+    estimateMmS[index] = bmp280_vspeed_speed_mm_s(&vspeed);
+  }
+}
+
+static void bench_window(const uint32_t windowSize, double* estimateMmS) {
+  int32_t  windowAltitude[BENCH_MAX_WINDOW];
+  int64_t  windowTime[BENCH_MAX_WINDOW];
+  uint32_t windowTotal = 0;
+  for (uint32_t index = 0; index < benchTotalSample; ++index) {
+    if (windowTotal == windowSize) {
+      for (uint32_t slot = 1; slot < windowSize; ++slot) {
+        windowAltitude[slot - 1] = windowAltitude[slot];
+        windowTime[slot - 1]     = windowTime[slot];
+      }
+      --windowTotal;
+    }
+    windowAltitude[windowTotal] = benchAltitudeMm[index];
+    windowTime[windowTotal]     = benchTimeUs[index];
+    ++windowTotal;
+    estimateMmS[index] = bench_window_slope(windowAltitude, windowTime, windowTotal);
+  }
+}
+
+static void bench_print(const char* name, const double* estimateMmS, const size_t ramByte) {
+  double  sumSquareErr  = 0;
+  double  sumSquareRest = 0;
+  int     totalRest     = 0;
+  int64_t crossUs       = -1;
+  for (uint32_t index = 0; index < benchTotalSample; ++index) {
+    double error = estimateMmS[index] - benchSpeedMmS[index];
+    sumSquareErr += error * error;
+    if (benchTimeUs[index] < BENCH_WAIT_US) {
+      sumSquareRest += estimateMmS[index] * estimateMmS[index];
+      ++totalRest;
+    }
+    if (crossUs < 0 && estimateMmS[index] > BENCH_HALF_SPEED_MM_S) { crossUs = benchTimeUs[index]; }
+  }
+
+  // the ride crosses half the cruise speed half way through the acceleration
+  int64_t trueCrossUs =
+      BENCH_WAIT_US + (int64_t)BENCH_HALF_SPEED_MM_S * 1000000 / BENCH_ACCEL_MM_S2;
+  printf("  %-12s rms error %4.0f mm/s, at rest %3.0f mm/s, lag %4lld ms, %4zu bytes",
+         name,
+         sqrt(sumSquareErr / benchTotalSample),
+         sqrt(sumSquareRest / totalRest),
+         (long long)(crossUs - trueCrossUs) / 1000,
+         ramByte);
+}
+
+static void bench_run(const BenchPreset* preset) {
+  bmp280 sensor;
+  bmp280_create_predefined_settings(&sensor, preset->setting);
+  uint32_t periodUs = bmp280_measure_time_us(&sensor) + bmp280_standby_time_us(&sensor);
+
+  // a first order IIR of coefficient c divides the noise variance by 2c - 1
+  double   noisePa       = BENCH_NOISE_X1_PA / sqrt(preset->osrsP);
+  double   filteredPa    = noisePa / sqrt(2.0 * preset->iirCoeff - 1);
+  uint32_t altitudeNoise = (uint32_t)(filteredPa * BENCH_MM_PER_PA + 0.5);
+
+  Bmp280Altitude altitude;
+  double         chipPa = 0;
+  bmp280_altitude_init(&altitude);
+  benchTotalSample = 0;
+  for (int64_t timeUs = 0; timeUs < BENCH_RIDE_US && benchTotalSample < BENCH_MAX_SAMPLE;
+       timeUs += periodUs) {
+    double trueMm;
+    bench_ride(timeUs, &trueMm, &benchSpeedMmS[benchTotalSample]);
+    double pressPa = 101325.0 * pow(1.0 - trueMm / 44330000.0, 1.0 / 0.1903) +
+                     noisePa * host_random_gaussian(&benchState);
+    chipPa = (0 == timeUs) ? pressPa : chipPa + (pressPa - chipPa) / preset->iirCoeff;
+    benchAltitudeMm[benchTotalSample] =
+        bmp280_altitude_mm(&altitude, (uint32_t)(chipPa * 256 + 0.5));
+    benchTimeUs[benchTotalSample] = timeUs;
+    ++benchTotalSample;
+  }
+
+  Bmp280VSpeed vspeed;
+  uint32_t     windowSize = BENCH_WINDOW_US / periodUs;
+  if (windowSize > BENCH_MAX_WINDOW) { windowSize = BENCH_MAX_WINDOW; }
+  bmp280_vspeed_init(&vspeed, periodUs, BENCH_ACCEL_MM_S2, altitudeNoise);
+  printf("%s, %.1f Hz, altitude noise %u mm:\n", preset->name, 1e6 / periodUs, altitudeNoise);
+
+  uint64_t startNs = host_time_now_ns();
+  for (int round = 0; round < BENCH_TOTAL_ROUND; ++round) {
+    bench_alpha_beta(vspeed, periodUs, benchEstimateMmS);
+  }
+  uint64_t elapsedNs = host_time_now_ns() - startNs;
+  bench_print("alpha-beta", benchEstimateMmS, sizeof(vspeed));
+  printf(", %5.1f ns\n", (double)elapsedNs / ((double)BENCH_TOTAL_ROUND * benchTotalSample));
+
+  startNs = host_time_now_ns();
+  for (int round = 0; round < BENCH_TOTAL_ROUND; ++round) {
+    bench_window(windowSize, benchEstimateMmS);
+  }
+  elapsedNs = host_time_now_ns() - startNs;
+  bench_print("2 s slope", benchEstimateMmS, windowSize * (sizeof(int32_t) + sizeof(int64_t)));
+  printf(", %5.1f ns\n", (double)elapsedNs / ((double)BENCH_TOTAL_ROUND * benchTotalSample));
+}
+
+// a noiseless climb near the top of the pressure range, the filter follows a constant speed
+static bool bench_climb(void) {
+  Bmp280Altitude altitude;
+  Bmp280VSpeed   vspeed;
+  double         trueMm = 0;
+  bmp280_altitude_init(&altitude);
+  bmp280_vspeed_init(&vspeed, BENCH_CLIMB_PERIOD_US, BENCH_ACCEL_MM_S2, 300);
+  for (int index = 0; index < BENCH_CLIMB_TOTAL_SAMPLE; ++index) {
+    trueMm = BENCH_CLIMB_START_MM + (double)BENCH_CLIMB_MM_S * index * BENCH_CLIMB_PERIOD_US * 1e-6;
+    double pressPa = 101325.0 * pow(1.0 - trueMm / 44330000.0, 1.0 / 0.1903);
+    bmp280_vspeed_update(&vspeed,
+                         bmp280_altitude_mm(&altitude, (uint32_t)(pressPa * 256 + 0.5)),
+                         BENCH_CLIMB_PERIOD_US);
+  }
+
+  double altitudeErrMm = fabs(bmp280_vspeed_altitude_mm(&vspeed) - trueMm);
+  double speedErrMmS   = fabs((double)bmp280_vspeed_speed_mm_s(&vspeed) - BENCH_CLIMB_MM_S);
+  bool   isOk          = altitudeErrMm <= 1000 && speedErrMmS <= 100;
+  printf("climb to 9 km: altitude %d mm, error %.0f mm, speed %d mm/s, error %.0f mm/s, %s\n",
+         bmp280_vspeed_altitude_mm(&vspeed),
+         altitudeErrMm,
+         bmp280_vspeed_speed_mm_s(&vspeed),
+         speedErrMmS,
+         isOk ? "ok" : "WRAPPED");
+  return isOk;
+}
+
+// a fast descent, then the sensor stopped for a while, the next sample starts over
+static bool bench_gap(void) {
+  Bmp280VSpeed vspeed;
+  int32_t      altitudeMm = BENCH_CLIMB_START_MM;
+  bmp280_vspeed_init(&vspeed, BENCH_CLIMB_PERIOD_US, BENCH_ACCEL_MM_S2, 300);
+  for (int index = 0; index < BENCH_GAP_TOTAL_SAMPLE; ++index) {
+    bmp280_vspeed_update(&vspeed, altitudeMm, BENCH_CLIMB_PERIOD_US);
+    altitudeMm += BENCH_GAP_MM_S / (1000000 / BENCH_CLIMB_PERIOD_US);
+  }
+  int32_t fallSpeedMmS = bmp280_vspeed_speed_mm_s(&vspeed);
+  bmp280_vspeed_update(&vspeed, 0, BENCH_GAP_US);
+
+  bool isOk = 0 == bmp280_vspeed_altitude_mm(&vspeed) && 0 == bmp280_vspeed_speed_mm_s(&vspeed);
+  printf("100 s gap after falling at %d mm/s: altitude %d mm, speed %d mm/s, %s\n",
+         fallSpeedMmS,
+         bmp280_vspeed_altitude_mm(&vspeed),
+         bmp280_vspeed_speed_mm_s(&vspeed),
+         isOk ? "ok" : "WRAPPED");
+  return isOk;
+}
+
+int main(void) {
+  for (size_t presetIndex = 0; presetIndex < sizeof(benchPreset) / sizeof(benchPreset[0]);
+       ++presetIndex) {
+    bench_run(&benchPreset[presetIndex]);
+  }
+  bool isClimbOk = bench_climb();
+  bool isGapOk   = bench_gap();
+  return (isClimbOk && isGapOk) ? 0 : 2;
+}
@@ -0,0 +1,196 @@
+/**
+ * @brief BMP280_Window against the statistics of the stored samples of each window
+ *
+ * 30 min of samples every 8 ms, the DropDetec rate, with a slow weather drift, an elevator trip
+ * every 5 min, the RMS noise of the datasheet, jitter on the timestamps, a 90 s gap in the stream
+ * and a wrap of the microsecond clock, go through 1 s, 1 min and 10 min windows. Each closed
+ * window is compared with the double precision statistics of its samples: min and max must be
+ * equal, the mean within rounding and the standard deviation within one unit. Reported are the
+ * largest errors, the RAM of the windows against keeping their samples as floats and the host
+ * time of a sample through the three windows
+ *
+ * @file bench_window.c
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#include <math.h>
+#include <stdio.h>
+
+#include "host/Host_Random.h"
+#include "host/Host_TimeSource.h"
+#include "include/BMP280_Window.h"
+
+#define BENCH_PERIOD_US 8000
+#define BENCH_JITTER_US 200
+#define BENCH_RUN_US 1800000000ULL
+#define BENCH_GAP_START_US 780000000ULL
+#define BENCH_GAP_US 90000000ULL
+#define BENCH_FIRST_US 0xFFF00000UL  // the clock wraps 1 s in
+#define BENCH_MAX_SAMPLE (BENCH_RUN_US / BENCH_PERIOD_US)
+#define BENCH_NOISE_PA 1.3
+#define BENCH_NOISE_C 0.01
+#define BENCH_TOTAL_ROUND 20
+
+typedef struct {
+  const char*  name;
+  uint32_t     lengthUs;
+  Bmp280Window window;
+  uint32_t     firstIndex;  //!< first sample of the open window
+  uint32_t     totalClosed;
+  double       maxMeanErr;  //!< in units of the value, the worst of temperature and pressure
+  double       maxStdDevErr;
+  bool         isExact;  //!< min, max, count and the errors within the limits
+} BenchWindow;
+
+static BenchWindow benchWindow[] = {{.name = "1 s", .lengthUs = 1000000},
+                                    {.name = "1 min", .lengthUs = 60000000},
+                                    {.name = "10 min", .lengthUs = 600000000}};
+
+#define BENCH_TOTAL_WINDOW (sizeof(benchWindow) / sizeof(benchWindow[0]))
+
+static uint32_t benchState = 1;
+static uint32_t benchTimeUs[BENCH_MAX_SAMPLE];
+static int32_t  benchTemp[BENCH_MAX_SAMPLE];
+static int32_t  benchPress[BENCH_MAX_SAMPLE];
+static uint32_t benchTotalSample;
+
+// a 12 m elevator trip lasting 20 s at the start of every 5 min
+static double bench_elevator_pa(const double timeS) {
+  double tripS = fmod(timeS, 300.0);
+  if (tripS > 20.0) { return 0; }
+  return -144.0 * 0.5 * (1 - cos(2 * M_PI * tripS / 20.0));
+}
+
+static void bench_make_stream(void) {
+  benchTotalSample = 0;
+  for (uint64_t timeUs = 0; timeUs < BENCH_RUN_US && benchTotalSample < BENCH_MAX_SAMPLE;
+       timeUs += BENCH_PERIOD_US) {
+    if (timeUs >= BENCH_GAP_START_US && timeUs < BENCH_GAP_START_US + BENCH_GAP_US) { continue; }
+    double   timeS   = timeUs * 1e-6;
+    double   tempC   = 22.0 + 1.5 * sin(2 * M_PI * timeS / 900) +
+                     BENCH_NOISE_C * host_random_gaussian(&benchState);
+    double   pressPa = 100500.0 + 30.0 * sin(2 * M_PI * timeS / 1800) + bench_elevator_pa(timeS) +
+                       BENCH_NOISE_PA * host_random_gaussian(&benchState);
+    uint32_t jitter  = (uint32_t)(host_random_uniform(&benchState) * BENCH_JITTER_US);
+
+    benchTimeUs[benchTotalSample] = (uint32_t)(BENCH_FIRST_US + timeUs + jitter);
+    benchTemp[benchTotalSample]   = (int32_t)lround(tempC * 100);
+    benchPress[benchTotalSample]  = (int32_t)lround(pressPa * 256);
+    ++benchTotalSample;
+  }
+}
+
+/**
+ * @brief the statistics of the samples, two passes in double, against the window, false if min,
+ * max or count differ or the errors are over the limits
+ *
+ */
+static bool bench_compare(BenchWindow*            benchWin,
+                          const int32_t*          value,
+                          const uint32_t          endIndex,
+                          const Bmp280WindowStat* stat) {
+  uint32_t count = endIndex - benchWin->firstIndex;
+  double   mean  = 0;
+  int32_t  min   = value[benchWin->firstIndex];
+  int32_t  max   = min;
+  for (uint32_t index = benchWin->firstIndex; index < endIndex; ++index) {
+    mean += value[index];
+    if (value[index] < min) { min = value[index]; }
+    if (value[index] > max) { max = value[index]; }
+  }
+  mean /= count;
+  double spread = 0;
+  for (uint32_t index = benchWin->firstIndex; index < endIndex; ++index) {
+    spread += (value[index] - mean) * (value[index] - mean);
+  }
+
+  double meanErr   = fabs(stat->mean - mean);
+  double stdDevErr = fabs(stat->stdDev - sqrt(spread / count));
+  if (meanErr > benchWin->maxMeanErr) { benchWin->maxMeanErr = meanErr; }
+  if (stdDevErr > benchWin->maxStdDevErr) { benchWin->maxStdDevErr = stdDevErr; }
+  return count == stat->count && min == stat->min && max == stat->max && meanErr <= 0.5 + 1e-9 &&
+         stdDevErr <= 1.0;
+}
+
+static void bench_check(void) {
+  for (size_t windowIndex = 0; windowIndex < BENCH_TOTAL_WINDOW; ++windowIndex) {
+    BenchWindow* benchWin = &benchWindow[windowIndex];
+    bmp280_window_init(&benchWin->window, benchWin->lengthUs);
+    benchWin->isExact = true;
+  }
+
+  for (uint32_t index = 0; index < benchTotalSample; ++index) {
+    for (size_t windowIndex = 0; windowIndex < BENCH_TOTAL_WINDOW; ++windowIndex) {
+      BenchWindow* benchWin = &benchWindow[windowIndex];
+      if (!bmp280_window_add(&benchWin->window,
+                             benchTimeUs[index],
+                             benchTemp[index],
+                             (uint32_t)benchPress[index])) {
+        continue;
+      }
+
+      Bmp280WindowStat temp;
+      Bmp280WindowStat press;
+      bmp280_window_get_last(&benchWin->window, &temp, &press);
+      bool isTempExact  = bench_compare(benchWin, benchTemp, index, &temp);
+      bool isPressExact = bench_compare(benchWin, benchPress, index, &press);
+
+      benchWin->isExact    = benchWin->isExact && isTempExact && isPressExact;
+      benchWin->firstIndex = index;
+      ++benchWin->totalClosed;
+    }
+  }
+}
+
+// the stream through the three windows again, on the host clock
+static double bench_time_ns(void) {
+  Bmp280Window window[BENCH_TOTAL_WINDOW];
+  uint64_t     startNs = host_time_now_ns();
+  for (int round = 0; round < BENCH_TOTAL_ROUND; ++round) {
+    for (size_t windowIndex = 0; windowIndex < BENCH_TOTAL_WINDOW; ++windowIndex) {
+      bmp280_window_init(&window[windowIndex], benchWindow[windowIndex].lengthUs);
+    }
+    for (uint32_t index = 0; index < benchTotalSample; ++index) {
+      for (size_t windowIndex = 0; windowIndex < BENCH_TOTAL_WINDOW; ++windowIndex) {
+        bmp280_window_add(&window[windowIndex],
+                          benchTimeUs[index],
+                          benchTemp[index],
+                          (uint32_t)benchPress[index]);
+      }
+    }
+  }
+  volatile uint32_t count = window[0].temp.count;
+  (void)count;
+  return (double)(host_time_now_ns() - startNs) / ((double)BENCH_TOTAL_ROUND * benchTotalSample);
+}
+
+int main(void) {
+  bench_make_stream();
+  bench_check();
+
+  bool   isPass     = true;
+  size_t floatByte  = 0;
+  size_t windowByte = 0;
+  printf("%u samples, %.0f Hz, errors in 0.01 C or 1/256 Pa:\n",
+         benchTotalSample,
+         1e6 / BENCH_PERIOD_US);
+  for (size_t windowIndex = 0; windowIndex < BENCH_TOTAL_WINDOW; ++windowIndex) {
+    BenchWindow* benchWin = &benchWindow[windowIndex];
+    printf("  %-6s %5u closed, mean within %.3f, standard deviation within %.3f, %s\n",
+           benchWin->name,
+           benchWin->totalClosed,
+           benchWin->maxMeanErr,
+           benchWin->maxStdDevErr,
+           benchWin->isExact ? "min, max and count equal" : "MISMATCH");
+    isPass = isPass && benchWin->isExact && benchWin->totalClosed > 0;
+    floatByte += 2 * sizeof(float) * (benchWin->lengthUs / BENCH_PERIOD_US);
+    windowByte += sizeof(Bmp280Window);
+  }
+  printf("%zu bytes of windows against %zu bytes of float samples, %.1f ns per sample\n",
+         windowByte,
+         floatByte,
+         bench_time_ns());
+  printf("%s\n", isPass ? "pass" : "FAIL");
+  return isPass ? 0 : 1;
+}
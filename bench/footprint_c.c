@@ -0,0 +1,25 @@
+/**
+ * @brief smallest program that takes samples through the C API, only built to be measured by the
+ * bench_footprint target
+ *
+ * @file footprint_c.c
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#include "include/BMP280_Drv.h"
+
+#define FOOTPRINT_I2C_ADDR 0x77
+
+int main(void) {
+  bmp280 sensor;
+  float  temperature;
+  float  pressure;
+
+  bmp280_create_predefined_settings(&sensor, HandDynamic);
+  bmp280_init(&sensor, I2C, FOOTPRINT_I2C_ADDR);
+  bmp280_open(&sensor);
+  bmp280_reset(&sensor);
+  bmp280_update_setting(&sensor);
+  return (ERR_NO_ERR == bmp280_get_temp_press(&sensor, &temperature, &pressure)) ? 0 : 1;
+}
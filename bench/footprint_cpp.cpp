@@ -0,0 +1,23 @@
+/**
+ * @brief smallest program that takes samples through the C++ template, only built to be measured
+ * by the bench_footprint target
+ *
+ * @file footprint_cpp.cpp
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#include "include/BMP280.hpp"
+
+#define FOOTPRINT_I2C_ADDR 0x77
+
+int main(void) {
+  Bmp280<Bmp280I2c<FOOTPRINT_I2C_ADDR>, Bmp280HandDynamic> sensor;
+  float                                                    temperature;
+  float                                                    pressure;
+
+  sensor.open();
+  sensor.reset();
+  sensor.update_setting();
+  return (ERR_NO_ERR == sensor.get_temp_press(&temperature, &pressure)) ? 0 : 1;
+}
@@ -0,0 +1,19 @@
+/**
+ * @brief pthread bus lock for the host build
+ *
+ * @file Host_BusLock.c
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#include "host/Host_BusLock.h"
+
+static void host_bus_lock_pthread_lock(void* context) { pthread_mutex_lock(context); }
+
+static void host_bus_lock_pthread_unlock(void* context) { pthread_mutex_unlock(context); }
+
+void host_bus_lock_pthread(BusLock* lock, pthread_mutex_t* mutex) {
+  lock->lock    = host_bus_lock_pthread_lock;
+  lock->unlock  = host_bus_lock_pthread_unlock;
+  lock->context = mutex;
+}
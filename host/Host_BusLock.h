@@ -0,0 +1,20 @@
+/**
+ * @brief pthread mutex as the lock of a bmp280 bus, for gateways running handles from a thread
+ * pool
+ *
+ * @file Host_BusLock.h
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#ifndef _HOST_BUS_LOCK_H
+#define _HOST_BUS_LOCK_H
+
+#include <pthread.h>
+
+#include "include/BMP280_Bus.h"
+
+// mutex has to be initialized and stay valid for as long as the lock is used
+void host_bus_lock_pthread(BusLock* lock, pthread_mutex_t* mutex);
+
+#endif
@@ -0,0 +1,165 @@
+/**
+ * @brief bmp280 bus over a Unix domain socket, see Host_BusSocket.h
+ *
+ * @file Host_BusSocket.c
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#include "host/Host_BusSocket.h"
+
+#include <errno.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+static bool host_bus_socket_send(const int fd, const uint8_t* data, const size_t size) {
+  size_t totalSent = 0;
+  while (totalSent < size) {
+    ssize_t sent = send(fd, data + totalSent, size - totalSent, MSG_NOSIGNAL);
+    if (sent < 0 && EINTR == errno) { continue; }
+    if (sent <= 0) { return false; }
+    totalSent += (size_t)sent;
+  }
+  return true;
+}
+
+static bool host_bus_socket_recv(const int fd, uint8_t* data, const size_t size) {
+  size_t totalReceived = 0;
+  while (totalReceived < size) {
+    ssize_t received = recv(fd, data + totalReceived, size - totalReceived, 0);
+    if (received < 0 && EINTR == errno) { continue; }
+    if (received <= 0) { return false; }
+    totalReceived += (size_t)received;
+  }
+  return true;
+}
+
+static void host_bus_socket_disconnect(HostBusSocket* socketBus) {
+  if (socketBus->fd >= 0) { close(socketBus->fd); }
+  socketBus->fd = -1;
+}
+
+/**
+ * @brief send one frame and wait for its status, a connection that fails midway is dropped since
+ * the next response could belong to this frame
+ *
+ */
+static bool host_bus_socket_request(HostBusSocket* socketBus,
+                                    const uint8_t  frame[HOST_BUS_SOCKET_FRAME_SIZE],
+                                    uint8_t*       status) {
+  BUS_STATS_ADD(socketBus->stats, transaction, 1);
+  BUS_STATS_ADD(socketBus->stats, byteTx, HOST_BUS_SOCKET_FRAME_SIZE);
+  if (socketBus->fd < 0 ||
+      !host_bus_socket_send(socketBus->fd, frame, HOST_BUS_SOCKET_FRAME_SIZE) ||
+      !host_bus_socket_recv(socketBus->fd, status, 1)) {
+    host_bus_socket_disconnect(socketBus);
+    BUS_STATS_ADD(socketBus->stats, busError, 1);
+    return false;
+  }
+  BUS_STATS_ADD(socketBus->stats, byteRx, 1);
+  if (HOST_BUS_SOCKET_ACK != *status) { BUS_STATS_ADD(socketBus->stats, busError, 1); }
+  return true;
+}
+
+static bool host_bus_socket_open(void* context) {
+  HostBusSocket* socketBus = context;
+  if (socketBus->fd >= 0) { return true; }
+
+  struct sockaddr_un address;
+  memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  if (strlen(socketBus->path) >= sizeof(address.sun_path)) { return false; }
+  strcpy(address.sun_path, socketBus->path);
+
+  socketBus->fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (socketBus->fd < 0) { return false; }
+  if (0 != connect(socketBus->fd, (struct sockaddr*)&address, sizeof(address))) {
+    host_bus_socket_disconnect(socketBus);
+    return false;
+  }
+
+  uint8_t frame[HOST_BUS_SOCKET_FRAME_SIZE] = {
+      HOST_BUS_SOCKET_OPEN, socketBus->busIndex & 0xFF, socketBus->busIndex >> 8, 0};
+  uint8_t status;
+  if (!host_bus_socket_request(socketBus, frame, &status)) { return false; }
+  if (HOST_BUS_SOCKET_ACK != status) {
+    host_bus_socket_disconnect(socketBus);
+    return false;
+  }
+  return true;
+}
+
+static void host_bus_socket_close(void* context) { host_bus_socket_disconnect(context); }
+
+static bool host_bus_socket_is_open(void* context) { return ((HostBusSocket*)context)->fd >= 0; }
+
+static bool host_bus_socket_read(void*         context,
+                                 const uint8_t address,
+                                 const uint8_t startAddr,
+                                 uint8_t*      regData,
+                                 const uint8_t totalRegister) {
+  HostBusSocket* socketBus = context;
+  uint8_t        status;
+
+  uint8_t frame[HOST_BUS_SOCKET_FRAME_SIZE] = {
+      HOST_BUS_SOCKET_READ, address, startAddr, totalRegister};
+  if (!host_bus_socket_request(socketBus, frame, &status)) { return false; }
+  if (HOST_BUS_SOCKET_ACK != status) { return false; }
+  if (!host_bus_socket_recv(socketBus->fd, regData, totalRegister)) {
+    host_bus_socket_disconnect(socketBus);
+    BUS_STATS_ADD(socketBus->stats, busError, 1);
+    return false;
+  }
+  BUS_STATS_ADD(socketBus->stats, byteRx, totalRegister);
+  return true;
+}
+
+static bool host_bus_socket_write(void*         context,
+                                  const uint8_t address,
+                                  const uint8_t regAddr,
+                                  const uint8_t regData) {
+  uint8_t frame[HOST_BUS_SOCKET_FRAME_SIZE] = {HOST_BUS_SOCKET_WRITE, address, regAddr, regData};
+  uint8_t status;
+  return host_bus_socket_request(context, frame, &status) && HOST_BUS_SOCKET_ACK == status;
+}
+
+/**
+ * @brief reconnect after the daemon dropped the connection, e.g. because it was restarted
+ *
+ */
+static void host_bus_socket_recover(void* context) {
+  HostBusSocket* socketBus = context;
+  if (socketBus->fd >= 0) { return; }
+  BUS_STATS_ADD(socketBus->stats, recovery, 1);
+  host_bus_socket_open(socketBus);
+}
+
+static void host_bus_socket_get_stats(void* context, BusStats* stats) {
+  *stats = ((HostBusSocket*)context)->stats;
+}
+
+static void host_bus_socket_reset_stats(void* context) {
+  HostBusSocket* socketBus = context;
+  memset(&socketBus->stats, 0, sizeof(socketBus->stats));
+}
+
+static const Bmp280BusOps hostBusSocketOps = {.open        = host_bus_socket_open,
+                                              .close       = host_bus_socket_close,
+                                              .is_open     = host_bus_socket_is_open,
+                                              .read        = host_bus_socket_read,
+                                              .write       = host_bus_socket_write,
+                                              .recover     = host_bus_socket_recover,
+                                              .get_stats   = host_bus_socket_get_stats,
+                                              .reset_stats = host_bus_socket_reset_stats};
+
+void host_bus_socket_init(HostBusSocket* socketBus, const char* path, const uint16_t busIndex) {
+  memset(socketBus, 0, sizeof(*socketBus));
+  socketBus->bus.ops     = &hostBusSocketOps;
+  socketBus->bus.context = socketBus;
+  socketBus->bus.lock    = NULL;
+  socketBus->path        = path;
+  socketBus->busIndex    = busIndex;
+  socketBus->fd          = -1;
+}
@@ -0,0 +1,52 @@
+/**
+ * @brief bmp280 bus over a Unix domain socket, one connection per bus of a device daemon such as
+ * host/tools/bmp280_simd.c
+ *
+ * Every register transfer is one request frame and one response, all fields are bytes:
+ *
+ *   request   op | address | register | count for 'R', data for 'W', 0 for 'O'
+ *   response  status | count data bytes for an acked 'R'
+ *
+ * 'O' selects the bus of the connection and is sent once by open with the bus index in the
+ * address (low byte) and register (high byte) fields. A status of 0 is an ack, 1 a nack from the
+ * device and 2 a frame the daemon didn't understand. A broken connection fails the transfer and is
+ * reconnected by the retry path of the driver
+ *
+ * @file Host_BusSocket.h
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#ifndef _HOST_BUS_SOCKET_H
+#define _HOST_BUS_SOCKET_H
+
+#include <stdint.h>
+
+#include "include/BMP280_Bus.h"
+
+#define HOST_BUS_SOCKET_FRAME_SIZE 4
+
+typedef enum {
+  HOST_BUS_SOCKET_OPEN  = 'O',
+  HOST_BUS_SOCKET_READ  = 'R',
+  HOST_BUS_SOCKET_WRITE = 'W'
+} HostBusSocketOp;
+
+typedef enum {
+  HOST_BUS_SOCKET_ACK       = 0,
+  HOST_BUS_SOCKET_NACK      = 1,
+  HOST_BUS_SOCKET_BAD_FRAME = 2
+} HostBusSocketStatus;
+
+typedef struct {
+  Bmp280Bus   bus;  //!< give &socketBus->bus to bmp280_set_bus
+  const char* path;
+  uint16_t    busIndex;
+  int         fd;  //!< -1 while not connected
+  BusStats    stats;
+} HostBusSocket;
+
+// path has to stay valid for as long as the bus is used, nothing is connected until open
+void host_bus_socket_init(HostBusSocket* socketBus, const char* path, const uint16_t busIndex);
+
+#endif
@@ -0,0 +1,35 @@
+/**
+ * @brief file backed calibration store for the host build, stands in for the EEPROM store
+ *
+ * @file Host_CalibStore_File.c
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#include "host/Host_CalibStore_File.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+
+static bool host_calib_store_file_read(void* context, uint8_t* data, const uint16_t size) {
+  FILE* file = fopen((const char*)context, "rb");
+  if (NULL == file) { return false; }
+
+  bool isRead = (fread(data, 1, size, file) == size);
+  fclose(file);
+  return isRead;
+}
+
+static bool host_calib_store_file_write(void* context, const uint8_t* data, const uint16_t size) {
+  FILE* file = fopen((const char*)context, "wb");
+  if (NULL == file) { return false; }
+
+  bool isWritten = (fwrite(data, 1, size, file) == size);
+  return (0 == fclose(file)) && isWritten;
+}
+
+void host_calib_store_file(Bmp280CalibStore* store, const char* path) {
+  store->read    = host_calib_store_file_read;
+  store->write   = host_calib_store_file_write;
+  store->context = (void*)path;
+}
@@ -0,0 +1,17 @@
+/**
+ * @brief file backed calibration store for the host build
+ *
+ * @file Host_CalibStore_File.h
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#ifndef _HOST_CALIB_STORE_FILE_H
+#define _HOST_CALIB_STORE_FILE_H
+
+#include "include/BMP280_CalibCache.h"
+
+// path has to stay valid for as long as the store is used
+void host_calib_store_file(Bmp280CalibStore* store, const char* path);
+
+#endif
@@ -0,0 +1,28 @@
+/**
+ * @brief small LCG for the benches and tools, see Host_Random.h
+ *
+ * @file Host_Random.c
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#include "host/Host_Random.h"
+
+#include <math.h>
+
+uint32_t host_random(uint32_t* state) {
+  *state = *state * 1664525 + 1013904223;
+  return *state >> 8;
+}
+
+int32_t host_random_spread(uint32_t* state, const int32_t range) {
+  return (int32_t)(host_random(state) % (uint32_t)(2 * range + 1)) - range;
+}
+
+double host_random_uniform(uint32_t* state) { return (host_random(state) + 0.5) / 16777216.0; }
+
+double host_random_gaussian(uint32_t* state) {
+  double first  = host_random_uniform(state);
+  double second = host_random_uniform(state);
+  return sqrt(-2 * log(first)) * cos(2 * M_PI * second);
+}
@@ -0,0 +1,23 @@
+/**
+ * @brief small LCG for the benches and tools, so the same seed always makes the same inputs
+ *
+ * @file Host_Random.h
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#ifndef _HOST_RANDOM_H
+#define _HOST_RANDOM_H
+
+#include <stdint.h>
+
+// the 24 high bits of the next state, state is any seed to start with
+uint32_t host_random(uint32_t* state);
+// within -range to range
+int32_t host_random_spread(uint32_t* state, const int32_t range);
+// within (0, 1)
+double host_random_uniform(uint32_t* state);
+// standard normal from two uniforms, Box-Muller
+double host_random_gaussian(uint32_t* state);
+
+#endif
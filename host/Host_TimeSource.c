@@ -0,0 +1,30 @@
+/**
+ * @brief wall clock time source for the host build
+ *
+ * @file Host_TimeSource.c
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include "host/Host_TimeSource.h"
+
+#include <stddef.h>
+#include <time.h>
+
+uint64_t host_time_now_ns(void) {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (uint64_t)now.tv_sec * 1000000000 + (uint64_t)now.tv_nsec;
+}
+
+static uint32_t host_time_monotonic_now_us(void* context) {
+  (void)context;
+  return (uint32_t)(host_time_now_ns() / 1000);
+}
+
+void host_time_source_monotonic(TimeSource* source) {
+  source->now_us  = host_time_monotonic_now_us;
+  source->context = NULL;
+}
@@ -0,0 +1,21 @@
+/**
+ * @brief wall clock time source for running the drivers against real hardware from a PC
+ *
+ * @file Host_TimeSource.h
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#ifndef _HOST_TIMESOURCE_H
+#define _HOST_TIMESOURCE_H
+
+#include <stdint.h>
+
+#include "include/Time_Source.h"
+
+// CLOCK_MONOTONIC in nanoseconds, for timing loops on the host
+uint64_t host_time_now_ns(void);
+// CLOCK_MONOTONIC in microseconds, use sim_time_source when running against the simulator
+void host_time_source_monotonic(TimeSource* source);
+
+#endif
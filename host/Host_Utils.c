@@ -0,0 +1,17 @@
+/**
+ * @brief host implementation of the TivaC_Utils functions used by the drivers
+ *
+ * @file Host_Utils.c
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#include "external/TivaC_Utils/include/TivaC_Other_Utils.h"
+
+#include "host/sim/Sim_TM4C.h"
+
+/**
+ * @brief busy delay, on the host it only moves the simulator clock forward
+ *
+ */
+void delayms(uint32_t delayTime) { sim_advance_ns((uint64_t)delayTime * 1000000); }
@@ -0,0 +1,12 @@
+/**
+ * @brief host stand-in for the TivaC_Utils LED helpers, nothing in the drivers uses them
+ *
+ * @file TivaC_LED.h
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#ifndef _HOST_TIVAC_LED_H
+#define _HOST_TIVAC_LED_H
+
+#endif
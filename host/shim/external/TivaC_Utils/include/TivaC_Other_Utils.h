@@ -0,0 +1,16 @@
+/**
+ * @brief host stand-in for the TivaC_Utils delay helpers, delays advance the simulator clock
+ *
+ * @file TivaC_Other_Utils.h
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#ifndef _HOST_TIVAC_OTHER_UTILS_H
+#define _HOST_TIVAC_OTHER_UTILS_H
+
+#include <stdint.h>
+
+void delayms(uint32_t delayTime);
+
+#endif
@@ -0,0 +1,16 @@
+/**
+ * @brief host stand-in for the TivaC_Utils bit helpers
+ *
+ * @file bit_manipulation.h
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#ifndef _HOST_BIT_MANIPULATION_H
+#define _HOST_BIT_MANIPULATION_H
+
+#define bit_set(reg, mask) ((reg) |= (mask))
+#define bit_clear(reg, mask) ((reg) &= ~(mask))
+#define bit_get(reg, mask) ((reg) & (mask))
+
+#endif
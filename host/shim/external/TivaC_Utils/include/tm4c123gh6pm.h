@@ -0,0 +1,177 @@
+/**
+ * @brief host stand-in for the TI TM4C123GH6PM register header, only the registers used by the
+ * drivers are provided and every access goes through the simulator in host/sim
+ *
+ * @file tm4c123gh6pm.h
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#ifndef _HOST_TM4C123GH6PM_H
+#define _HOST_TM4C123GH6PM_H
+
+#include "host/sim/Sim_TM4C.h"
+
+/* System control */
+#define SYSCTL_RCGCGPIO_R (*sim_reg(SIM_SYSCTL_RCGCGPIO))
+#define SYSCTL_RCGCI2C_R (*sim_reg(SIM_SYSCTL_RCGCI2C))
+#define SYSCTL_RCGCSSI_R (*sim_reg(SIM_SYSCTL_RCGCSSI))
+#define SYSCTL_RCGCEEPROM_R (*sim_reg(SIM_SYSCTL_RCGCEEPROM))
+#define SYSCTL_PRGPIO_R (*sim_reg(SIM_SYSCTL_PRGPIO))
+#define SYSCTL_PRI2C_R (*sim_reg(SIM_SYSCTL_PRI2C))
+#define SYSCTL_PRSSI_R (*sim_reg(SIM_SYSCTL_PRSSI))
+#define SYSCTL_PREEPROM_R (*sim_reg(SIM_SYSCTL_PREEPROM))
+#define SYSCTL_SREEPROM_R (*sim_reg(SIM_SYSCTL_SREEPROM))
+
+#define SYSCTL_RCGCGPIO_R0 0x00000001
+#define SYSCTL_RCGCGPIO_R1 0x00000002
+#define SYSCTL_RCGCI2C_R0 0x00000001
+#define SYSCTL_RCGCSSI_R0 0x00000001
+#define SYSCTL_RCGCEEPROM_R0 0x00000001
+#define SYSCTL_PRGPIO_R0 0x00000001
+#define SYSCTL_PRGPIO_R1 0x00000002
+#define SYSCTL_PRI2C_R0 0x00000001
+#define SYSCTL_PRSSI_R0 0x00000001
+#define SYSCTL_PREEPROM_R0 0x00000001
+#define SYSCTL_SREEPROM_R0 0x00000001
+
+/* SysTick */
+#define NVIC_ST_CTRL_R (*sim_reg(SIM_NVIC_ST_CTRL))
+#define NVIC_ST_RELOAD_R (*sim_reg(SIM_NVIC_ST_RELOAD))
+#define NVIC_ST_CURRENT_R (*sim_reg(SIM_NVIC_ST_CURRENT))
+
+#define NVIC_ST_CTRL_COUNT 0x00010000
+#define NVIC_ST_CTRL_CLK_SRC 0x00000004
+#define NVIC_ST_CTRL_INTEN 0x00000002
+#define NVIC_ST_CTRL_ENABLE 0x00000001
+#define NVIC_ST_RELOAD_M 0x00FFFFFF
+#define NVIC_ST_CURRENT_M 0x00FFFFFF
+
+/* Cortex-M4 debug blocks, not part of the TI header but modeled so the DWT time source runs */
+#define DWT_CTRL_R (*sim_reg(SIM_DWT_CTRL))
+#define DWT_CYCCNT_R (*sim_reg(SIM_DWT_CYCCNT))
+#define CORE_DEMCR_R (*sim_reg(SIM_CORE_DEMCR))
+
+/* GPIO port A */
+#define GPIO_PORTA_DATA_R (*sim_reg(SIM_GPIO_PORTA_DATA))
+#define GPIO_PORTA_DIR_R (*sim_reg(SIM_GPIO_PORTA_DIR))
+#define GPIO_PORTA_AFSEL_R (*sim_reg(SIM_GPIO_PORTA_AFSEL))
+#define GPIO_PORTA_DR8R_R (*sim_reg(SIM_GPIO_PORTA_DR8R))
+#define GPIO_PORTA_ODR_R (*sim_reg(SIM_GPIO_PORTA_ODR))
+#define GPIO_PORTA_PUR_R (*sim_reg(SIM_GPIO_PORTA_PUR))
+#define GPIO_PORTA_PDR_R (*sim_reg(SIM_GPIO_PORTA_PDR))
+#define GPIO_PORTA_DEN_R (*sim_reg(SIM_GPIO_PORTA_DEN))
+#define GPIO_PORTA_LOCK_R (*sim_reg(SIM_GPIO_PORTA_LOCK))
+#define GPIO_PORTA_CR_R (*sim_reg(SIM_GPIO_PORTA_CR))
+#define GPIO_PORTA_AMSEL_R (*sim_reg(SIM_GPIO_PORTA_AMSEL))
+#define GPIO_PORTA_PCTL_R (*sim_reg(SIM_GPIO_PORTA_PCTL))
+
+/* GPIO port B */
+#define GPIO_PORTB_DATA_R (*sim_reg(SIM_GPIO_PORTB_DATA))
+#define GPIO_PORTB_DIR_R (*sim_reg(SIM_GPIO_PORTB_DIR))
+#define GPIO_PORTB_AFSEL_R (*sim_reg(SIM_GPIO_PORTB_AFSEL))
+#define GPIO_PORTB_ODR_R (*sim_reg(SIM_GPIO_PORTB_ODR))
+#define GPIO_PORTB_PUR_R (*sim_reg(SIM_GPIO_PORTB_PUR))
+#define GPIO_PORTB_PDR_R (*sim_reg(SIM_GPIO_PORTB_PDR))
+#define GPIO_PORTB_DEN_R (*sim_reg(SIM_GPIO_PORTB_DEN))
+#define GPIO_PORTB_LOCK_R (*sim_reg(SIM_GPIO_PORTB_LOCK))
+#define GPIO_PORTB_CR_R (*sim_reg(SIM_GPIO_PORTB_CR))
+#define GPIO_PORTB_AMSEL_R (*sim_reg(SIM_GPIO_PORTB_AMSEL))
+#define GPIO_PORTB_PCTL_R (*sim_reg(SIM_GPIO_PORTB_PCTL))
+
+/* I2C0 master */
+#define I2C0_MSA_R (*sim_reg(SIM_I2C0_MSA))
+#define I2C0_MCS_R (*sim_reg(SIM_I2C0_MCS))
+#define I2C0_MDR_R (*sim_reg(SIM_I2C0_MDR))
+#define I2C0_MTPR_R (*sim_reg(SIM_I2C0_MTPR))
+#define I2C0_MCR_R (*sim_reg(SIM_I2C0_MCR))
+
+#define I2C_MSA_SA_M 0x000000FE
+#define I2C_MSA_SA_S 1
+#define I2C_MSA_RS 0x00000001
+
+#define I2C_MCS_CLKTO 0x00000080
+#define I2C_MCS_BUSBSY 0x00000040
+#define I2C_MCS_IDLE 0x00000020
+#define I2C_MCS_ARBLST 0x00000010
+#define I2C_MCS_HS 0x00000010
+#define I2C_MCS_ACK 0x00000008
+#define I2C_MCS_DATACK 0x00000008
+#define I2C_MCS_ADRACK 0x00000004
+#define I2C_MCS_STOP 0x00000004
+#define I2C_MCS_ERROR 0x00000002
+#define I2C_MCS_START 0x00000002
+#define I2C_MCS_RUN 0x00000001
+#define I2C_MCS_BUSY 0x00000001
+
+#define I2C_MDR_DATA_M 0x000000FF
+#define I2C_MDR_DATA_S 0
+
+#define I2C_MTPR_TPR_M 0x0000007F
+#define I2C_MTPR_TPR_S 0
+
+#define I2C_MCR_MFE 0x00000010
+
+/* SSI0 */
+#define SSI0_CR0_R (*sim_reg(SIM_SSI0_CR0))
+#define SSI0_CR1_R (*sim_reg(SIM_SSI0_CR1))
+#define SSI0_DR_R (*sim_reg(SIM_SSI0_DR))
+#define SSI0_SR_R (*sim_reg(SIM_SSI0_SR))
+#define SSI0_CPSR_R (*sim_reg(SIM_SSI0_CPSR))
+#define SSI0_CC_R (*sim_reg(SIM_SSI0_CC))
+
+#define SSI_CR0_SCR_M 0x0000FF00
+#define SSI_CR0_SCR_S 8
+#define SSI_CR0_SPH 0x00000080
+#define SSI_CR0_SPO 0x00000040
+#define SSI_CR0_FRF_M 0x00000030
+#define SSI_CR0_FRF_MOTO 0x00000000
+#define SSI_CR0_FRF_TI 0x00000010
+#define SSI_CR0_FRF_NMW 0x00000020
+#define SSI_CR0_DSS_M 0x0000000F
+
+#define SSI_CR1_MS 0x00000004
+#define SSI_CR1_SSE 0x00000002
+#define SSI_CR1_LBM 0x00000001
+
+#define SSI_DR_DATA_M 0x0000FFFF
+#define SSI_DR_DATA_S 0
+
+#define SSI_SR_BSY 0x00000010
+#define SSI_SR_RFF 0x00000008
+#define SSI_SR_RNE 0x00000004
+#define SSI_SR_TNF 0x00000002
+#define SSI_SR_TFE 0x00000001
+
+#define SSI_CPSR_CPSDVSR_M 0x000000FF
+#define SSI_CPSR_CPSDVSR_S 0
+
+#define SSI_CC_CS_M 0x0000000F
+#define SSI_CC_CS_SYSPLL 0x00000000
+#define SSI_CC_CS_PIOSC 0x00000005
+
+/* EEPROM */
+#define EEPROM_EESIZE_R (*sim_reg(SIM_EEPROM_EESIZE))
+#define EEPROM_EEBLOCK_R (*sim_reg(SIM_EEPROM_EEBLOCK))
+#define EEPROM_EEOFFSET_R (*sim_reg(SIM_EEPROM_EEOFFSET))
+#define EEPROM_EERDWR_R (*sim_reg(SIM_EEPROM_EERDWR))
+#define EEPROM_EERDWRINC_R (*sim_reg(SIM_EEPROM_EERDWRINC))
+#define EEPROM_EEDONE_R (*sim_reg(SIM_EEPROM_EEDONE))
+#define EEPROM_EESUPP_R (*sim_reg(SIM_EEPROM_EESUPP))
+
+#define EEPROM_EESIZE_WORDCNT_M 0x0000FFFF
+#define EEPROM_EESIZE_WORDCNT_S 0
+#define EEPROM_EESIZE_BLKCNT_M 0x07FF0000
+#define EEPROM_EESIZE_BLKCNT_S 16
+
+#define EEPROM_EEDONE_INVPL 0x00000100
+#define EEPROM_EEDONE_WRBUSY 0x00000020
+#define EEPROM_EEDONE_NOPERM 0x00000010
+#define EEPROM_EEDONE_WKCOPY 0x00000008
+#define EEPROM_EEDONE_WKERASE 0x00000004
+#define EEPROM_EEDONE_WORKING 0x00000001
+
+#define EEPROM_EESUPP_PRETRY 0x00000008
+#define EEPROM_EESUPP_ERETRY 0x00000004
+
+#endif
@@ -0,0 +1,407 @@
+/**
+ * @brief host model of a BMP280
+ *
+ * @file Sim_BMP280.c
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#include "host/sim/Sim_BMP280.h"
+
+#include <math.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "include/BMP280_Ware.h"
+
+#define SIM_BMP280_CALIB_ADDR 0x88
+#define SIM_BMP280_ID_ADDR 0xD0
+#define SIM_BMP280_RESET_ADDR 0xE0
+#define SIM_BMP280_STATUS_ADDR 0xF3
+#define SIM_BMP280_CTRL_MEAS_ADDR 0xF4
+#define SIM_BMP280_CONFIG_ADDR 0xF5
+#define SIM_BMP280_PRESS_ADDR 0xF7
+#define SIM_BMP280_TEMP_ADDR 0xFA
+#define SIM_BMP280_DATA_SIZE 6
+
+#define SIM_BMP280_RESET_CMD 0xB6
+#define SIM_BMP280_MODE_M 0x03
+#define SIM_BMP280_MODE_NORMAL 0x03
+#define SIM_BMP280_FILTER_M 0x1C
+#define SIM_BMP280_MEASURING 0x08
+#define SIM_BMP280_IM_UPDATE 0x01
+#define SIM_BMP280_RAW_SKIPPED 0x80000
+#define SIM_BMP280_RAW_MAX 0xFFFFF
+
+#define SIM_BMP280_DEFAULT_TEMP_C 25.0
+#define SIM_BMP280_DEFAULT_PRESS_PA 101325.0
+
+static const uint8_t  simOsrsMultiplier[8] = {0, 1, 2, 4, 8, 16, 16, 16};
+static const uint64_t simStandbyUs[8] = {
+    500, 62500, 125000, 250000, 500000, 1000000, 2000000, 4000000};
+
+static uint64_t sim_bmp280_now(const SimBmp280* device) {
+  return device->nowNs ? device->nowNs() : sim_now_ns();
+}
+
+uint64_t sim_bmp280_measure_ns(const SimBmp280* device) {
+  uint8_t  ctrlMeas = device->regs[SIM_BMP280_CTRL_MEAS_ADDR];
+  uint64_t tempMul  = simOsrsMultiplier[(ctrlMeas >> 5) & 0x7];
+  uint64_t pressMul = simOsrsMultiplier[(ctrlMeas >> 2) & 0x7];
+
+  // typical measurement time from the datasheet: 1 + 2 * osrs_t + 2 * osrs_p + 0.5 ms
+  uint64_t measureUs = 1000 + 2000 * tempMul + 2000 * pressMul + (pressMul ? 500 : 0);
+  return (uint64_t)(measureUs * 1000 * device->timingScale);
+}
+
+int32_t sim_bmp280_raw_temp(const Bmp280CalibParam* calibParam, const double temperatureC) {
+  Bmp280CalibParam calib  = *calibParam;
+  float            target = (float)lround(temperatureC * 100);
+  int32_t          low    = 0;
+  int32_t          high   = SIM_BMP280_RAW_MAX;
+
+  // compensated temperature rises with the raw value
+  while (low < high) {
+    int32_t middle = low + (high - low) / 2;
+    if (bmp280_compensate_T_int32(middle, &calib) < target) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  return low;
+}
+
+int32_t sim_bmp280_raw_press(const Bmp280CalibParam* calibParam,
+                             const int32_t           rawTemp,
+                             const double            pressurePa) {
+  Bmp280CalibParam calib  = *calibParam;
+  double           target = pressurePa * 256;
+  int32_t          low    = 0;
+  int32_t          high   = SIM_BMP280_RAW_MAX;
+
+  bmp280_compensate_T_int32(rawTemp, &calib);
+
+  // compensated pressure falls as the raw value rises
+  while (low < high) {
+    int32_t middle = low + (high - low) / 2;
+    if (bmp280_compensate_P_int64(middle, &calib) > target) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  return low;
+}
+
+/**
+ * @brief drop the bits the chosen oversampling doesn't resolve, x1 gives 16 bit and every step
+ * adds one bit, a skipped measurement reads 0x80000
+ *
+ */
+static int32_t sim_bmp280_resolution(const int32_t raw, const uint8_t osrs) {
+  if (0 == osrs) { return SIM_BMP280_RAW_SKIPPED; }
+  if (osrs >= 5) { return raw; }
+  return raw & ~((1 << (5 - osrs)) - 1);
+}
+
+/**
+ * @brief the recurrence of the datasheet, (filtered * (c - 1) + raw) / c, on 20 bit values and
+ * fracBits below them, which is how the filter gives 20 bit whatever the oversampling
+ *
+ */
+static int32_t sim_bmp280_filter(int32_t*      filtered,
+                                 const int32_t raw,
+                                 const uint8_t filter,
+                                 const uint8_t fracBits) {
+  uint8_t shift = (filter > 4) ? 4 : filter;
+  *filtered += ((raw << fracBits) - *filtered) >> shift;
+  return *filtered >> fracBits;
+}
+
+static void sim_bmp280_store_raw(uint8_t* regs, const int32_t raw) {
+  regs[0] = (uint8_t)(raw >> 12);
+  regs[1] = (uint8_t)(raw >> 4);
+  regs[2] = (uint8_t)((raw & 0xF) << 4);
+}
+
+static bool sim_bmp280_is_normal(const SimBmp280* device) {
+  return SIM_BMP280_MODE_NORMAL == (device->regs[SIM_BMP280_CTRL_MEAS_ADDR] & SIM_BMP280_MODE_M);
+}
+
+static uint64_t sim_bmp280_period_ns(const SimBmp280* device) {
+  return sim_bmp280_measure_ns(device) +
+         1000 * simStandbyUs[(device->regs[SIM_BMP280_CONFIG_ADDR] >> 5) & 0x7];
+}
+
+/**
+ * @brief finish a conversion at the given time and copy it to the data registers
+ *
+ */
+static void sim_bmp280_latch(SimBmp280* device, const uint64_t atNs) {
+  SimBmp280Waveform* waveform     = &device->waveform;
+  double             temperatureC = SIM_BMP280_DEFAULT_TEMP_C;
+  double             pressurePa   = SIM_BMP280_DEFAULT_PRESS_PA;
+  if (waveform->temperatureC) { temperatureC = waveform->temperatureC(waveform->context, atNs); }
+  if (waveform->pressurePa) { pressurePa = waveform->pressurePa(waveform->context, atNs); }
+
+  uint8_t tempOsrs  = (device->regs[SIM_BMP280_CTRL_MEAS_ADDR] >> 5) & 0x7;
+  uint8_t pressOsrs = (device->regs[SIM_BMP280_CTRL_MEAS_ADDR] >> 2) & 0x7;
+  uint8_t filter    = (device->regs[SIM_BMP280_CONFIG_ADDR] >> 2) & 0x7;
+
+  int32_t rawTemp  = sim_bmp280_raw_temp(&device->calibParam, temperatureC);
+  int32_t rawPress = sim_bmp280_raw_press(&device->calibParam, rawTemp, pressurePa);
+
+  rawTemp  = sim_bmp280_resolution(rawTemp, tempOsrs);
+  rawPress = sim_bmp280_resolution(rawPress, pressOsrs);
+  if (filter) {
+    uint8_t fracBits = (device->iirFracBits > 8) ? 8 : device->iirFracBits;
+    if (!device->hasFiltered) {
+      device->filteredTemp  = rawTemp << fracBits;
+      device->filteredPress = rawPress << fracBits;
+      device->hasFiltered   = true;
+    }
+    // the memory starts at the first conversion, a skipped measurement leaves it alone
+    if (tempOsrs) {
+      rawTemp = sim_bmp280_filter(&device->filteredTemp, rawTemp, filter, fracBits);
+    }
+    if (pressOsrs) {
+      rawPress = sim_bmp280_filter(&device->filteredPress, rawPress, filter, fracBits);
+    }
+  }
+  sim_bmp280_store_raw(&device->regs[SIM_BMP280_PRESS_ADDR], rawPress);
+  sim_bmp280_store_raw(&device->regs[SIM_BMP280_TEMP_ADDR], rawTemp);
+  device->latchedAtNs = atNs;
+}
+
+/**
+ * @brief bring the conversion state up to the current time
+ *
+ */
+static void sim_bmp280_update(SimBmp280* device) {
+  uint64_t nowNs = sim_bmp280_now(device);
+
+  if (device->isForced) {
+    if (nowNs >= device->forcedDoneNs) {
+      sim_bmp280_latch(device, device->forcedDoneNs);
+      device->isForced = false;
+      device->regs[SIM_BMP280_CTRL_MEAS_ADDR] &= ~SIM_BMP280_MODE_M;
+    }
+  } else if (sim_bmp280_is_normal(device)) {
+    uint64_t measureNs = sim_bmp280_measure_ns(device);
+    uint64_t periodNs  = sim_bmp280_period_ns(device);
+
+    if (nowNs >= device->modeStartNs + measureNs) {
+      uint64_t cycle = (nowNs - device->modeStartNs - measureNs) / periodNs;
+      if (false == device->hasLatched || cycle != device->latchedCycle) {
+        // the filter sees every conversion, not only the ones that were read
+        uint64_t firstCycle = cycle;
+        if (device->regs[SIM_BMP280_CONFIG_ADDR] & SIM_BMP280_FILTER_M) {
+          firstCycle = device->hasLatched ? device->latchedCycle + 1 : 0;
+        }
+        for (uint64_t latchCycle = firstCycle; latchCycle <= cycle; ++latchCycle) {
+          sim_bmp280_latch(device, device->modeStartNs + latchCycle * periodNs + measureNs);
+        }
+        device->hasLatched   = true;
+        device->latchedCycle = cycle;
+      }
+    }
+  }
+}
+
+static uint8_t sim_bmp280_status(SimBmp280* device) {
+  uint64_t nowNs  = sim_bmp280_now(device);
+  uint8_t  status = 0;
+
+  if (nowNs < device->nvmDoneNs) { status |= SIM_BMP280_IM_UPDATE; }
+  if (device->isForced) {
+    status |= SIM_BMP280_MEASURING;
+  } else if (sim_bmp280_is_normal(device)) {
+    uint64_t measureNs = sim_bmp280_measure_ns(device);
+    uint64_t periodNs  = sim_bmp280_period_ns(device);
+    if (((nowNs - device->modeStartNs) % periodNs) < measureNs) { status |= SIM_BMP280_MEASURING; }
+  }
+  return status;
+}
+
+static void sim_bmp280_reset(SimBmp280* device) {
+  device->regs[SIM_BMP280_CTRL_MEAS_ADDR] = 0;
+  device->regs[SIM_BMP280_CONFIG_ADDR]    = 0;
+  sim_bmp280_store_raw(&device->regs[SIM_BMP280_PRESS_ADDR], SIM_BMP280_RAW_SKIPPED);
+  sim_bmp280_store_raw(&device->regs[SIM_BMP280_TEMP_ADDR], SIM_BMP280_RAW_SKIPPED);
+
+  device->isForced    = false;
+  device->hasLatched  = false;
+  device->hasFiltered = false;
+  device->isBurst     = false;
+  device->nvmDoneNs  = sim_bmp280_now(device) + device->nvmCopyNs;
+}
+
+static uint8_t sim_bmp280_read_reg(SimBmp280* device, const uint8_t reg) {
+  if (device->isBurst && reg >= SIM_BMP280_PRESS_ADDR &&
+      reg < SIM_BMP280_PRESS_ADDR + SIM_BMP280_DATA_SIZE) {
+    return device->burst[reg - SIM_BMP280_PRESS_ADDR];
+  }
+  if (reg >= SIM_BMP280_CALIB_ADDR && reg < SIM_BMP280_CALIB_ADDR + BMP280_CALIB_DATA_SIZE &&
+      sim_bmp280_now(device) < device->nvmDoneNs) {
+    return 0;  // the calibration image is still being copied from the NVM
+  }
+
+  sim_bmp280_update(device);
+  if (SIM_BMP280_STATUS_ADDR == reg) { return sim_bmp280_status(device); }
+  return device->regs[reg];
+}
+
+static void sim_bmp280_write_reg(SimBmp280* device, const uint8_t reg, const uint8_t data) {
+  switch (reg) {
+    case SIM_BMP280_RESET_ADDR:
+      if (SIM_BMP280_RESET_CMD == data) { sim_bmp280_reset(device); }
+      break;
+
+    case SIM_BMP280_CTRL_MEAS_ADDR:
+      sim_bmp280_update(device);
+      device->regs[reg] = data;
+      device->isForced  = false;
+      if (SIM_BMP280_MODE_NORMAL == (data & SIM_BMP280_MODE_M)) {
+        device->modeStartNs = sim_bmp280_now(device);
+        device->hasLatched  = false;
+      } else if (data & SIM_BMP280_MODE_M) {
+        device->isForced     = true;
+        device->forcedDoneNs = sim_bmp280_now(device) + sim_bmp280_measure_ns(device);
+      }
+      break;
+
+    case SIM_BMP280_CONFIG_ADDR:
+      sim_bmp280_update(device);
+      device->regs[reg]   = data;
+      device->hasFiltered = false;
+      break;
+
+    default:
+      break;  // everything else is read only
+  }
+}
+
+static void sim_bmp280_begin_read(SimBmp280* device) {
+  sim_bmp280_update(device);
+  memcpy(device->burst, &device->regs[SIM_BMP280_PRESS_ADDR], SIM_BMP280_DATA_SIZE);
+  device->isBurst = true;
+}
+
+static void sim_bmp280_i2c_start(void* context, const bool isRead) {
+  SimBmp280* device = context;
+  device->isRead    = isRead;
+  device->isBurst   = false;
+  if (isRead) {
+    sim_bmp280_begin_read(device);
+  } else {
+    device->expectAddress = true;
+  }
+}
+
+/**
+ * @brief writes come in register address and data pairs, there is no auto increment
+ *
+ */
+static bool sim_bmp280_i2c_write(void* context, const uint8_t data) {
+  SimBmp280* device = context;
+  if (device->expectAddress) {
+    device->pointer       = data;
+    device->expectAddress = false;
+  } else {
+    sim_bmp280_write_reg(device, device->pointer, data);
+    device->expectAddress = true;
+  }
+  return true;
+}
+
+static uint8_t sim_bmp280_i2c_read(void* context) {
+  SimBmp280* device = context;
+  return sim_bmp280_read_reg(device, device->pointer++);
+}
+
+static void sim_bmp280_i2c_stop(void* context) {
+  SimBmp280* device = context;
+  device->isBurst   = false;
+}
+
+static void sim_bmp280_spi_select(void* context, const bool isSelected) {
+  SimBmp280* device     = context;
+  device->isBurst       = false;
+  device->expectAddress = isSelected;
+}
+
+/**
+ * @brief the first byte after chip select, and every second byte of a write, is a control byte,
+ * bit 7 is the read bit and replaces the msb of the register address
+ *
+ */
+static uint8_t sim_bmp280_spi_transfer(void* context, const uint8_t mosi) {
+  SimBmp280* device = context;
+  if (device->expectAddress) {
+    device->isRead        = mosi & 0x80;
+    device->pointer       = mosi | 0x80;
+    device->expectAddress = false;
+    if (device->isRead) { sim_bmp280_begin_read(device); }
+    return 0xFF;
+  }
+  if (device->isRead) { return sim_bmp280_read_reg(device, device->pointer++); }
+
+  sim_bmp280_write_reg(device, device->pointer, mosi);
+  device->expectAddress = true;
+  return 0xFF;
+}
+
+const SimDeviceOps simBmp280Ops = {.start    = sim_bmp280_i2c_start,
+                                   .write    = sim_bmp280_i2c_write,
+                                   .read     = sim_bmp280_i2c_read,
+                                   .stop     = sim_bmp280_i2c_stop,
+                                   .select   = sim_bmp280_spi_select,
+                                   .transfer = sim_bmp280_spi_transfer};
+
+/**
+ * @brief calibration example from the datasheet, section 3.12
+ *
+ */
+void sim_bmp280_init(SimBmp280* device) {
+  memset(device, 0, sizeof(*device));
+  device->calibParam.dig_t1 = 27504;
+  device->calibParam.dig_t2 = 26435;
+  device->calibParam.dig_t3 = -1000;
+  device->calibParam.dig_p1 = 36477;
+  device->calibParam.dig_p2 = -10685;
+  device->calibParam.dig_p3 = 3024;
+  device->calibParam.dig_p4 = 2855;
+  device->calibParam.dig_p5 = 140;
+  device->calibParam.dig_p6 = -7;
+  device->calibParam.dig_p7 = 15500;
+  device->calibParam.dig_p8 = -14600;
+  device->calibParam.dig_p9 = 6000;
+  device->nvmCopyNs         = SIM_BMP280_NVM_COPY_NS;
+  device->timingScale       = 1.0;
+  sim_bmp280_power_on(device);
+}
+
+void sim_bmp280_power_on(SimBmp280* device) {
+  const uint16_t calibWord[12] = {
+      device->calibParam.dig_t1,           (uint16_t)device->calibParam.dig_t2,
+      (uint16_t)device->calibParam.dig_t3, device->calibParam.dig_p1,
+      (uint16_t)device->calibParam.dig_p2, (uint16_t)device->calibParam.dig_p3,
+      (uint16_t)device->calibParam.dig_p4, (uint16_t)device->calibParam.dig_p5,
+      (uint16_t)device->calibParam.dig_p6, (uint16_t)device->calibParam.dig_p7,
+      (uint16_t)device->calibParam.dig_p8, (uint16_t)device->calibParam.dig_p9};
+
+  memset(device->regs, 0, sizeof(device->regs));
+  for (uint8_t wordIndex = 0; wordIndex < 12; ++wordIndex) {
+    device->regs[SIM_BMP280_CALIB_ADDR + 2 * wordIndex]     = (uint8_t)calibWord[wordIndex];
+    device->regs[SIM_BMP280_CALIB_ADDR + 2 * wordIndex + 1] = (uint8_t)(calibWord[wordIndex] >> 8);
+  }
+  device->regs[SIM_BMP280_ID_ADDR] = SIM_BMP280_CHIP_ID;
+  sim_bmp280_reset(device);
+}
+
+void sim_bmp280_attach_i2c(SimBmp280* device, const uint8_t address) {
+  sim_i2c0_attach(&simBmp280Ops, device, address);
+}
+
+void sim_bmp280_attach_spi(SimBmp280* device) { sim_ssi0_attach(&simBmp280Ops, device); }
@@ -0,0 +1,85 @@
+/**
+ * @brief host model of a BMP280: register map, NVM copy after reset, conversion timing in sleep,
+ * forced and normal mode, raw adc values generated from temperature and pressure waveforms and the
+ * IIR filter of the datasheet on them
+ *
+ * The filter runs on every normal mode conversion, read or not, on the values cut to the
+ * resolution of the oversampling, and its memory is cleared by a reset or a write to config. How
+ * many bits the chip keeps in that memory is not documented: by default the model runs the
+ * recurrence of the datasheet on 20 bit values, iirFracBits keeps more below them
+ *
+ * @file Sim_BMP280.h
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#ifndef _SIM_BMP280_H
+#define _SIM_BMP280_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "host/sim/Sim_TM4C.h"
+#include "include/BMP280_Ware.h"
+
+#define SIM_BMP280_CHIP_ID 0x58
+#define SIM_BMP280_NVM_COPY_NS 2000000  // typical start-up time from the datasheet
+
+/**
+ * @brief physical values seen by the sensor over time, NULL functions give 25 C and 101325 Pa
+ */
+typedef struct {
+  double (*temperatureC)(void* context, const uint64_t timeNs);
+  double (*pressurePa)(void* context, const uint64_t timeNs);
+  void* context;
+} SimBmp280Waveform;
+
+/**
+ * @brief one simulated sensor, fields in the first block can be changed after sim_bmp280_init,
+ * changes to calibParam take effect on the next sim_bmp280_power_on
+ */
+typedef struct {
+  Bmp280CalibParam  calibParam;
+  SimBmp280Waveform waveform;
+  uint64_t          nvmCopyNs;    // how long im_update stays set after power on or reset
+  double            timingScale;  // multiplier on the typical conversion time
+  uint64_t (*nowNs)(void);        // clock of the device, the TM4C model clock by default
+  uint8_t           iirFracBits;  // IIR memory bits below the 20 of the registers, up to 8
+
+  uint8_t  regs[256];
+  uint64_t nvmDoneNs;
+  uint64_t modeStartNs;    // start of the first normal mode cycle
+  uint64_t latchedCycle;   // last normal mode cycle copied to the data registers
+  uint64_t latchedAtNs;    // end of the conversion now held in the data registers
+  bool     hasLatched;
+  int32_t  filteredTemp;   // IIR filter memory, raw values shifted left by iirFracBits
+  int32_t  filteredPress;
+  bool     hasFiltered;    // cleared by a reset or a write to config
+  bool     isForced;
+  uint64_t forcedDoneNs;
+  uint8_t  burst[6];  // data registers shadowed for the length of a read transaction
+  bool     isBurst;
+  bool     isRead;
+  bool     expectAddress;
+  uint8_t  pointer;
+} SimBmp280;
+
+extern const SimDeviceOps simBmp280Ops;
+
+void sim_bmp280_init(SimBmp280* device);  // datasheet example calibration, then power on
+void sim_bmp280_power_on(SimBmp280* device);
+
+// convenience wrappers around sim_i2c0_attach and sim_ssi0_attach
+void sim_bmp280_attach_i2c(SimBmp280* device, const uint8_t address);
+void sim_bmp280_attach_spi(SimBmp280* device);
+
+// conversion time of the current ctrl_meas setting
+uint64_t sim_bmp280_measure_ns(const SimBmp280* device);
+
+// raw adc values that compensate to the given temperature and pressure with this calibration
+int32_t sim_bmp280_raw_temp(const Bmp280CalibParam* calibParam, const double temperatureC);
+int32_t sim_bmp280_raw_press(const Bmp280CalibParam* calibParam,
+                             const int32_t           rawTemp,
+                             const double            pressurePa);
+
+#endif
@@ -0,0 +1,149 @@
+/**
+ * @brief an I2C bus of simulated devices, see Sim_Bus.h
+ *
+ * @file Sim_Bus.c
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include "host/sim/Sim_Bus.h"
+
+#include <stddef.h>
+#include <string.h>
+#include <time.h>
+
+#define SIM_BUS_BYTE_BIT 9   // 8 data bits and the ack
+#define SIM_BUS_FRAME_BIT 2  // start and stop
+
+static int sim_bus_find(const SimBus* simBus, const uint8_t address) {
+  for (int deviceIndex = 0; deviceIndex < simBus->totalDevice; ++deviceIndex) {
+    if (address == simBus->device[deviceIndex].address) { return deviceIndex; }
+  }
+  return -1;
+}
+
+/**
+ * @brief hold the bus for the time totalByte bytes take on the wire
+ *
+ */
+static void sim_bus_occupy(const SimBus* simBus, const uint32_t totalByte) {
+  if (0 == simBus->bitNs) { return; }
+  uint64_t        busyNs = simBus->bitNs * (totalByte * SIM_BUS_BYTE_BIT + SIM_BUS_FRAME_BIT);
+  struct timespec busy   = {.tv_sec  = (time_t)(busyNs / 1000000000),
+                            .tv_nsec = (long)(busyNs % 1000000000)};
+  nanosleep(&busy, NULL);
+}
+
+static bool sim_bus_open(void* context) {
+  SimBus* simBus = context;
+  simBus->isOpen = true;
+  return true;
+}
+
+static void sim_bus_close(void* context) {
+  SimBus* simBus = context;
+  simBus->isOpen = false;
+}
+
+static bool sim_bus_is_open(void* context) { return ((SimBus*)context)->isOpen; }
+
+/**
+ * @brief write the register address, then a repeated start to read, like the TivaC I2C0 path
+ *
+ */
+static bool sim_bus_read(void*         context,
+                         const uint8_t address,
+                         const uint8_t startAddr,
+                         uint8_t*      regData,
+                         const uint8_t totalRegister) {
+  SimBus* simBus      = context;
+  int     deviceIndex = sim_bus_find(simBus, address);
+  BUS_STATS_ADD(simBus->stats, transaction, 1);
+  if (!simBus->isOpen || deviceIndex < 0) {
+    BUS_STATS_ADD(simBus->stats, busError, 1);
+    return false;
+  }
+
+  const SimDeviceOps* ops    = simBus->device[deviceIndex].ops;
+  void*               device = simBus->device[deviceIndex].device;
+  ops->start(device, false);
+  bool isAcked = ops->write(device, startAddr);
+  if (isAcked) {
+    ops->start(device, true);
+    for (uint8_t regIndex = 0; regIndex < totalRegister; ++regIndex) {
+      regData[regIndex] = ops->read(device);
+    }
+  }
+  ops->stop(device);
+  sim_bus_occupy(simBus, 3 + totalRegister);
+  BUS_STATS_ADD(simBus->stats, byteTx, 3);
+  BUS_STATS_ADD(simBus->stats, byteRx, totalRegister);
+  if (!isAcked) { BUS_STATS_ADD(simBus->stats, busError, 1); }
+  return isAcked;
+}
+
+static bool sim_bus_write(void*         context,
+                          const uint8_t address,
+                          const uint8_t regAddr,
+                          const uint8_t regData) {
+  SimBus* simBus      = context;
+  int     deviceIndex = sim_bus_find(simBus, address);
+  BUS_STATS_ADD(simBus->stats, transaction, 1);
+  if (!simBus->isOpen || deviceIndex < 0) {
+    BUS_STATS_ADD(simBus->stats, busError, 1);
+    return false;
+  }
+
+  const SimDeviceOps* ops    = simBus->device[deviceIndex].ops;
+  void*               device = simBus->device[deviceIndex].device;
+  ops->start(device, false);
+  bool isAcked = ops->write(device, regAddr) && ops->write(device, regData);
+  ops->stop(device);
+  sim_bus_occupy(simBus, 3);
+  BUS_STATS_ADD(simBus->stats, byteTx, 3);
+  if (!isAcked) { BUS_STATS_ADD(simBus->stats, busError, 1); }
+  return isAcked;
+}
+
+static void sim_bus_get_stats(void* context, BusStats* stats) {
+  *stats = ((SimBus*)context)->stats;
+}
+
+static void sim_bus_reset_stats(void* context) {
+  SimBus* simBus = context;
+  memset(&simBus->stats, 0, sizeof(simBus->stats));
+}
+
+static const Bmp280BusOps simBusOps = {.open        = sim_bus_open,
+                                       .close       = sim_bus_close,
+                                       .is_open     = sim_bus_is_open,
+                                       .read        = sim_bus_read,
+                                       .write       = sim_bus_write,
+                                       .recover     = NULL,
+                                       .get_stats   = sim_bus_get_stats,
+                                       .reset_stats = sim_bus_reset_stats};
+
+void sim_bus_init(SimBus* simBus, const uint32_t bitRateHz) {
+  memset(simBus, 0, sizeof(*simBus));
+  simBus->bus.ops     = &simBusOps;
+  simBus->bus.context = simBus;
+  simBus->bus.lock    = NULL;
+  simBus->bitNs       = bitRateHz ? 1000000000ULL / bitRateHz : 0;
+}
+
+bool sim_bus_attach(SimBus* simBus, const SimDeviceOps* ops, void* device, const uint8_t address) {
+  if (simBus->totalDevice >= SIM_BUS_MAX_DEVICE) { return false; }
+  simBus->device[simBus->totalDevice].ops     = ops;
+  simBus->device[simBus->totalDevice].device  = device;
+  simBus->device[simBus->totalDevice].address = address;
+  ++simBus->totalDevice;
+  return true;
+}
+
+uint64_t sim_bus_wall_ns(void) {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (uint64_t)now.tv_sec * 1000000000 + (uint64_t)now.tv_nsec;
+}
@@ -0,0 +1,48 @@
+/**
+ * @brief an I2C bus of simulated devices without the TM4C model in between, for driver handles
+ * used from many threads at once
+ *
+ * Each SimBus is its own bus with its own devices and counters, nothing is shared with the TM4C
+ * model or with other SimBus, so handles on different buses run in parallel and the ones on the
+ * same bus only contend for its lock. A transfer occupies the bus for as long as its bits take at
+ * bitRateHz, the calling thread sleeps meanwhile like it would on a kernel I2C driver
+ *
+ * @file Sim_Bus.h
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#ifndef _SIM_BUS_H
+#define _SIM_BUS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "host/sim/Sim_TM4C.h"
+#include "include/BMP280_Bus.h"
+
+#define SIM_BUS_MAX_DEVICE 8
+
+typedef struct {
+  Bmp280Bus bus;     //!< give &simBus->bus to bmp280_set_bus, set bus.lock to share it
+  uint64_t  bitNs;   //!< 0 makes transfers instant
+  bool      isOpen;
+  BusStats  stats;
+
+  uint8_t totalDevice;
+  struct {
+    const SimDeviceOps* ops;
+    void*               device;
+    uint8_t             address;
+  } device[SIM_BUS_MAX_DEVICE];
+} SimBus;
+
+// bitRateHz of 0 makes transfers instant, the bus has no lock
+void sim_bus_init(SimBus* simBus, const uint32_t bitRateHz);
+// false once SIM_BUS_MAX_DEVICE are attached
+bool sim_bus_attach(SimBus* simBus, const SimDeviceOps* ops, void* device, const uint8_t address);
+
+// CLOCK_MONOTONIC in ns, a clock for simulated devices that are used from several threads
+uint64_t sim_bus_wall_ns(void);
+
+#endif
@@ -0,0 +1,167 @@
+/**
+ * @brief virtual device answering register reads from a captured bus trace
+ *
+ * @file Sim_Replay.c
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#include "host/sim/Sim_Replay.h"
+
+#include <string.h>
+
+/**
+ * @brief copy the bytes of a record into the register file
+ *
+ */
+static void sim_replay_apply(SimReplay* replay, const BusTraceRecord* record) {
+  for (uint8_t byteIndex = 0; byteIndex < record->length; ++byteIndex) {
+    replay->regs[(uint8_t)(record->reg + byteIndex)] = record->data[byteIndex];
+  }
+}
+
+/**
+ * @brief match a transfer with the next record of the same direction and register
+ * @return whether a record was found, record is filled then
+ */
+static bool sim_replay_take(SimReplay*      replay,
+                            const bool      isWrite,
+                            const uint8_t   reg,
+                            BusTraceRecord* record) {
+  uint32_t offset   = replay->cursor;
+  uint32_t timeUs   = replay->cursorUs;
+  uint32_t totalRun = 0;
+  for (uint32_t lookIndex = 0; lookIndex < SIM_REPLAY_WINDOW; ++lookIndex) {
+    record->timeUs = timeUs;
+    uint32_t next  = bus_trace_parse_record(replay->dump, replay->size, offset, record);
+    if (0 == next) { break; }
+    timeUs = record->timeUs;
+    ++totalRun;
+
+    bool isRecordWrite = record->flags & BUS_TRACE_WRITE;
+    if (isRecordWrite == isWrite && record->reg == reg) {
+      // the records in between were not replayed, their values still count
+      uint32_t       skipOffset = replay->cursor;
+      BusTraceRecord skipped;
+      skipped.timeUs = replay->cursorUs;
+      for (uint32_t skipIndex = 0; skipIndex + 1 < totalRun; ++skipIndex) {
+        skipOffset = bus_trace_parse_record(replay->dump, replay->size, skipOffset, &skipped);
+        sim_replay_apply(replay, &skipped);
+      }
+      replay->missing += totalRun - 1;
+      replay->cursor   = next;
+      replay->cursorUs = timeUs;
+      ++replay->matched;
+      sim_replay_apply(replay, record);
+      return true;
+    }
+    offset = next;
+  }
+  ++replay->extra;
+  return false;
+}
+
+static void sim_replay_begin_read(SimReplay* replay) {
+  replay->served    = 0;
+  replay->hasRecord = sim_replay_take(replay, false, replay->pointer, &replay->record);
+}
+
+static uint8_t sim_replay_read_byte(SimReplay* replay) {
+  uint8_t data;
+  if (replay->hasRecord && replay->served < replay->record.length) {
+    data = replay->record.data[replay->served];
+  } else {
+    data = replay->regs[replay->pointer];
+  }
+  ++replay->served;
+  ++replay->pointer;
+  return data;
+}
+
+static void sim_replay_write_byte(SimReplay* replay, const uint8_t data) {
+  BusTraceRecord record;
+  if (sim_replay_take(replay, true, replay->pointer, &record) && 1 == record.length &&
+      record.data[0] != data) {
+    ++replay->dataMismatch;
+  }
+  replay->regs[replay->pointer] = data;
+}
+
+static void sim_replay_i2c_start(void* context, const bool isRead) {
+  SimReplay* replay = context;
+  replay->isRead    = isRead;
+  if (isRead) {
+    sim_replay_begin_read(replay);
+  } else {
+    replay->expectAddress = true;
+  }
+}
+
+/**
+ * @brief writes come in register address and data pairs like on the bmp280
+ *
+ */
+static bool sim_replay_i2c_write(void* context, const uint8_t data) {
+  SimReplay* replay = context;
+  if (replay->expectAddress) {
+    replay->pointer       = data;
+    replay->expectAddress = false;
+  } else {
+    sim_replay_write_byte(replay, data);
+    replay->expectAddress = true;
+  }
+  return true;
+}
+
+static uint8_t sim_replay_i2c_read(void* context) { return sim_replay_read_byte(context); }
+
+static void sim_replay_i2c_stop(void* context) {
+  SimReplay* replay = context;
+  replay->hasRecord = false;
+}
+
+static void sim_replay_spi_select(void* context, const bool isSelected) {
+  SimReplay* replay     = context;
+  replay->hasRecord     = false;
+  replay->expectAddress = isSelected;
+}
+
+/**
+ * @brief control bytes are decoded like on the bmp280, bit 7 selects a read
+ *
+ */
+static uint8_t sim_replay_spi_transfer(void* context, const uint8_t mosi) {
+  SimReplay* replay = context;
+  if (replay->expectAddress) {
+    replay->isRead        = mosi & 0x80;
+    replay->pointer       = mosi | 0x80;
+    replay->expectAddress = false;
+    if (replay->isRead) { sim_replay_begin_read(replay); }
+    return 0xFF;
+  }
+  if (replay->isRead) { return sim_replay_read_byte(replay); }
+
+  sim_replay_write_byte(replay, mosi);
+  replay->expectAddress = true;
+  return 0xFF;
+}
+
+const SimDeviceOps simReplayOps = {.start    = sim_replay_i2c_start,
+                                   .write    = sim_replay_i2c_write,
+                                   .read     = sim_replay_i2c_read,
+                                   .stop     = sim_replay_i2c_stop,
+                                   .select   = sim_replay_spi_select,
+                                   .transfer = sim_replay_spi_transfer};
+
+bool sim_replay_init(SimReplay* replay, const uint8_t* dump, const uint32_t size) {
+  BusTraceHeader header;
+  memset(replay, 0, sizeof(*replay));
+  if (!bus_trace_parse_header(dump, size, &header)) { return false; }
+  replay->dump     = dump;
+  replay->size     = size;
+  replay->cursor   = BUS_TRACE_HEADER_SIZE;
+  replay->cursorUs = header.firstUs;
+  return true;
+}
+
+bool sim_replay_is_done(const SimReplay* replay) { return replay->cursor >= replay->size; }
@@ -0,0 +1,52 @@
+/**
+ * @brief virtual device answering register reads from a captured bus trace, see Bus_Trace.h
+ *
+ * Each read or write the driver starts is matched with the next record of the same direction and
+ * register in the trace, records passed over on the way count as missing. A read is answered
+ * with the bytes of its record, so the driver sees the same status and data bytes as in the field
+ * and takes the same branches. Transfers with no record within SIM_REPLAY_WINDOW records count as
+ * extra and are answered from the last values the trace held for those registers
+ *
+ * @file Sim_Replay.h
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#ifndef _SIM_REPLAY_H
+#define _SIM_REPLAY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "host/sim/Sim_TM4C.h"
+#include "include/Bus_Trace.h"
+
+#define SIM_REPLAY_WINDOW 8  // records looked ahead for a match
+
+typedef struct {
+  const uint8_t* dump;
+  uint32_t       size;
+  uint32_t       cursor;     // offset of the next record not matched yet
+  uint32_t       cursorUs;   // time of the record before the cursor
+  uint8_t        regs[256];  // last value the trace held for each register
+
+  BusTraceRecord record;  // record answering the current read
+  bool           hasRecord;
+  uint8_t        served;  // bytes of the current read so far
+  bool           isRead;
+  bool           expectAddress;
+  uint8_t        pointer;
+
+  uint32_t matched;
+  uint32_t missing;       // records the driver didn't replay
+  uint32_t extra;         // transfers that have no record
+  uint32_t dataMismatch;  // matched writes with a different value
+} SimReplay;
+
+extern const SimDeviceOps simReplayOps;
+
+// dump must stay valid while the device is attached, false if it isn't a trace
+bool sim_replay_init(SimReplay* replay, const uint8_t* dump, const uint32_t size);
+bool sim_replay_is_done(const SimReplay* replay);  // every record was matched or passed over
+
+#endif
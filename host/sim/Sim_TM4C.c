@@ -0,0 +1,568 @@
+/**
+ * @brief host model of the TM4C123 peripherals used by the drivers
+ *
+ * @file Sim_TM4C.c
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#include "host/sim/Sim_TM4C.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "external/TivaC_Utils/include/tm4c123gh6pm.h"
+
+#define SIM_NO_PENDING_REG SIM_REG_COUNT
+
+#define SIM_I2C_SCL_LP 6
+#define SIM_I2C_SCL_HP 4
+#define SIM_I2C_ADDR_BIT 10  // start condition, address byte and ack
+#define SIM_I2C_DATA_BIT 9   // data byte and ack
+#define SIM_I2C_STOP_BIT 1
+#define SIM_I2C_SCL_PIN 0x04  // PB2
+#define SIM_I2C_SDA_PIN 0x08  // PB3
+
+#define SIM_SSI_FIFO_DEPTH 8
+#define SIM_SSI_DR_TAG 0x5A5A0000  // never written by the driver, used to tell reads from writes
+#define SIM_SSI_CS_PIN 0x08        // PA3
+
+#define SIM_DEMCR_TRCENA 0x01000000
+#define SIM_DWT_CYCCNTENA 0x00000001
+
+#define SIM_EEPROM_WORD_PER_BLOCK 16
+#define SIM_NS_PER_S 1000000000ULL
+
+typedef struct {
+  const SimDeviceOps* ops;
+  void*               device;
+  uint8_t             address;
+} SimI2cSlot;
+
+static volatile uint32_t simRegs[SIM_REG_COUNT];
+static uint32_t          simPublished[SIM_REG_COUNT];
+static SimReg            simPendingReg = SIM_NO_PENDING_REG;
+static uint64_t          simClockNs;
+static uint64_t          simRegAccessCount;
+
+static struct {
+  SimI2cSlot  slots[SIM_I2C0_MAX_DEVICE];
+  uint8_t     totalSlot;
+  SimI2cSlot* active;
+  bool        isOpen;
+  bool        isRead;
+  bool        isError;
+  bool        isAdrNack;
+  bool        isDataNack;
+  bool        isArbLost;
+  uint64_t    busyUntilNs;
+  uint8_t     sdaHoldPulse;  // SCL pulses until the stuck slave lets go of SDA
+  bool        isSclHigh;     // SCL level while PB2 is a GPIO
+  uint32_t    totalOp;       // commands run, counts the operations of the faults
+} simI2c0;
+
+static struct {
+  const SimDeviceOps* ops;
+  void*               device;
+  bool                isSelected;
+  uint8_t             tx[SIM_SSI_FIFO_DEPTH];
+  uint8_t             txHead;
+  uint8_t             txCount;
+  uint8_t             rx[SIM_SSI_FIFO_DEPTH];
+  uint8_t             rxHead;
+  uint8_t             rxCount;
+  bool                isShifting;
+  uint8_t             shiftData;
+  uint64_t            frameDoneNs;
+  uint32_t            frameCorrupt;  // xored into the miso of the frame being shifted
+  uint32_t            totalOp;       // frames started
+} simSsi0;
+
+static struct {
+  SimFault fault;
+  uint32_t armedOp;  // operation count of the bus when the fault was injected
+} simFaults[SIM_MAX_FAULT];
+static uint8_t  simTotalFault;
+static uint32_t simFaultHitCount;
+
+static struct {
+  bool     isInitialized;  // the EEPROM starts out erased and keeps its content across resets
+  uint32_t word[SIM_EEPROM_TOTAL_WORD];
+  uint64_t busyUntilNs;
+} simEeprom;
+
+/**
+ * @brief time of one SCL period from the I2C0 timer period register
+ *
+ */
+static uint64_t sim_i2c0_bit_ns(void) {
+  uint64_t tpr = (simRegs[SIM_I2C0_MTPR] & I2C_MTPR_TPR_M) >> I2C_MTPR_TPR_S;
+  return (2 * (1 + tpr) * (SIM_I2C_SCL_LP + SIM_I2C_SCL_HP) * SIM_NS_PER_S) / SIM_CPU_CLOCK_HZ;
+}
+
+/**
+ * @brief SysTick counts down from the reload value on every cpu clock
+ *
+ */
+static uint32_t sim_systick_current(void) {
+  if (!(simRegs[SIM_NVIC_ST_CTRL] & NVIC_ST_CTRL_ENABLE)) { return simRegs[SIM_NVIC_ST_CURRENT]; }
+  uint64_t period = (uint64_t)(simRegs[SIM_NVIC_ST_RELOAD] & NVIC_ST_RELOAD_M) + 1;
+  uint64_t tick   = (simClockNs * (SIM_CPU_CLOCK_HZ / 1000000)) / 1000;
+  return (uint32_t)(period - 1 - (tick % period));
+}
+
+/**
+ * @brief DWT counts cpu cycles while both the trace block and the counter are enabled
+ *
+ */
+static uint32_t sim_dwt_cyccnt(void) {
+  bool isTracing = simRegs[SIM_CORE_DEMCR] & SIM_DEMCR_TRCENA;
+  bool isCounting = simRegs[SIM_DWT_CTRL] & SIM_DWT_CYCCNTENA;
+  if (!isTracing || !isCounting) { return simRegs[SIM_DWT_CYCCNT]; }
+  return (uint32_t)((simClockNs * (SIM_CPU_CLOCK_HZ / 1000000)) / 1000);
+}
+
+static SimI2cSlot* sim_i2c0_find(const uint8_t address) {
+  for (uint8_t slotIndex = 0; slotIndex < simI2c0.totalSlot; ++slotIndex) {
+    if (simI2c0.slots[slotIndex].address == address) { return &simI2c0.slots[slotIndex]; }
+  }
+  return NULL;
+}
+
+static bool sim_fault_is_ssi(const SimFaultType type) {
+  return SIM_FAULT_SSI_STUCK_BUSY == type || SIM_FAULT_SSI_CORRUPT == type;
+}
+
+/**
+ * @brief whether a fault of the given type covers operation op of its bus
+ * @param param return the param of the fault, can be NULL
+ */
+static bool sim_fault_hit(const SimFaultType type, const uint32_t op, uint32_t* param) {
+  for (uint8_t faultIndex = 0; faultIndex < simTotalFault; ++faultIndex) {
+    const SimFault* fault   = &simFaults[faultIndex].fault;
+    uint32_t        startOp = simFaults[faultIndex].armedOp + fault->afterOp;
+    if (type != fault->type || op < startOp) { continue; }
+    if (SIM_FAULT_I2C_SDA_LOW == type && op != startOp) { continue; }
+    if (0 != fault->totalOp && op - startOp >= fault->totalOp) { continue; }
+
+    if (NULL != param) { *param = fault->param; }
+    ++simFaultHitCount;
+    return true;
+  }
+  return false;
+}
+
+/**
+ * @brief run one command written to I2C0_MCS, the controller stays busy for as long as the bits
+ * take on the bus
+ *
+ */
+static void sim_i2c0_command(const uint32_t command) {
+  bool isClocked = simRegs[SIM_SYSCTL_RCGCI2C] & SYSCTL_RCGCI2C_R0;
+  if (!isClocked || !(simRegs[SIM_I2C0_MCR] & I2C_MCR_MFE)) { return; }
+
+  uint64_t startNs    = (simClockNs > simI2c0.busyUntilNs) ? simClockNs : simI2c0.busyUntilNs;
+  uint32_t totalBit   = 0;
+  uint32_t op         = simI2c0.totalOp++;
+  uint32_t faultParam = 0;
+
+  simI2c0.isError    = false;
+  simI2c0.isAdrNack  = false;
+  simI2c0.isDataNack = false;
+  simI2c0.isArbLost  = false;
+
+  if (sim_fault_hit(SIM_FAULT_I2C_SDA_LOW, op, &faultParam)) {
+    simI2c0.sdaHoldPulse = (faultParam > UINT8_MAX) ? UINT8_MAX : (uint8_t)faultParam;
+  }
+
+  // with SDA held low the controller loses arbitration on the first bit it sends
+  if (simI2c0.sdaHoldPulse > 0 || sim_fault_hit(SIM_FAULT_I2C_ARB_LOST, op, NULL)) {
+    simI2c0.isError     = true;
+    simI2c0.isArbLost   = true;
+    simI2c0.isOpen      = false;
+    simI2c0.busyUntilNs = startNs + sim_i2c0_bit_ns();
+    return;
+  }
+
+  if (command & I2C_MCS_START) {
+    simI2c0.isRead = simRegs[SIM_I2C0_MSA] & I2C_MSA_RS;
+    simI2c0.active = sim_i2c0_find((simRegs[SIM_I2C0_MSA] & I2C_MSA_SA_M) >> I2C_MSA_SA_S);
+    simI2c0.isOpen = true;
+    totalBit += SIM_I2C_ADDR_BIT;
+
+    if (NULL == simI2c0.active || sim_fault_hit(SIM_FAULT_I2C_ADDR_NACK, op, NULL)) {
+      simI2c0.isError   = true;
+      simI2c0.isAdrNack = true;
+    } else {
+      simI2c0.active->ops->start(simI2c0.active->device, simI2c0.isRead);
+    }
+  }
+
+  if ((command & I2C_MCS_RUN) && simI2c0.isOpen && !simI2c0.isError && simI2c0.active) {
+    void*   device = simI2c0.active->device;
+    uint8_t data   = (simRegs[SIM_I2C0_MDR] & I2C_MDR_DATA_M) >> I2C_MDR_DATA_S;
+    if (simI2c0.isRead) {
+      simRegs[SIM_I2C0_MDR] = simI2c0.active->ops->read(device);
+      if (sim_fault_hit(SIM_FAULT_I2C_CORRUPT, op, &faultParam)) {
+        simRegs[SIM_I2C0_MDR] ^= faultParam & I2C_MDR_DATA_M;
+      }
+    } else if (false == simI2c0.active->ops->write(device, data) ||
+               sim_fault_hit(SIM_FAULT_I2C_DATA_NACK, op, NULL)) {
+      simI2c0.isError    = true;
+      simI2c0.isDataNack = true;
+    }
+    totalBit += SIM_I2C_DATA_BIT;
+  }
+
+  if ((command & I2C_MCS_STOP) && simI2c0.isOpen) {
+    if (simI2c0.active) { simI2c0.active->ops->stop(simI2c0.active->device); }
+    simI2c0.isOpen = false;
+    totalBit += SIM_I2C_STOP_BIT;
+  }
+
+  simI2c0.busyUntilNs = startNs + totalBit * sim_i2c0_bit_ns();
+  if (sim_fault_hit(SIM_FAULT_I2C_STUCK_BUSY, op, &faultParam)) {
+    simI2c0.busyUntilNs += (uint64_t)faultParam * 1000;
+  }
+}
+
+static uint32_t sim_i2c0_status(void) {
+  uint32_t status = 0;
+  bool     isBusy = simClockNs < simI2c0.busyUntilNs;
+
+  if (isBusy) {
+    status |= I2C_MCS_BUSY;
+  } else {
+    if (simI2c0.isError) { status |= I2C_MCS_ERROR; }
+    if (simI2c0.isAdrNack) { status |= I2C_MCS_ADRACK; }
+    if (simI2c0.isDataNack) { status |= I2C_MCS_DATACK; }
+    if (simI2c0.isArbLost) { status |= I2C_MCS_ARBLST; }
+  }
+
+  // BUSBSY or IDLE is always set so a status can never be mistaken for a written command
+  status |= (isBusy || simI2c0.isOpen) ? I2C_MCS_BUSBSY : I2C_MCS_IDLE;
+  return status;
+}
+
+static uint64_t sim_ssi0_bit_ns(void) {
+  uint64_t cpsdvsr = (simRegs[SIM_SSI0_CPSR] & SSI_CPSR_CPSDVSR_M) >> SSI_CPSR_CPSDVSR_S;
+  uint64_t scr     = (simRegs[SIM_SSI0_CR0] & SSI_CR0_SCR_M) >> SSI_CR0_SCR_S;
+  if (cpsdvsr < 2) { cpsdvsr = 2; }
+  return (cpsdvsr * (1 + scr) * SIM_NS_PER_S) / SIM_CPU_CLOCK_HZ;
+}
+
+static void sim_ssi0_start_frame(const uint64_t startNs) {
+  bool isClocked = simRegs[SIM_SYSCTL_RCGCSSI] & SYSCTL_RCGCSSI_R0;
+  if (!isClocked || !(simRegs[SIM_SSI0_CR1] & SSI_CR1_SSE) || 0 == simSsi0.txCount) { return; }
+  uint64_t frameBit = (simRegs[SIM_SSI0_CR0] & SSI_CR0_DSS_M) + 1;
+
+  uint32_t op         = simSsi0.totalOp++;
+  uint32_t faultParam = 0;
+
+  simSsi0.shiftData    = simSsi0.tx[simSsi0.txHead];
+  simSsi0.txHead       = (simSsi0.txHead + 1) % SIM_SSI_FIFO_DEPTH;
+  simSsi0.txCount      = simSsi0.txCount - 1;
+  simSsi0.isShifting   = true;
+  simSsi0.frameDoneNs  = startNs + frameBit * sim_ssi0_bit_ns();
+  simSsi0.frameCorrupt = 0;
+  if (sim_fault_hit(SIM_FAULT_SSI_STUCK_BUSY, op, &faultParam)) {
+    simSsi0.frameDoneNs += (uint64_t)faultParam * 1000;
+  }
+  if (sim_fault_hit(SIM_FAULT_SSI_CORRUPT, op, &faultParam)) { simSsi0.frameCorrupt = faultParam; }
+}
+
+/**
+ * @brief finish every frame whose time has passed and start the next one from the tx fifo
+ *
+ */
+static void sim_ssi0_advance(void) {
+  while (simSsi0.isShifting && simClockNs >= simSsi0.frameDoneNs) {
+    uint8_t miso = 0xFF;
+    if (simRegs[SIM_SSI0_CR1] & SSI_CR1_LBM) {
+      miso = simSsi0.shiftData;
+    } else if (simSsi0.ops && simSsi0.isSelected) {
+      miso = simSsi0.ops->transfer(simSsi0.device, simSsi0.shiftData);
+    }
+    miso ^= (uint8_t)simSsi0.frameCorrupt;
+
+    if (simSsi0.rxCount < SIM_SSI_FIFO_DEPTH) {
+      simSsi0.rx[(simSsi0.rxHead + simSsi0.rxCount) % SIM_SSI_FIFO_DEPTH] = miso;
+      simSsi0.rxCount = simSsi0.rxCount + 1;
+    }
+    simSsi0.isShifting = false;
+    sim_ssi0_start_frame(simSsi0.frameDoneNs);
+  }
+  if (false == simSsi0.isShifting) { sim_ssi0_start_frame(simClockNs); }
+}
+
+static uint32_t sim_ssi0_status(void) {
+  uint32_t status = 0;
+  if (simSsi0.isShifting || simSsi0.txCount > 0) { status |= SSI_SR_BSY; }
+  if (SIM_SSI_FIFO_DEPTH == simSsi0.rxCount) { status |= SSI_SR_RFF; }
+  if (simSsi0.rxCount > 0) { status |= SSI_SR_RNE; }
+  if (simSsi0.txCount < SIM_SSI_FIFO_DEPTH) { status |= SSI_SR_TNF; }
+  if (0 == simSsi0.txCount) { status |= SSI_SR_TFE; }
+  return status;
+}
+
+static void sim_ssi0_data_access(const bool isWrite, const uint32_t data) {
+  if (isWrite) {
+    if (simSsi0.txCount < SIM_SSI_FIFO_DEPTH) {
+      simSsi0.tx[(simSsi0.txHead + simSsi0.txCount) % SIM_SSI_FIFO_DEPTH] = (uint8_t)data;
+      simSsi0.txCount = simSsi0.txCount + 1;
+    }
+    sim_ssi0_advance();
+  } else if (simSsi0.rxCount > 0) {
+    simSsi0.rxHead  = (simSsi0.rxHead + 1) % SIM_SSI_FIFO_DEPTH;
+    simSsi0.rxCount = simSsi0.rxCount - 1;
+  }
+}
+
+static void sim_gpioa_write(const uint32_t data) {
+  bool isSelected = !(data & SIM_SSI_CS_PIN);
+  if (isSelected != simSsi0.isSelected) {
+    simSsi0.isSelected = isSelected;
+    if (simSsi0.ops) { simSsi0.ops->select(simSsi0.device, isSelected); }
+  }
+}
+
+/**
+ * @brief level of the I2C lines while PB2/PB3 are GPIO, an open drain pin is low only when it is
+ * an output driving 0 or when a slave pulls it down
+ *
+ */
+static bool sim_gpiob_is_high(const uint32_t pin) {
+  bool isDrivenLow = (simRegs[SIM_GPIO_PORTB_DIR] & pin) && !(simRegs[SIM_GPIO_PORTB_DATA] & pin);
+  if (SIM_I2C_SDA_PIN == pin && simI2c0.sdaHoldPulse > 0) { return false; }
+  return !isDrivenLow;
+}
+
+/**
+ * @brief a rising edge on SCL clocks one bit out of a slave stuck holding SDA
+ *
+ */
+static void sim_gpiob_write(void) {
+  if (simRegs[SIM_GPIO_PORTB_AFSEL] & SIM_I2C_SCL_PIN) { return; }
+  bool isSclHigh = sim_gpiob_is_high(SIM_I2C_SCL_PIN);
+  if (isSclHigh && !simI2c0.isSclHigh && simI2c0.sdaHoldPulse > 0) { --simI2c0.sdaHoldPulse; }
+  simI2c0.isSclHigh = isSclHigh;
+}
+
+/**
+ * @brief inputs read the line level, outputs read back what was written
+ *
+ */
+static uint32_t sim_gpiob_data(void) {
+  uint32_t data = simRegs[SIM_GPIO_PORTB_DATA];
+  for (uint32_t pin = SIM_I2C_SCL_PIN; pin <= SIM_I2C_SDA_PIN; pin <<= 1) {
+    if (simRegs[SIM_GPIO_PORTB_DIR] & pin) { continue; }
+    data = sim_gpiob_is_high(pin) ? (data | pin) : (data & ~pin);
+  }
+  return data;
+}
+
+static uint32_t sim_eeprom_index(void) {
+  return simRegs[SIM_EEPROM_EEBLOCK] * SIM_EEPROM_WORD_PER_BLOCK +
+         (simRegs[SIM_EEPROM_EEOFFSET] % SIM_EEPROM_WORD_PER_BLOCK);
+}
+
+static void sim_eeprom_data_access(const SimReg reg, const bool isWrite) {
+  uint32_t wordIndex = sim_eeprom_index();
+  if (isWrite && wordIndex < SIM_EEPROM_TOTAL_WORD) {
+    simEeprom.word[wordIndex] = simRegs[reg];
+    simEeprom.busyUntilNs     = simClockNs + SIM_EEPROM_PROGRAM_NS;
+  }
+  if (SIM_EEPROM_EERDWRINC == reg) {
+    simRegs[SIM_EEPROM_EEOFFSET] = (simRegs[SIM_EEPROM_EEOFFSET] + 1) % SIM_EEPROM_WORD_PER_BLOCK;
+  }
+}
+
+/**
+ * @brief apply the last access to a register with side effects, a written register no longer
+ * holds the value that was published for it
+ *
+ */
+static void sim_settle_pending(void) {
+  SimReg reg    = simPendingReg;
+  simPendingReg = SIM_NO_PENDING_REG;
+  if (SIM_NO_PENDING_REG == reg) { return; }
+
+  bool isWrite = simRegs[reg] != simPublished[reg];
+  switch (reg) {
+    case SIM_I2C0_MCS:
+      if (isWrite) { sim_i2c0_command(simRegs[reg]); }
+      break;
+
+    case SIM_SSI0_DR:
+      sim_ssi0_data_access(isWrite, simRegs[reg]);
+      break;
+
+    case SIM_GPIO_PORTA_DATA:
+      if (isWrite) { sim_gpioa_write(simRegs[reg]); }
+      break;
+
+    case SIM_GPIO_PORTB_DATA:
+    case SIM_GPIO_PORTB_DIR:
+      if (isWrite) { sim_gpiob_write(); }
+      break;
+
+    case SIM_EEPROM_EERDWR:
+    case SIM_EEPROM_EERDWRINC:
+      sim_eeprom_data_access(reg, isWrite);
+      break;
+
+    default:
+      break;
+  }
+}
+
+static void sim_publish(const SimReg reg, const uint32_t value) {
+  simRegs[reg]      = value;
+  simPublished[reg] = value;
+  simPendingReg     = reg;
+}
+
+/**
+ * @brief entry point of every register access made by the drivers
+ *
+ */
+volatile uint32_t* sim_reg(const SimReg reg) {
+  simClockNs += SIM_REG_ACCESS_NS;
+  ++simRegAccessCount;
+  sim_settle_pending();
+  sim_ssi0_advance();
+
+  switch (reg) {
+    case SIM_I2C0_MCS:
+      sim_publish(reg, sim_i2c0_status());
+      break;
+
+    case SIM_SSI0_DR:
+      sim_publish(reg, SIM_SSI_DR_TAG | (simSsi0.rxCount ? simSsi0.rx[simSsi0.rxHead] : 0));
+      break;
+
+    case SIM_SSI0_SR:
+      simRegs[reg] = sim_ssi0_status();
+      break;
+
+    case SIM_GPIO_PORTA_DATA:
+    case SIM_GPIO_PORTB_DIR:
+      sim_publish(reg, simRegs[reg]);
+      break;
+
+    case SIM_GPIO_PORTB_DATA:
+      sim_publish(reg, sim_gpiob_data());
+      break;
+
+    case SIM_EEPROM_EERDWR:
+    case SIM_EEPROM_EERDWRINC: {
+      uint32_t wordIndex = sim_eeprom_index();
+      sim_publish(reg, (wordIndex < SIM_EEPROM_TOTAL_WORD) ? simEeprom.word[wordIndex] : 0);
+      break;
+    }
+
+    case SIM_NVIC_ST_CURRENT:
+      simRegs[reg] = sim_systick_current();
+      break;
+
+    case SIM_DWT_CYCCNT:
+      simRegs[reg] = sim_dwt_cyccnt();
+      break;
+
+    case SIM_EEPROM_EEDONE:
+      simRegs[reg] = (simClockNs < simEeprom.busyUntilNs) ? EEPROM_EEDONE_WORKING : 0;
+      break;
+
+    default:
+      break;
+  }
+  return &simRegs[reg];
+}
+
+void sim_tm4c_reset(void) {
+  memset((void*)simRegs, 0, sizeof(simRegs));
+  memset(simPublished, 0, sizeof(simPublished));
+  memset(&simI2c0, 0, sizeof(simI2c0));
+  memset(&simSsi0, 0, sizeof(simSsi0));
+  simPendingReg         = SIM_NO_PENDING_REG;
+  simClockNs            = 0;
+  simRegAccessCount     = 0;
+  simEeprom.busyUntilNs = 0;
+  if (false == simEeprom.isInitialized) { sim_eeprom_erase(); }
+  sim_fault_clear();
+
+  // every peripheral reports ready as soon as it is clocked
+  simRegs[SIM_SYSCTL_PRGPIO]   = 0xFFFFFFFF;
+  simRegs[SIM_SYSCTL_PRI2C]    = 0xFFFFFFFF;
+  simRegs[SIM_SYSCTL_PRSSI]    = 0xFFFFFFFF;
+  simRegs[SIM_SYSCTL_PREEPROM] = 0xFFFFFFFF;
+  simRegs[SIM_EEPROM_EESIZE] =
+      ((SIM_EEPROM_TOTAL_WORD / SIM_EEPROM_WORD_PER_BLOCK) << EEPROM_EESIZE_BLKCNT_S) |
+      SIM_EEPROM_TOTAL_WORD;
+  simRegs[SIM_I2C0_MTPR] = 0x1;
+  simI2c0.isSclHigh      = true;
+}
+
+void sim_eeprom_erase(void) {
+  memset(simEeprom.word, 0xFF, sizeof(simEeprom.word));
+  simEeprom.isInitialized = true;
+}
+
+void sim_i2c0_attach(const SimDeviceOps* ops, void* device, const uint8_t address) {
+  if (simI2c0.totalSlot >= SIM_I2C0_MAX_DEVICE) { return; }
+  simI2c0.slots[simI2c0.totalSlot].ops     = ops;
+  simI2c0.slots[simI2c0.totalSlot].device  = device;
+  simI2c0.slots[simI2c0.totalSlot].address = address;
+  ++simI2c0.totalSlot;
+}
+
+void sim_ssi0_attach(const SimDeviceOps* ops, void* device) {
+  simSsi0.ops        = ops;
+  simSsi0.device     = device;
+  simSsi0.isSelected = false;
+}
+
+void sim_i2c0_hold_sda(const uint8_t sclPulse) {
+  simI2c0.sdaHoldPulse = sclPulse;
+  simI2c0.isOpen       = false;
+}
+
+uint8_t sim_i2c0_sda_hold_pulse(void) { return simI2c0.sdaHoldPulse; }
+
+bool sim_fault_inject(const SimFault* fault) {
+  if (simTotalFault >= SIM_MAX_FAULT) { return false; }
+  simFaults[simTotalFault].fault   = *fault;
+  simFaults[simTotalFault].armedOp = sim_fault_is_ssi(fault->type) ? simSsi0.totalOp
+                                                                    : simI2c0.totalOp;
+  ++simTotalFault;
+  return true;
+}
+
+void sim_fault_clear(void) {
+  simTotalFault    = 0;
+  simFaultHitCount = 0;
+}
+
+uint32_t sim_fault_hit_count(void) { return simFaultHitCount; }
+
+uint64_t sim_now_ns(void) { return simClockNs; }
+
+uint64_t sim_reg_access_count(void) { return simRegAccessCount; }
+
+static uint32_t sim_time_now_us(void* context) {
+  (void)context;
+  sim_advance_ns(SIM_REG_ACCESS_NS);
+  return (uint32_t)(simClockNs / 1000);
+}
+
+void sim_time_source(TimeSource* source) {
+  source->now_us  = sim_time_now_us;
+  source->context = NULL;
+}
+
+void sim_advance_ns(const uint64_t timeNs) {
+  sim_settle_pending();
+  simClockNs += timeNs;
+  sim_ssi0_advance();
+}
@@ -0,0 +1,165 @@
+/**
+ * @brief host model of the TM4C123 peripherals used by the drivers (I2C0, SSI0, GPIO A/B, SysTick,
+ * DWT and the EEPROM) together with the virtual clock the model runs on
+ *
+ * Registers are plain memory cells, registers with side effects are handled lazily: every access
+ * goes through sim_reg, which first applies the previous access to a side effect register and then
+ * publishes the current status of the register being accessed. Every register access also
+ * advances the virtual clock by SIM_REG_ACCESS_NS so that polling loops take virtual time
+ *
+ * @file Sim_TM4C.h
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#ifndef _SIM_TM4C_H
+#define _SIM_TM4C_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "include/Time_Source.h"
+
+#define SIM_CPU_CLOCK_HZ 16000000
+#define SIM_REG_ACCESS_NS 250  // a register access plus the loop around it, about 4 cpu cycles
+
+#define SIM_I2C0_MAX_DEVICE 8
+#define SIM_MAX_FAULT 8
+#define SIM_EEPROM_TOTAL_WORD 512
+#define SIM_EEPROM_PROGRAM_NS 110000
+
+typedef enum {
+  SIM_SYSCTL_RCGCGPIO,
+  SIM_SYSCTL_RCGCI2C,
+  SIM_SYSCTL_RCGCSSI,
+  SIM_SYSCTL_RCGCEEPROM,
+  SIM_SYSCTL_PRGPIO,
+  SIM_SYSCTL_PRI2C,
+  SIM_SYSCTL_PRSSI,
+  SIM_SYSCTL_PREEPROM,
+  SIM_SYSCTL_SREEPROM,
+
+  SIM_NVIC_ST_CTRL,
+  SIM_NVIC_ST_RELOAD,
+  SIM_NVIC_ST_CURRENT,
+
+  SIM_DWT_CTRL,
+  SIM_DWT_CYCCNT,
+  SIM_CORE_DEMCR,
+
+  SIM_GPIO_PORTA_DATA,
+  SIM_GPIO_PORTA_DIR,
+  SIM_GPIO_PORTA_AFSEL,
+  SIM_GPIO_PORTA_DR8R,
+  SIM_GPIO_PORTA_ODR,
+  SIM_GPIO_PORTA_PUR,
+  SIM_GPIO_PORTA_PDR,
+  SIM_GPIO_PORTA_DEN,
+  SIM_GPIO_PORTA_LOCK,
+  SIM_GPIO_PORTA_CR,
+  SIM_GPIO_PORTA_AMSEL,
+  SIM_GPIO_PORTA_PCTL,
+
+  SIM_GPIO_PORTB_DATA,
+  SIM_GPIO_PORTB_DIR,
+  SIM_GPIO_PORTB_AFSEL,
+  SIM_GPIO_PORTB_ODR,
+  SIM_GPIO_PORTB_PUR,
+  SIM_GPIO_PORTB_PDR,
+  SIM_GPIO_PORTB_DEN,
+  SIM_GPIO_PORTB_LOCK,
+  SIM_GPIO_PORTB_CR,
+  SIM_GPIO_PORTB_AMSEL,
+  SIM_GPIO_PORTB_PCTL,
+
+  SIM_I2C0_MSA,
+  SIM_I2C0_MCS,
+  SIM_I2C0_MDR,
+  SIM_I2C0_MTPR,
+  SIM_I2C0_MCR,
+
+  SIM_SSI0_CR0,
+  SIM_SSI0_CR1,
+  SIM_SSI0_DR,
+  SIM_SSI0_SR,
+  SIM_SSI0_CPSR,
+  SIM_SSI0_CC,
+
+  SIM_EEPROM_EESIZE,
+  SIM_EEPROM_EEBLOCK,
+  SIM_EEPROM_EEOFFSET,
+  SIM_EEPROM_EERDWR,
+  SIM_EEPROM_EERDWRINC,
+  SIM_EEPROM_EEDONE,
+  SIM_EEPROM_EESUPP,
+
+  SIM_REG_COUNT
+} SimReg;
+
+/**
+ * @brief bus side of a simulated device, i2c devices use start/write/read/stop and spi devices use
+ * select/transfer
+ */
+typedef struct {
+  void (*start)(void* device, const bool isRead);  // start or repeated start addressed to device
+  bool (*write)(void* device, const uint8_t data);  // return whether the byte was acked
+  uint8_t (*read)(void* device);
+  void (*stop)(void* device);
+  void (*select)(void* device, const bool isSelected);
+  uint8_t (*transfer)(void* device, const uint8_t mosi);  // one spi frame
+} SimDeviceOps;
+
+/**
+ * @brief faults the bus models can inject, param is read as noted
+ */
+typedef enum {
+  SIM_FAULT_I2C_ADDR_NACK,   // no device acks the address byte
+  SIM_FAULT_I2C_DATA_NACK,   // the device doesn't ack a written byte
+  SIM_FAULT_I2C_ARB_LOST,    // the controller loses arbitration
+  SIM_FAULT_I2C_STUCK_BUSY,  // BUSY stays set for param us longer
+  SIM_FAULT_I2C_SDA_LOW,     // a slave holds SDA low until it sees param SCL pulses, one shot
+  SIM_FAULT_I2C_CORRUPT,     // a byte read from the device is xored with param
+  SIM_FAULT_SSI_STUCK_BUSY,  // a frame keeps BSY set for param us longer
+  SIM_FAULT_SSI_CORRUPT      // a byte received on MISO is xored with param
+} SimFaultType;
+
+/**
+ * @brief one fault of a script, bus operations are commands written to I2C0_MCS or SSI0 frames
+ * counted on the bus of the fault from the time it is injected
+ */
+typedef struct {
+  SimFaultType type;
+  uint32_t     afterOp;  // operations let through before the fault starts
+  uint32_t     totalOp;  // operations hit by the fault, 0 for every one after afterOp
+  uint32_t     param;
+} SimFault;
+
+volatile uint32_t* sim_reg(const SimReg reg);
+
+// put every peripheral back to its power on state and the clock to 0, EEPROM content is kept
+void sim_tm4c_reset(void);
+void sim_eeprom_erase(void);
+
+void sim_i2c0_attach(const SimDeviceOps* ops, void* device, const uint8_t address);
+void sim_ssi0_attach(const SimDeviceOps* ops, void* device);
+
+// a slave keeps SDA low until it has seen sclPulse clocks on SCL, like one caught mid byte by a
+// brownout, every controller command fails with ARBLST meanwhile
+void    sim_i2c0_hold_sda(const uint8_t sclPulse);
+uint8_t sim_i2c0_sda_hold_pulse(void);  // pulses still needed to free SDA
+
+/* Fault injection, a script is a list of faults injected one after the other */
+bool     sim_fault_inject(const SimFault* fault);  // false once SIM_MAX_FAULT are armed
+void     sim_fault_clear(void);                    // sim_tm4c_reset clears them too
+uint32_t sim_fault_hit_count(void);                // operations a fault was applied to
+
+/* Virtual clock */
+uint64_t sim_now_ns(void);
+void     sim_advance_ns(const uint64_t timeNs);
+uint64_t sim_reg_access_count(void);  // register accesses since the last sim_tm4c_reset
+
+// microsecond time source on the virtual clock, every read takes SIM_REG_ACCESS_NS like a
+// register access so that loops polling the time alone still move forward
+void sim_time_source(TimeSource* source);
+
+#endif
@@ -0,0 +1,225 @@
+/**
+ * @brief load test for a bmp280 device daemon: collector processes reading its sensors through
+ * the normal driver API over host/Host_BusSocket.h
+ *
+ * The sensors are split over the processes round robin, each sensor gets its own connection to
+ * the bus it sits on in host/tools/bmp280_simd.c. A process opens its sensors with HandDynamic
+ * settings and the usual open, reset, update_setting, get_calibration_data sequence, then reads
+ * them in turn with bmp280_get_temp_press, at the given rate per sensor or as fast as it can. The
+ * latency of every read goes into a LatencyHist, the processes send theirs to the parent through
+ * a pipe and it prints the combined throughput and latency percentiles
+ *
+ * @code
+ * bmp280_simd -n 256 -w storm /tmp/bmp280.sock &
+ * bmp280_collect /tmp/bmp280.sock 256 8 10
+ * bmp280_collect /tmp/bmp280.sock 256 8 10 25
+ * @endcode
+ *
+ * @file bmp280_collect.c
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "host/Host_BusSocket.h"
+#include "host/Host_TimeSource.h"
+#include "include/BMP280_Drv.h"
+#include "include/BMP280_Utils.h"
+#include "include/Latency_Hist.h"
+
+#define COLLECT_MAX_SENSOR 4096
+#define COLLECT_MAX_PROCESS 256
+#define COLLECT_SENSOR_PER_BUS 2
+#define COLLECT_FIRST_ADDRESS 0x76
+#define COLLECT_RAW_RESET 0x80000
+
+/**
+ * @brief what one process sends back to the parent
+ */
+typedef struct {
+  uint32_t    totalSensor;
+  uint32_t    totalOpenFail;
+  uint64_t    totalSample;
+  uint64_t    totalError;
+  uint64_t    elapsedUs;
+  LatencyHist latency;
+} CollectResult;
+
+static TimeSource hostTime;
+
+static Bmp280ErrCode collect_open(bmp280* sensor, HostBusSocket* socketBus, const uint32_t index) {
+  BMP280_TRY_FUNC(bmp280_create_predefined_settings(sensor, HandDynamic));
+  BMP280_TRY_FUNC(
+      bmp280_init(sensor, I2C, COLLECT_FIRST_ADDRESS + index % COLLECT_SENSOR_PER_BUS));
+  BMP280_TRY_FUNC(bmp280_set_bus(sensor, &socketBus->bus));
+  BMP280_TRY_FUNC(bmp280_set_time_source(sensor, &hostTime));
+  BMP280_TRY_FUNC(bmp280_open(sensor));
+  BMP280_TRY_FUNC(bmp280_reset(sensor));
+  BMP280_TRY_FUNC(bmp280_update_setting(sensor));
+  BMP280_TRY_FUNC(bmp280_get_calibration_data(sensor, NULL));
+
+  // the data registers hold 0x80000 until the first conversion is done
+  int32_t rawTemp = COLLECT_RAW_RESET;
+  int32_t rawPress;
+  while (COLLECT_RAW_RESET == rawTemp) {
+    BMP280_TRY_FUNC(bmp280_get_raw_temp_press(sensor, &rawTemp, &rawPress));
+  }
+  return ERR_NO_ERR;
+}
+
+static void collect_sleep_until_us(const uint32_t deadlineUs) {
+  int32_t remainUs = (int32_t)(deadlineUs - time_source_now_us(&hostTime));
+  if (remainUs <= 0) { return; }
+  struct timespec remain = {.tv_sec  = remainUs / 1000000,
+                            .tv_nsec = (long)(remainUs % 1000000) * 1000};
+  nanosleep(&remain, NULL);
+}
+
+/**
+ * @brief one collector process, sensors processIndex, processIndex + totalProcess ...
+ *
+ */
+static void collect_process(const char*    path,
+                            const uint32_t totalSensor,
+                            const uint32_t processIndex,
+                            const uint32_t totalProcess,
+                            const uint32_t durationUs,
+                            const uint32_t rateHz,
+                            CollectResult* result) {
+  uint32_t       capacity  = (totalSensor + totalProcess - 1) / totalProcess;
+  bmp280*        sensor    = calloc(capacity, sizeof(*sensor));
+  HostBusSocket* socketBus = calloc(capacity, sizeof(*socketBus));
+  uint32_t       totalOpen = 0;
+
+  memset(result, 0, sizeof(*result));
+  latency_hist_reset(&result->latency);
+  for (uint32_t index = processIndex; index < totalSensor; index += totalProcess) {
+    ++result->totalSensor;
+    host_bus_socket_init(&socketBus[totalOpen], path, index / COLLECT_SENSOR_PER_BUS);
+    if (ERR_NO_ERR != collect_open(&sensor[totalOpen], &socketBus[totalOpen], index)) {
+      ++result->totalOpenFail;
+      bmp280_close(&sensor[totalOpen]);
+      continue;
+    }
+    ++totalOpen;
+  }
+
+  uint32_t periodUs = rateHz ? 1000000 / rateHz : 0;
+  uint32_t startUs  = time_source_now_us(&hostTime);
+  uint32_t round    = 0;
+  while (totalOpen > 0 && time_source_now_us(&hostTime) - startUs < durationUs) {
+    for (uint32_t index = 0; index < totalOpen; ++index) {
+      float    temperature;
+      float    pressure;
+      uint32_t readStartUs = time_source_now_us(&hostTime);
+      if (ERR_NO_ERR != bmp280_get_temp_press(&sensor[index], &temperature, &pressure)) {
+        ++result->totalError;
+      }
+      latency_hist_add(&result->latency, time_source_now_us(&hostTime) - readStartUs);
+      ++result->totalSample;
+    }
+    if (periodUs) { collect_sleep_until_us(startUs + ++round * periodUs); }
+  }
+  result->elapsedUs = time_source_now_us(&hostTime) - startUs;
+
+  for (uint32_t index = 0; index < totalOpen; ++index) { bmp280_close(&sensor[index]); }
+  free(sensor);
+  free(socketBus);
+}
+
+static int collect_run(const char*    path,
+                       const uint32_t totalSensor,
+                       const uint32_t totalProcess,
+                       const uint32_t durationUs,
+                       const uint32_t rateHz) {
+  int resultPipe[2];
+  if (0 != pipe(resultPipe)) {
+    perror("pipe");
+    return 1;
+  }
+  fflush(stdout);
+  for (uint32_t processIndex = 0; processIndex < totalProcess; ++processIndex) {
+    pid_t pid = fork();
+    if (pid < 0) {
+      perror("fork");
+      return 1;
+    }
+    if (0 == pid) {
+      CollectResult result;
+      close(resultPipe[0]);
+      collect_process(path, totalSensor, processIndex, totalProcess, durationUs, rateHz, &result);
+      // smaller than PIPE_BUF, so the results of the processes don't interleave
+      bool isSent = sizeof(result) == (size_t)write(resultPipe[1], &result, sizeof(result));
+      _exit(isSent ? 0 : 1);
+    }
+  }
+  close(resultPipe[1]);
+
+  CollectResult total;
+  CollectResult result;
+  uint32_t      totalReport = 0;
+  memset(&total, 0, sizeof(total));
+  latency_hist_reset(&total.latency);
+  while (sizeof(result) == (size_t)read(resultPipe[0], &result, sizeof(result))) {
+    total.totalSensor += result.totalSensor;
+    total.totalOpenFail += result.totalOpenFail;
+    total.totalSample += result.totalSample;
+    total.totalError += result.totalError;
+    if (result.elapsedUs > total.elapsedUs) { total.elapsedUs = result.elapsedUs; }
+    latency_hist_merge(&total.latency, &result.latency);
+    ++totalReport;
+  }
+  close(resultPipe[0]);
+  while (wait(NULL) > 0) {}
+
+  printf("%u sensors, %u processes", total.totalSensor, totalReport);
+  if (rateHz) {
+    printf(", %u Hz per sensor\n", rateHz);
+  } else {
+    printf(", as fast as possible\n");
+  }
+  printf("  %.0f samples/s, %llu samples, %llu failed reads, %u sensors failed to open\n",
+         total.elapsedUs ? total.totalSample * 1e6 / total.elapsedUs : 0.0,
+         (unsigned long long)total.totalSample,
+         (unsigned long long)total.totalError,
+         total.totalOpenFail);
+  printf("  read latency p50 <= %u us, p90 <= %u us, p99 <= %u us, max %u us\n",
+         latency_hist_percentile_us(&total.latency, 50),
+         latency_hist_percentile_us(&total.latency, 90),
+         latency_hist_percentile_us(&total.latency, 99),
+         total.latency.maxUs);
+  bool isClean = totalReport == totalProcess && 0 == total.totalError && 0 == total.totalOpenFail;
+  return isClean ? 0 : 2;
+}
+
+int main(int argc, char** argv) {
+  if (5 == argc || 6 == argc) {
+    int totalSensor  = atoi(argv[2]);
+    int totalProcess = atoi(argv[3]);
+    int durationS    = atoi(argv[4]);
+    int rateHz       = (6 == argc) ? atoi(argv[5]) : 0;
+    if (totalSensor > 0 && totalSensor <= COLLECT_MAX_SENSOR && totalProcess > 0 &&
+        totalProcess <= COLLECT_MAX_PROCESS && durationS > 0 && durationS <= 3600 && rateHz >= 0 &&
+        rateHz <= 1000000) {
+      host_time_source_monotonic(&hostTime);
+      return collect_run(argv[1],
+                         (uint32_t)totalSensor,
+                         (uint32_t)totalProcess,
+                         (uint32_t)durationS * 1000000,
+                         (uint32_t)rateHz);
+    }
+  }
+
+  printf("usage: %s <socket path> <sensors, up to %d> <processes, up to %d> <seconds> "
+         "[reads per second per sensor, as fast as possible by default]\n",
+         argv[0],
+         COLLECT_MAX_SENSOR,
+         COLLECT_MAX_PROCESS);
+  return 1;
+}
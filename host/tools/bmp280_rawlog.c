@@ -0,0 +1,184 @@
+/**
+ * @brief write and read packed raw sample logs, see BMP280_RawLog.h
+ *
+ * capture logs forced mode samples of the simulated bmp280, one per second with a 1 ms tick, and
+ * checks that the log decodes to the values bmp280_get_temp_press returned for the same samples.
+ * decode recompensates a log, e.g. one pulled from a logger's flash, and prints it as CSV
+ *
+ * @code
+ * bmp280_rawlog capture raw.log 3600
+ * bmp280_rawlog decode raw.log
+ * @endcode
+ *
+ * @file bmp280_rawlog.c
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "host/sim/Sim_BMP280.h"
+#include "host/sim/Sim_TM4C.h"
+#include "include/BMP280_Drv.h"
+#include "include/BMP280_RawLog.h"
+#include "include/BMP280_Utils.h"
+
+#define RAWLOG_I2C_ADDR 0x77
+#define RAWLOG_PERIOD_NS 1000000000ULL
+#define RAWLOG_TICK_US 1000
+#define RAWLOG_DEFAULT_SAMPLE 3600
+#define RAWLOG_MAX_SAMPLE 100000
+#define RAWLOG_FLOAT_RECORD 12  // two floats and a u32 timestamp
+
+static SimBmp280 simSensor;
+static uint8_t   rawLog[BMP280_RAW_LOG_HEADER_SIZE + RAWLOG_MAX_SAMPLE * BMP280_RAW_LOG_MAX_RECORD];
+static float     driverTemperature[RAWLOG_MAX_SAMPLE];
+static float     driverPressure[RAWLOG_MAX_SAMPLE];
+static uint32_t  driverTimeUs[RAWLOG_MAX_SAMPLE];
+
+// a front passing over the node: a slow pressure swing and a daily temperature cycle
+static double rawlog_temperature(void* context, const uint64_t timeNs) {
+  (void)context;
+  return 15.0 + 8.0 * sin((double)timeNs * 1e-9 * 2 * M_PI / 86400);
+}
+
+static double rawlog_pressure(void* context, const uint64_t timeNs) {
+  (void)context;
+  return 100800.0 + 900.0 * sin((double)timeNs * 1e-9 * 2 * M_PI / 21600);
+}
+
+static uint32_t rawlog_load(const char* path) {
+  FILE* file = fopen(path, "rb");
+  if (NULL == file) { return 0; }
+  uint32_t size = (uint32_t)fread(rawLog, 1, sizeof(rawLog), file);
+  fclose(file);
+  return size;
+}
+
+static Bmp280ErrCode rawlog_sample(bmp280* sensor, Bmp280RawSample* sample, const int index) {
+  // a forced conversion, the data registers keep it until the next trigger
+  BMP280_TRY_FUNC(bmp280_update_setting(sensor));
+  sim_advance_ns((uint64_t)bmp280_measure_time_us(sensor) * 1000);
+  BMP280_TRY_FUNC(bmp280_get_raw_temp_press(sensor, &sample->rawTemp, &sample->rawPress));
+  BMP280_TRY_FUNC(bmp280_get_sample_time(sensor, &sample->timeUs, NULL));
+  BMP280_TRY_FUNC(
+      bmp280_get_temp_press(sensor, &driverTemperature[index], &driverPressure[index]));
+  driverTimeUs[index] = sample->timeUs;
+  return ERR_NO_ERR;
+}
+
+static int rawlog_capture(const char* path, const int totalSample) {
+  bmp280              sensor;
+  TimeSource          timeSource;
+  Bmp280RawLogEncoder encoder;
+  Bmp280RawSample     sample;
+
+  sim_tm4c_reset();
+  sim_bmp280_init(&simSensor);
+  simSensor.waveform.temperatureC = rawlog_temperature;
+  simSensor.waveform.pressurePa   = rawlog_pressure;
+  sim_bmp280_attach_i2c(&simSensor, RAWLOG_I2C_ADDR);
+  sim_time_source(&timeSource);
+
+  Bmp280ErrCode errCode = bmp280_create_predefined_settings(&sensor, WeatherStat);
+  if (ERR_NO_ERR == errCode) { errCode = bmp280_init(&sensor, I2C, RAWLOG_I2C_ADDR); }
+  if (ERR_NO_ERR == errCode) { errCode = bmp280_set_time_source(&sensor, &timeSource); }
+  if (ERR_NO_ERR == errCode) { errCode = bmp280_open(&sensor); }
+  if (ERR_NO_ERR == errCode) { errCode = bmp280_reset(&sensor); }
+  if (ERR_NO_ERR == errCode) { errCode = bmp280_get_calibration_data(&sensor, NULL); }
+
+  uint32_t size = BMP280_RAW_LOG_HEADER_SIZE;
+  bmp280_raw_log_start(
+      &encoder, &sensor.calibParam, time_source_now_us(&timeSource), RAWLOG_TICK_US, rawLog);
+  for (int sampleIndex = 0; ERR_NO_ERR == errCode && sampleIndex < totalSample; ++sampleIndex) {
+    uint64_t periodStartNs = sim_now_ns();
+    errCode                = rawlog_sample(&sensor, &sample, sampleIndex);
+    size += bmp280_raw_log_encode(&encoder, &sample, &rawLog[size]);
+    sim_advance_ns(RAWLOG_PERIOD_NS - (sim_now_ns() - periodStartNs));
+  }
+  if (ERR_NO_ERR != errCode) {
+    printf("capture failed with error %d\n", errCode);
+    return 1;
+  }
+
+  FILE* file = fopen(path, "wb");
+  if (NULL == file || fwrite(rawLog, 1, size, file) != size || 0 != fclose(file)) {
+    printf("can't write %s\n", path);
+    return 1;
+  }
+
+  // read the file back and check it against what the driver returned
+  Bmp280RawLogDecoder decoder;
+  uint32_t            logSize    = rawlog_load(path);
+  int                 totalMatch = 0;
+  uint32_t            maxSkewUs  = 0;
+  uint32_t            offset     = BMP280_RAW_LOG_HEADER_SIZE;
+  bool                isOpen     = bmp280_raw_log_open(&decoder, rawLog, logSize);
+  for (int sampleIndex = 0; isOpen && sampleIndex < totalSample; ++sampleIndex) {
+    float temperature;
+    float pressure;
+    offset = bmp280_raw_log_decode(&decoder, rawLog, logSize, offset, &sample);
+    if (0 == offset) { break; }
+    bmp280_raw_log_compensate(&decoder, &sample, &temperature, &pressure);
+    if (temperature == driverTemperature[sampleIndex] && pressure == driverPressure[sampleIndex]) {
+      ++totalMatch;
+    }
+    int32_t skewUs = time_source_diff_us(sample.timeUs, driverTimeUs[sampleIndex]);
+    if ((uint32_t)abs(skewUs) > maxSkewUs) { maxSkewUs = (uint32_t)abs(skewUs); }
+  }
+
+  uint32_t floatSize = (uint32_t)totalSample * RAWLOG_FLOAT_RECORD;
+  printf("%d samples in %u bytes, %.2f bytes per sample\n",
+         totalSample,
+         size,
+         (double)(size - BMP280_RAW_LOG_HEADER_SIZE) / totalSample);
+  printf("float log %u bytes, %.1f %% saved\n",
+         floatSize,
+         100.0 * (1.0 - (double)size / floatSize));
+  printf("decoded values equal to the driver's: %d of %d, largest timestamp error %u us\n",
+         totalMatch,
+         totalSample,
+         maxSkewUs);
+  return (totalMatch == totalSample) ? 0 : 2;
+}
+
+static int rawlog_decode(const char* path) {
+  Bmp280RawLogDecoder decoder;
+  Bmp280RawSample     sample;
+  uint32_t            size = rawlog_load(path);
+  if (!bmp280_raw_log_open(&decoder, rawLog, size)) {
+    printf("%s is not a raw log\n", path);
+    return 1;
+  }
+
+  printf("time_us,temperature_c,pressure_pa\n");
+  for (uint32_t offset = BMP280_RAW_LOG_HEADER_SIZE; offset < size;) {
+    float temperature;
+    float pressure;
+    offset = bmp280_raw_log_decode(&decoder, rawLog, size, offset, &sample);
+    if (0 == offset) {
+      printf("log cut short\n");
+      return 1;
+    }
+    bmp280_raw_log_compensate(&decoder, &sample, &temperature, &pressure);
+    printf("%u,%.2f,%.4f\n", sample.timeUs, temperature, pressure);
+  }
+  return 0;
+}
+
+int main(int argc, char** argv) {
+  if ((3 == argc || 4 == argc) && 0 == strcmp(argv[1], "capture")) {
+    int totalSample = (4 == argc) ? atoi(argv[3]) : RAWLOG_DEFAULT_SAMPLE;
+    if (totalSample > 0 && totalSample <= RAWLOG_MAX_SAMPLE) {
+      return rawlog_capture(argv[2], totalSample);
+    }
+  }
+  if (3 == argc && 0 == strcmp(argv[1], "decode")) { return rawlog_decode(argv[2]); }
+
+  printf("usage: %s capture <log> [samples, up to %d]\n", argv[0], RAWLOG_MAX_SAMPLE);
+  printf("       %s decode <log>\n", argv[0]);
+  return 1;
+}
@@ -0,0 +1,513 @@
+/**
+ * @brief recompensate an archive of raw sample logs from many sensors on every core of a PC
+ *
+ * An archive is the raw logs of BMP280_RawLog.h, each with the calibration of its sensor, one
+ * after the other. All fields are little endian:
+ *
+ *   archive  'B' 'R' 'A' version | sensor count (u32) | entries
+ *   entry    size of the log (u32) | the log
+ *
+ * run memory maps the archive and splits it into chunks of whole sensors. Worker threads take
+ * chunks in turn, a first pass counts the records of every log so each sensor knows where its
+ * rows go and a second pass decodes and compensates them with the BMP280_Ware kernels straight
+ * into memory mapped column files:
+ *
+ *   <prefix>.sensor.u32 <prefix>.time_us.u32 <prefix>.temperature_c.f32 <prefix>.pressure_pa.f32
+ *
+ * one row per sample in archive order, so the output doesn't depend on the thread count. scale
+ * times the same work for 1, 2, 4 ... threads up to the core count without writing files and
+ * checks every run against the single threaded one. make writes a synthetic archive to try it on
+ *
+ * @code
+ * bmp280_recomp make archive.bra 2000 3600
+ * bmp280_recomp run archive.bra out
+ * bmp280_recomp scale archive.bra
+ * @endcode
+ *
+ * @file bmp280_recomp.c
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#include <fcntl.h>
+#include <math.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "host/Host_Random.h"
+#include "host/Host_TimeSource.h"
+#include "host/sim/Sim_BMP280.h"
+#include "include/BMP280_RawLog.h"
+
+#define RECOMP_VERSION 1
+#define RECOMP_HEADER_SIZE 8
+#define RECOMP_ENTRY_HEADER_SIZE 4
+#define RECOMP_MAX_THREAD 256
+#define RECOMP_CHUNK_PER_THREAD 8  // more chunks than threads, a slow chunk doesn't stall the rest
+#define RECOMP_TICK_US 1000
+#define RECOMP_PERIOD_US 1000000
+#define RECOMP_TOTAL_COLUMN 4
+#define RECOMP_MAX_SAMPLE 100000  // per sensor, for make
+
+static const uint8_t recompMagic[3] = {'B', 'R', 'A'};
+
+static const char* const recompColumnName[RECOMP_TOTAL_COLUMN] = {
+    "sensor.u32", "time_us.u32", "temperature_c.f32", "pressure_pa.f32"};
+
+/**
+ * @brief one log of the archive and where its rows go in the columns
+ */
+typedef struct {
+  const uint8_t* log;
+  uint32_t       size;
+  uint64_t       firstRow;
+  uint32_t       totalRow;
+} RecompSensor;
+
+typedef struct {
+  uint32_t* sensor;
+  uint32_t* timeUs;
+  float*    temperatureC;
+  float*    pressurePa;
+} RecompColumns;
+
+typedef struct RecompJob RecompJob;
+typedef bool (*RecompPass)(RecompJob* job, const uint32_t sensorIndex);
+
+struct RecompJob {
+  RecompSensor*   sensor;
+  uint32_t        totalSensor;
+  uint32_t*       chunkStart;  //!< chunk k is sensors chunkStart[k] to chunkStart[k + 1]
+  uint32_t        totalChunk;
+  uint32_t        nextChunk;
+  pthread_mutex_t lock;
+  RecompPass      pass;
+  RecompColumns   columns;
+  bool            isFailed;
+};
+
+typedef struct {
+  uint8_t* data;
+  size_t   size;
+} RecompMap;
+
+static uint32_t recomp_get_u32(const uint8_t* in) {
+  return (uint32_t)in[0] | ((uint32_t)in[1] << 8) | ((uint32_t)in[2] << 16) |
+         ((uint32_t)in[3] << 24);
+}
+
+static void recomp_put_u32(uint8_t* out, const uint32_t value) {
+  for (int byteIndex = 0; byteIndex < 4; ++byteIndex) {
+    out[byteIndex] = (uint8_t)(value >> (8 * byteIndex));
+  }
+}
+
+/* archive */
+
+static bool recomp_map(const char* path, RecompMap* map) {
+  struct stat status;
+  int         file = open(path, O_RDONLY);
+  if (file < 0) { return false; }
+  if (0 != fstat(file, &status) || status.st_size < RECOMP_HEADER_SIZE) {
+    close(file);
+    return false;
+  }
+  map->size = (size_t)status.st_size;
+  map->data = mmap(NULL, map->size, PROT_READ, MAP_PRIVATE, file, 0);
+  close(file);
+  if (MAP_FAILED == map->data) { return false; }
+  // the passes walk every log front to back
+  madvise(map->data, map->size, MADV_SEQUENTIAL);
+  return true;
+}
+
+// fill job->sensor from the entries of the archive, without reading the logs themselves
+static bool recomp_index(const RecompMap* map, RecompJob* job) {
+  if (0 != memcmp(map->data, recompMagic, sizeof(recompMagic)) ||
+      RECOMP_VERSION != map->data[3]) {
+    return false;
+  }
+  job->totalSensor = recomp_get_u32(&map->data[4]);
+  job->sensor      = calloc(job->totalSensor ? job->totalSensor : 1, sizeof(RecompSensor));
+  if (NULL == job->sensor) { return false; }
+
+  size_t offset = RECOMP_HEADER_SIZE;
+  for (uint32_t sensorIndex = 0; sensorIndex < job->totalSensor; ++sensorIndex) {
+    if (offset + RECOMP_ENTRY_HEADER_SIZE > map->size) { return false; }
+    uint32_t size = recomp_get_u32(&map->data[offset]);
+    offset += RECOMP_ENTRY_HEADER_SIZE;
+    if (size > map->size - offset) { return false; }
+    job->sensor[sensorIndex].log  = &map->data[offset];
+    job->sensor[sensorIndex].size = size;
+    offset += size;
+  }
+  return true;
+}
+
+// split the sensors into chunks of about the same number of bytes
+static bool recomp_chunk(RecompJob* job, const uint32_t totalThread) {
+  uint64_t totalByte = 0;
+  for (uint32_t sensorIndex = 0; sensorIndex < job->totalSensor; ++sensorIndex) {
+    totalByte += job->sensor[sensorIndex].size;
+  }
+  uint64_t chunkByte = totalByte / ((uint64_t)totalThread * RECOMP_CHUNK_PER_THREAD) + 1;
+
+  free(job->chunkStart);
+  job->chunkStart = malloc(((size_t)job->totalSensor + 2) * sizeof(uint32_t));
+  if (NULL == job->chunkStart) { return false; }
+  job->totalChunk    = 0;
+  uint64_t chunkFill = chunkByte;
+  for (uint32_t sensorIndex = 0; sensorIndex < job->totalSensor; ++sensorIndex) {
+    if (chunkFill >= chunkByte) {
+      job->chunkStart[job->totalChunk++] = sensorIndex;
+      chunkFill                          = 0;
+    }
+    chunkFill += job->sensor[sensorIndex].size;
+  }
+  job->chunkStart[job->totalChunk] = job->totalSensor;
+  return true;
+}
+
+/* passes, each called once per sensor from any thread */
+
+static bool recomp_count(RecompJob* job, const uint32_t sensorIndex) {
+  RecompSensor*       sensor = &job->sensor[sensorIndex];
+  Bmp280RawLogDecoder decoder;
+  Bmp280RawSample     sample;
+  if (!bmp280_raw_log_open(&decoder, sensor->log, sensor->size)) { return false; }
+
+  sensor->totalRow = 0;
+  for (uint32_t offset = BMP280_RAW_LOG_HEADER_SIZE; offset < sensor->size; ++sensor->totalRow) {
+    offset = bmp280_raw_log_decode(&decoder, sensor->log, sensor->size, offset, &sample);
+    if (0 == offset) { return false; }
+  }
+  return true;
+}
+
+static bool recomp_compensate(RecompJob* job, const uint32_t sensorIndex) {
+  const RecompSensor* sensor = &job->sensor[sensorIndex];
+  RecompColumns*      out    = &job->columns;
+  Bmp280RawLogDecoder decoder;
+  Bmp280RawSample     sample;
+  if (!bmp280_raw_log_open(&decoder, sensor->log, sensor->size)) { return false; }
+
+  uint32_t offset = BMP280_RAW_LOG_HEADER_SIZE;
+  for (uint64_t row = sensor->firstRow; row < sensor->firstRow + sensor->totalRow; ++row) {
+    offset = bmp280_raw_log_decode(&decoder, sensor->log, sensor->size, offset, &sample);
+    if (0 == offset) { return false; }
+    out->sensor[row] = sensorIndex;
+    out->timeUs[row] = sample.timeUs;
+    bmp280_raw_log_compensate(&decoder, &sample, &out->temperatureC[row], &out->pressurePa[row]);
+  }
+  return true;
+}
+
+static void* recomp_worker(void* argument) {
+  RecompJob* job = argument;
+  for (;;) {
+    pthread_mutex_lock(&job->lock);
+    uint32_t chunk = job->nextChunk++;
+    pthread_mutex_unlock(&job->lock);
+    if (chunk >= job->totalChunk) { return NULL; }
+
+    for (uint32_t sensorIndex = job->chunkStart[chunk]; sensorIndex < job->chunkStart[chunk + 1];
+         ++sensorIndex) {
+      if (!job->pass(job, sensorIndex)) {
+        pthread_mutex_lock(&job->lock);
+        job->isFailed = true;
+        pthread_mutex_unlock(&job->lock);
+      }
+    }
+  }
+}
+
+static bool recomp_parallel(RecompJob* job, const RecompPass pass, const uint32_t totalThread) {
+  pthread_t thread[RECOMP_MAX_THREAD];
+  job->pass      = pass;
+  job->nextChunk = 0;
+  job->isFailed  = false;
+
+  uint32_t totalStarted = 1;
+  for (; totalStarted < totalThread; ++totalStarted) {
+    if (0 != pthread_create(&thread[totalStarted], NULL, recomp_worker, job)) { break; }
+  }
+  // the calling thread is a worker too, so a failed pthread_create only costs speed
+  recomp_worker(job);
+  for (uint32_t threadIndex = 1; threadIndex < totalStarted; ++threadIndex) {
+    pthread_join(thread[threadIndex], NULL);
+  }
+  return !job->isFailed;
+}
+
+// count the rows of every sensor and lay them out one sensor after the other, return the total
+static uint64_t recomp_layout(RecompJob* job, const uint32_t totalThread) {
+  if (!recomp_parallel(job, recomp_count, totalThread)) { return 0; }
+  uint64_t totalRow = 0;
+  for (uint32_t sensorIndex = 0; sensorIndex < job->totalSensor; ++sensorIndex) {
+    job->sensor[sensorIndex].firstRow = totalRow;
+    totalRow += job->sensor[sensorIndex].totalRow;
+  }
+  return totalRow;
+}
+
+static uint32_t recomp_core_count(void) {
+  long totalCore = sysconf(_SC_NPROCESSORS_ONLN);
+  if (totalCore < 1) { return 1; }
+  return (totalCore > RECOMP_MAX_THREAD) ? RECOMP_MAX_THREAD : (uint32_t)totalCore;
+}
+
+static bool recomp_open(const char* path, RecompMap* map, RecompJob* job) {
+  memset(job, 0, sizeof(*job));
+  pthread_mutex_init(&job->lock, NULL);
+  if (!recomp_map(path, map)) {
+    printf("can't map %s\n", path);
+    return false;
+  }
+  if (!recomp_index(map, job)) {
+    printf("%s is not an archive or is cut short\n", path);
+    return false;
+  }
+  return true;
+}
+
+static void recomp_report(const char*      label,
+                          const RecompJob* job,
+                          const RecompMap* map,
+                          const uint64_t   totalRow,
+                          const uint32_t   elapsedUs) {
+  double elapsedS = (elapsedUs ? elapsedUs : 1) * 1e-6;
+  printf("%s%u sensors, %llu samples in %.3f s: %.2f M samples/s, %.1f MB/s of archive\n",
+         label,
+         job->totalSensor,
+         (unsigned long long)totalRow,
+         elapsedS,
+         totalRow / elapsedS * 1e-6,
+         map->size / elapsedS * 1e-6);
+}
+
+/* commands */
+
+static void* recomp_map_column(const char* prefix, const char* name, const size_t size) {
+  char path[512];
+  snprintf(path, sizeof(path), "%s.%s", prefix, name);
+  int file = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (file < 0) { return NULL; }
+  void* column = NULL;
+  if (0 == ftruncate(file, (off_t)size) && size > 0) {
+    column = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+  }
+  close(file);
+  return (MAP_FAILED == column) ? NULL : column;
+}
+
+static int recomp_run(const char* path, const char* prefix, const uint32_t totalThread) {
+  TimeSource hostTime;
+  RecompMap  map;
+  RecompJob  job;
+  host_time_source_monotonic(&hostTime);
+  if (!recomp_open(path, &map, &job)) { return 1; }
+
+  uint32_t startUs  = time_source_now_us(&hostTime);
+  uint64_t totalRow = recomp_chunk(&job, totalThread) ? recomp_layout(&job, totalThread) : 0;
+  if (0 == totalRow) {
+    printf("%s has no samples or a broken log\n", path);
+    return 1;
+  }
+
+  size_t columnSize[RECOMP_TOTAL_COLUMN] = {
+      sizeof(uint32_t), sizeof(uint32_t), sizeof(float), sizeof(float)};
+  void* column[RECOMP_TOTAL_COLUMN];
+  for (int columnIndex = 0; columnIndex < RECOMP_TOTAL_COLUMN; ++columnIndex) {
+    columnSize[columnIndex] *= (size_t)totalRow;
+    column[columnIndex] =
+        recomp_map_column(prefix, recompColumnName[columnIndex], columnSize[columnIndex]);
+    if (NULL == column[columnIndex]) {
+      printf("can't write %s.%s\n", prefix, recompColumnName[columnIndex]);
+      return 1;
+    }
+  }
+  job.columns.sensor       = column[0];
+  job.columns.timeUs       = column[1];
+  job.columns.temperatureC = column[2];
+  job.columns.pressurePa   = column[3];
+
+  bool isDone = recomp_parallel(&job, recomp_compensate, totalThread);
+  for (int columnIndex = 0; columnIndex < RECOMP_TOTAL_COLUMN; ++columnIndex) {
+    munmap(column[columnIndex], columnSize[columnIndex]);
+  }
+  uint32_t elapsedUs = time_source_now_us(&hostTime) - startUs;
+  if (!isDone) {
+    printf("%s has a broken log\n", path);
+    return 1;
+  }
+
+  char label[64];
+  snprintf(label, sizeof(label), "%u threads, %u chunks: ", totalThread, job.totalChunk);
+  recomp_report(label, &job, &map, totalRow, elapsedUs);
+  return 0;
+}
+
+static bool recomp_alloc_columns(RecompColumns* columns, const uint64_t totalRow) {
+  columns->sensor       = malloc((size_t)totalRow * sizeof(uint32_t));
+  columns->timeUs       = malloc((size_t)totalRow * sizeof(uint32_t));
+  columns->temperatureC = malloc((size_t)totalRow * sizeof(float));
+  columns->pressurePa   = malloc((size_t)totalRow * sizeof(float));
+  return NULL != columns->sensor && NULL != columns->timeUs && NULL != columns->temperatureC &&
+         NULL != columns->pressurePa;
+}
+
+static bool recomp_same_columns(const RecompColumns* left,
+                                const RecompColumns* right,
+                                const uint64_t       totalRow) {
+  return 0 == memcmp(left->sensor, right->sensor, (size_t)totalRow * sizeof(uint32_t)) &&
+         0 == memcmp(left->timeUs, right->timeUs, (size_t)totalRow * sizeof(uint32_t)) &&
+         0 == memcmp(left->temperatureC, right->temperatureC, (size_t)totalRow * sizeof(float)) &&
+         0 == memcmp(left->pressurePa, right->pressurePa, (size_t)totalRow * sizeof(float));
+}
+
+static int recomp_scale(const char* path) {
+  TimeSource    hostTime;
+  RecompMap     map;
+  RecompJob     job;
+  RecompColumns reference;
+  host_time_source_monotonic(&hostTime);
+  if (!recomp_open(path, &map, &job)) { return 1; }
+
+  uint32_t totalCore = recomp_core_count();
+  uint64_t totalRow  = recomp_chunk(&job, 1) ? recomp_layout(&job, 1) : 0;
+  if (0 == totalRow || !recomp_alloc_columns(&job.columns, totalRow) ||
+      !recomp_alloc_columns(&reference, totalRow)) {
+    printf("%s has no samples or a broken log\n", path);
+    return 1;
+  }
+  printf("%u cores\n", totalCore);
+
+  double   singleRate  = 0;
+  bool     isAllSame   = true;
+  uint32_t totalThread = 1;
+  for (;;) {
+    uint32_t startUs = time_source_now_us(&hostTime);
+    bool     isDone  = recomp_chunk(&job, totalThread) && recomp_layout(&job, totalThread) &&
+                  recomp_parallel(&job, recomp_compensate, totalThread);
+    uint32_t elapsedUs = time_source_now_us(&hostTime) - startUs;
+    if (!isDone) {
+      printf("%s has a broken log\n", path);
+      return 1;
+    }
+
+    double rate   = (double)totalRow / (elapsedUs ? elapsedUs : 1);
+    bool   isSame = true;
+    if (1 == totalThread) {
+      singleRate          = rate;
+      RecompColumns spare = reference;
+      reference           = job.columns;
+      job.columns         = spare;
+    } else {
+      isSame    = recomp_same_columns(&reference, &job.columns, totalRow);
+      isAllSame = isAllSame && isSame;
+    }
+    char label[64];
+    snprintf(label,
+             sizeof(label),
+             "%3u threads, %.2fx, %s: ",
+             totalThread,
+             rate / singleRate,
+             isSame ? "same output" : "DIFFERENT OUTPUT");
+    recomp_report(label, &job, &map, totalRow, elapsedUs);
+
+    if (totalThread >= totalCore) { break; }
+    totalThread = (2 * totalThread > totalCore) ? totalCore : 2 * totalThread;
+  }
+  return isAllSame ? 0 : 2;
+}
+
+static int recomp_make(const char* path, const uint32_t totalSensor, const uint32_t totalSample) {
+  static uint8_t log[BMP280_RAW_LOG_HEADER_SIZE + RECOMP_MAX_SAMPLE * BMP280_RAW_LOG_MAX_RECORD];
+  SimBmp280      reference;
+  uint8_t        header[RECOMP_HEADER_SIZE];
+  FILE*          file = fopen(path, "wb");
+  if (NULL == file) {
+    printf("can't write %s\n", path);
+    return 1;
+  }
+  sim_bmp280_init(&reference);
+  memcpy(header, recompMagic, sizeof(recompMagic));
+  header[3] = RECOMP_VERSION;
+  recomp_put_u32(&header[4], totalSensor);
+  bool isWritten = (sizeof(header) == fwrite(header, 1, sizeof(header), file));
+
+  uint64_t totalByte = sizeof(header);
+  for (uint32_t sensorIndex = 0; isWritten && sensorIndex < totalSensor; ++sensorIndex) {
+    // every part is trimmed differently, spread the calibration around the datasheet example
+    uint32_t            state      = sensorIndex + 1;
+    Bmp280CalibParam    calibParam = reference.calibParam;
+    Bmp280RawLogEncoder encoder;
+    calibParam.dig_t1 += host_random_spread(&state, 400);
+    calibParam.dig_t2 += host_random_spread(&state, 400);
+    calibParam.dig_p1 += host_random_spread(&state, 800);
+    calibParam.dig_p2 += host_random_spread(&state, 400);
+    calibParam.dig_p4 += host_random_spread(&state, 200);
+
+    double   baseTemperature = 5.0 + host_random_spread(&state, 1500) * 0.01;
+    double   basePressure    = 100000.0 + host_random_spread(&state, 3000);
+    uint32_t timeUs          = host_random(&state);
+    uint32_t size            = BMP280_RAW_LOG_HEADER_SIZE;
+    bmp280_raw_log_start(&encoder, &calibParam, timeUs, RECOMP_TICK_US, log);
+    for (uint32_t sampleIndex = 0; sampleIndex < totalSample; ++sampleIndex) {
+      double          phase = 2 * M_PI * sampleIndex / 3600.0;
+      Bmp280RawSample sample;
+      sample.timeUs   = timeUs;
+      sample.rawTemp  = sim_bmp280_raw_temp(&calibParam, baseTemperature + 2.0 * sin(phase)) +
+                       host_random_spread(&state, 8);
+      sample.rawPress =
+          sim_bmp280_raw_press(&calibParam, sample.rawTemp, basePressure + 300.0 * cos(phase)) +
+          host_random_spread(&state, 16);
+      size += bmp280_raw_log_encode(&encoder, &sample, &log[size]);
+      timeUs += RECOMP_PERIOD_US + host_random_spread(&state, 2000);
+    }
+
+    uint8_t entry[RECOMP_ENTRY_HEADER_SIZE];
+    recomp_put_u32(entry, size);
+    isWritten = sizeof(entry) == fwrite(entry, 1, sizeof(entry), file) &&
+                size == fwrite(log, 1, size, file);
+    totalByte += sizeof(entry) + size;
+  }
+  if (0 != fclose(file) || !isWritten) {
+    printf("can't write %s\n", path);
+    return 1;
+  }
+  printf("%u sensors of %u samples, %llu bytes\n",
+         totalSensor,
+         totalSample,
+         (unsigned long long)totalByte);
+  return 0;
+}
+
+int main(int argc, char** argv) {
+  if (5 == argc && 0 == strcmp(argv[1], "make")) {
+    int totalSensor = atoi(argv[3]);
+    int totalSample = atoi(argv[4]);
+    if (totalSensor > 0 && totalSample > 0 && totalSample <= RECOMP_MAX_SAMPLE) {
+      return recomp_make(argv[2], (uint32_t)totalSensor, (uint32_t)totalSample);
+    }
+  }
+  if ((4 == argc || 5 == argc) && 0 == strcmp(argv[1], "run")) {
+    int totalThread = (5 == argc) ? atoi(argv[4]) : (int)recomp_core_count();
+    if (totalThread > 0 && totalThread <= RECOMP_MAX_THREAD) {
+      return recomp_run(argv[2], argv[3], (uint32_t)totalThread);
+    }
+  }
+  if (3 == argc && 0 == strcmp(argv[1], "scale")) { return recomp_scale(argv[2]); }
+
+  printf("usage: %s make <archive> <sensors> <samples per sensor, up to %d>\n",
+         argv[0],
+         RECOMP_MAX_SAMPLE);
+  printf("       %s run <archive> <output prefix> [threads, the core count by default]\n", argv[0]);
+  printf("       %s scale <archive>\n", argv[0]);
+  return 1;
+}
@@ -0,0 +1,273 @@
+/**
+ * @brief daemon emulating many bmp280s behind a Unix domain socket, for load testing collector
+ * processes on one machine
+ *
+ * The sensors are in pairs on simulated I2C buses of host/sim/Sim_Bus.h, sensor k sits on bus
+ * k / 2 at address 0x76 + k % 2 and runs on the wall clock, so conversions take real time. A
+ * collector connects once per bus with host/Host_BusSocket.h and uses the driver as usual. Every
+ * connection gets its own thread, transfers on the same bus are serialized by the lock of the bus
+ * and hold it for as long as they would take on the wire at the given bit rate
+ *
+ *   -n  number of sensors, 64 by default
+ *   -w  waveform: flat (25 C, 101325 Pa), weather (daily temperature and a front passing over
+ *       in 6 hours) or storm (2 C and 400 Pa swings within a minute), each sensor shifted in phase
+ *   -c  seed for a calibration spread around the datasheet example, 0 gives every sensor the
+ *       datasheet calibration
+ *   -t  multiplier on the typical conversion time
+ *   -r  bus bit rate in Hz, 400000 by default, 0 for instant transfers
+ *
+ * @code
+ * bmp280_simd -n 256 -w storm /tmp/bmp280.sock
+ * @endcode
+ *
+ * @file bmp280_simd.c
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#include <math.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "host/Host_BusLock.h"
+#include "host/Host_BusSocket.h"
+#include "host/Host_Random.h"
+#include "host/sim/Sim_BMP280.h"
+#include "host/sim/Sim_Bus.h"
+
+#define SIMD_MAX_SENSOR 4096
+#define SIMD_SENSOR_PER_BUS 2  // the two addresses a bmp280 can take
+#define SIMD_MAX_BUS (SIMD_MAX_SENSOR / SIMD_SENSOR_PER_BUS)
+#define SIMD_FIRST_ADDRESS 0x76
+#define SIMD_BACKLOG 128
+
+typedef enum { SIMD_FLAT, SIMD_WEATHER, SIMD_STORM } SimdWaveform;
+
+typedef struct {
+  SimBmp280 device;
+  double    phase;  //!< in radians, so the sensors don't all read the same
+} SimdSensor;
+
+typedef struct {
+  SimBus          simBus;
+  pthread_mutex_t mutex;
+  BusLock         lock;
+} SimdBus;
+
+static SimdSensor  simdSensor[SIMD_MAX_SENSOR];
+static SimdBus     simdBus[SIMD_MAX_BUS];
+static uint16_t    simdTotalBus;
+static const char* simdPath;
+
+static double simd_storm_temperature(void* context, const uint64_t timeNs) {
+  const SimdSensor* sensor = context;
+  return 20.0 + 2.0 * sin((double)timeNs * 1e-9 * 2 * M_PI / 600 + sensor->phase);
+}
+
+static double simd_storm_pressure(void* context, const uint64_t timeNs) {
+  const SimdSensor* sensor = context;
+  return 100800.0 + 400.0 * sin((double)timeNs * 1e-9 * 2 * M_PI / 60 + sensor->phase);
+}
+
+static double simd_weather_temperature(void* context, const uint64_t timeNs) {
+  const SimdSensor* sensor = context;
+  return 15.0 + 8.0 * sin((double)timeNs * 1e-9 * 2 * M_PI / 86400 + sensor->phase);
+}
+
+static double simd_weather_pressure(void* context, const uint64_t timeNs) {
+  const SimdSensor* sensor = context;
+  return 100800.0 + 900.0 * sin((double)timeNs * 1e-9 * 2 * M_PI / 21600 + sensor->phase);
+}
+
+static void simd_setup(const uint32_t     totalSensor,
+                       const SimdWaveform waveform,
+                       const uint32_t     calibSeed,
+                       const double       timingScale,
+                       const uint32_t     bitRateHz) {
+  uint32_t state = calibSeed;
+  simdTotalBus   = (totalSensor + SIMD_SENSOR_PER_BUS - 1) / SIMD_SENSOR_PER_BUS;
+  for (uint16_t busIndex = 0; busIndex < simdTotalBus; ++busIndex) {
+    SimdBus* bus = &simdBus[busIndex];
+    sim_bus_init(&bus->simBus, bitRateHz);
+    pthread_mutex_init(&bus->mutex, NULL);
+    host_bus_lock_pthread(&bus->lock, &bus->mutex);
+    bus->simBus.bus.lock = &bus->lock;
+    bus->simBus.bus.ops->open(bus->simBus.bus.context);
+  }
+
+  for (uint32_t sensorIndex = 0; sensorIndex < totalSensor; ++sensorIndex) {
+    SimdSensor* sensor = &simdSensor[sensorIndex];
+    SimBmp280*  device = &sensor->device;
+    sim_bmp280_init(device);
+    if (0 != calibSeed) {
+      device->calibParam.dig_t1 += host_random_spread(&state, 400);
+      device->calibParam.dig_t2 += host_random_spread(&state, 400);
+      device->calibParam.dig_p1 += host_random_spread(&state, 800);
+      device->calibParam.dig_p2 += host_random_spread(&state, 400);
+      device->calibParam.dig_p4 += host_random_spread(&state, 200);
+      device->calibParam.dig_p8 += host_random_spread(&state, 200);
+    }
+    sensor->phase            = 2 * M_PI * sensorIndex / totalSensor;
+    device->waveform.context = sensor;
+    if (SIMD_WEATHER == waveform) {
+      device->waveform.temperatureC = simd_weather_temperature;
+      device->waveform.pressurePa   = simd_weather_pressure;
+    } else if (SIMD_STORM == waveform) {
+      device->waveform.temperatureC = simd_storm_temperature;
+      device->waveform.pressurePa   = simd_storm_pressure;
+    }
+    device->timingScale = timingScale;
+    device->nowNs       = sim_bus_wall_ns;
+    sim_bmp280_power_on(device);
+    sim_bus_attach(&simdBus[sensorIndex / SIMD_SENSOR_PER_BUS].simBus,
+                   &simBmp280Ops,
+                   device,
+                   SIMD_FIRST_ADDRESS + sensorIndex % SIMD_SENSOR_PER_BUS);
+  }
+}
+
+static bool simd_send(const int fd, const uint8_t* data, const size_t size) {
+  return size == (size_t)send(fd, data, size, MSG_NOSIGNAL);
+}
+
+/**
+ * @brief serve one connection until the collector closes it, the first frame has to select a bus
+ *
+ */
+static void* simd_connection(void* argument) {
+  int      fd  = (int)(intptr_t)argument;
+  SimdBus* bus = NULL;
+  uint8_t  frame[HOST_BUS_SOCKET_FRAME_SIZE];
+  uint8_t  response[1 + UINT8_MAX];
+
+  while (HOST_BUS_SOCKET_FRAME_SIZE == recv(fd, frame, sizeof(frame), MSG_WAITALL)) {
+    size_t responseSize = 1;
+    response[0]         = HOST_BUS_SOCKET_BAD_FRAME;
+    if (HOST_BUS_SOCKET_OPEN == frame[0]) {
+      uint16_t busIndex = frame[1] | (uint16_t)frame[2] << 8;
+      if (busIndex < simdTotalBus) {
+        bus         = &simdBus[busIndex];
+        response[0] = HOST_BUS_SOCKET_ACK;
+      }
+    } else if (NULL != bus && HOST_BUS_SOCKET_READ == frame[0]) {
+      const Bmp280Bus* simBus = &bus->simBus.bus;
+      bmp280_bus_lock(simBus);
+      bool isAcked = simBus->ops->read(simBus->context, frame[1], frame[2], response + 1, frame[3]);
+      bmp280_bus_unlock(simBus);
+      response[0]  = isAcked ? HOST_BUS_SOCKET_ACK : HOST_BUS_SOCKET_NACK;
+      responseSize = isAcked ? 1 + frame[3] : 1;
+    } else if (NULL != bus && HOST_BUS_SOCKET_WRITE == frame[0]) {
+      const Bmp280Bus* simBus = &bus->simBus.bus;
+      bmp280_bus_lock(simBus);
+      bool isAcked = simBus->ops->write(simBus->context, frame[1], frame[2], frame[3]);
+      bmp280_bus_unlock(simBus);
+      response[0] = isAcked ? HOST_BUS_SOCKET_ACK : HOST_BUS_SOCKET_NACK;
+    }
+    if (!simd_send(fd, response, responseSize)) { break; }
+  }
+  close(fd);
+  return NULL;
+}
+
+static void simd_stop(int signalNumber) {
+  (void)signalNumber;
+  unlink(simdPath);
+  _exit(0);
+}
+
+static int simd_serve(void) {
+  struct sockaddr_un address;
+  memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  if (strlen(simdPath) >= sizeof(address.sun_path)) {
+    printf("socket path too long: %s\n", simdPath);
+    return 1;
+  }
+  strcpy(address.sun_path, simdPath);
+
+  int listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+  unlink(simdPath);
+  if (listenFd < 0 || 0 != bind(listenFd, (struct sockaddr*)&address, sizeof(address)) ||
+      0 != listen(listenFd, SIMD_BACKLOG)) {
+    perror(simdPath);
+    return 1;
+  }
+  signal(SIGINT, simd_stop);
+  signal(SIGTERM, simd_stop);
+  printf("%u buses on %s\n", simdTotalBus, simdPath);
+  fflush(stdout);
+
+  while (true) {
+    int fd = accept(listenFd, NULL, NULL);
+    if (fd < 0) { continue; }
+    pthread_t thread;
+    if (0 != pthread_create(&thread, NULL, simd_connection, (void*)(intptr_t)fd)) {
+      close(fd);
+      continue;
+    }
+    pthread_detach(thread);
+  }
+}
+
+static void simd_usage(const char* name) {
+  printf("usage: %s [-n sensors, up to %d] [-w flat|weather|storm] [-c calibration seed]\n",
+         name,
+         SIMD_MAX_SENSOR);
+  printf("       [-t conversion time scale] [-r bus bit rate in Hz] <socket path>\n");
+}
+
+int main(int argc, char** argv) {
+  int          totalSensor = 64;
+  SimdWaveform waveform    = SIMD_FLAT;
+  uint32_t     calibSeed   = 0;
+  double       timingScale = 1.0;
+  uint32_t     bitRateHz   = 400000;
+  int          option;
+
+  while (-1 != (option = getopt(argc, argv, "n:w:c:t:r:"))) {
+    switch (option) {
+      case 'n':
+        totalSensor = atoi(optarg);
+        break;
+      case 'c':
+        calibSeed = (uint32_t)strtoul(optarg, NULL, 0);
+        break;
+      case 't':
+        timingScale = atof(optarg);
+        break;
+      case 'r':
+        bitRateHz = (uint32_t)strtoul(optarg, NULL, 0);
+        break;
+      case 'w':
+        if (0 == strcmp(optarg, "flat")) {
+          waveform = SIMD_FLAT;
+        } else if (0 == strcmp(optarg, "weather")) {
+          waveform = SIMD_WEATHER;
+        } else if (0 == strcmp(optarg, "storm")) {
+          waveform = SIMD_STORM;
+        } else {
+          simd_usage(argv[0]);
+          return 1;
+        }
+        break;
+      default:
+        simd_usage(argv[0]);
+        return 1;
+    }
+  }
+  if (optind + 1 != argc || totalSensor <= 0 || totalSensor > SIMD_MAX_SENSOR ||
+      timingScale <= 0) {
+    simd_usage(argv[0]);
+    return 1;
+  }
+
+  simdPath = argv[optind];
+  simd_setup((uint32_t)totalSensor, waveform, calibSeed, timingScale, bitRateHz);
+  return simd_serve();
+}
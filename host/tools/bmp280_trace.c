@@ -0,0 +1,296 @@
+/**
+ * @brief capture, print and replay bus traces of the bmp280 driver, see Bus_Trace.h
+ *
+ * A trace dumped from the board, e.g. over UART with bus_trace_dump, is replayed through this
+ * build of the driver against a virtual device that answers with the recorded bytes. The driver
+ * runs the workload below, the one the firmware is expected to run, and the transactions it does
+ * are compared with the captured ones per direction and register:
+ *
+ *   create HandDynamic, open, reset, update_setting, get_calibration_data, then get_temp_press
+ *
+ * capture runs the same workload against the simulated bmp280 to produce a trace on a PC
+ *
+ * @code
+ * bmp280_trace capture trace.bin i2c 100
+ * bmp280_trace print trace.bin
+ * bmp280_trace replay trace.bin i2c
+ * @endcode
+ *
+ * @file bmp280_trace.c
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "host/sim/Sim_BMP280.h"
+#include "host/sim/Sim_Replay.h"
+#include "host/sim/Sim_TM4C.h"
+#include "include/BMP280_Drv.h"
+#include "include/BMP280_Utils.h"
+#include "include/Bus_Trace.h"
+
+#define TRACE_I2C_ADDR 0x77
+#define TRACE_SAMPLE_PERIOD_NS 10000000
+#define TRACE_DEFAULT_SAMPLE 100
+#define TRACE_RING_SIZE (1024 * 1024)
+
+/**
+ * @brief sink collecting a dump in memory
+ */
+typedef struct {
+  uint8_t* data;
+  uint32_t size;
+  uint32_t used;
+} TraceBuffer;
+
+static uint8_t   traceRing[TRACE_RING_SIZE];
+static uint8_t   traceDump[TRACE_RING_SIZE + BUS_TRACE_HEADER_SIZE];
+static SimBmp280 simSensor;
+static SimReplay simReplay;
+
+static bool trace_buffer_write(void* context, const uint8_t* data, const uint16_t size) {
+  TraceBuffer* buffer = context;
+  if (buffer->used + size > buffer->size) { return false; }
+  memcpy(&buffer->data[buffer->used], data, size);
+  buffer->used += size;
+  return true;
+}
+
+static bool trace_file_write(void* context, const uint8_t* data, const uint16_t size) {
+  return fwrite(data, 1, size, (FILE*)context) == size;
+}
+
+static bool trace_parse_protocol(const char* name, Bmp280ComProtocol* protocol) {
+  if (0 == strcmp(name, "i2c")) {
+    *protocol = I2C;
+  } else if (0 == strcmp(name, "spi")) {
+    *protocol = SPI;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief read a whole trace file into traceDump
+ * @return bytes read, 0 on failure
+ */
+static uint32_t trace_load(const char* path) {
+  FILE* file = fopen(path, "rb");
+  if (NULL == file) { return 0; }
+  uint32_t size = (uint32_t)fread(traceDump, 1, sizeof(traceDump), file);
+  fclose(file);
+  return size;
+}
+
+/**
+ * @brief bring the sensor up the way the firmware does, every transfer is recorded into trace
+ *
+ */
+static Bmp280ErrCode trace_bring_up(bmp280*                 sensor,
+                                    const Bmp280ComProtocol protocol,
+                                    BusTrace*               trace) {
+  BMP280_TRY_FUNC(bmp280_create_predefined_settings(sensor, HandDynamic));
+  BMP280_TRY_FUNC(bmp280_init(sensor, protocol, TRACE_I2C_ADDR));
+  BMP280_TRY_FUNC(bmp280_set_trace(sensor, trace));
+  BMP280_TRY_FUNC(bmp280_open(sensor));
+  BMP280_TRY_FUNC(bmp280_reset(sensor));
+  BMP280_TRY_FUNC(bmp280_update_setting(sensor));
+  BMP280_TRY_FUNC(bmp280_get_calibration_data(sensor, NULL));
+  return ERR_NO_ERR;
+}
+
+/**
+ * @brief add the transactions of a dump to counts, indexed by write flag then register
+ * @return whether the whole dump could be decoded
+ */
+static bool trace_count(const uint8_t* dump, const uint32_t size, uint32_t counts[2][256]) {
+  BusTraceHeader header;
+  if (!bus_trace_parse_header(dump, size, &header)) { return false; }
+
+  BusTraceRecord record = {0};
+  record.timeUs         = header.firstUs;
+  for (uint32_t offset = BUS_TRACE_HEADER_SIZE; offset < size;) {
+    offset = bus_trace_parse_record(dump, size, offset, &record);
+    if (0 == offset) { return false; }
+    ++counts[(record.flags & BUS_TRACE_WRITE) ? 1 : 0][record.reg];
+  }
+  return true;
+}
+
+static int trace_capture(const char*             path,
+                         const Bmp280ComProtocol protocol,
+                         const int               totalSample) {
+  bmp280     sensor;
+  BusTrace   trace;
+  TimeSource timeSource;
+  float      temperature = 0;
+  float      pressure    = 0;
+
+  sim_tm4c_reset();
+  sim_bmp280_init(&simSensor);
+  if (I2C == protocol) {
+    sim_bmp280_attach_i2c(&simSensor, TRACE_I2C_ADDR);
+  } else {
+    sim_bmp280_attach_spi(&simSensor);
+  }
+  sim_time_source(&timeSource);
+  bus_trace_init(&trace, traceRing, sizeof(traceRing), &timeSource);
+
+  Bmp280ErrCode errCode = trace_bring_up(&sensor, protocol, &trace);
+  for (int sampleIndex = 0; ERR_NO_ERR == errCode && sampleIndex < totalSample; ++sampleIndex) {
+    sim_advance_ns(TRACE_SAMPLE_PERIOD_NS);
+    errCode = bmp280_get_temp_press(&sensor, &temperature, &pressure);
+  }
+  if (ERR_NO_ERR != errCode) {
+    printf("capture failed with error %d\n", errCode);
+    return 1;
+  }
+
+  FILE* file = fopen(path, "wb");
+  if (NULL == file) {
+    printf("can't open %s\n", path);
+    return 1;
+  }
+  BusTraceSink sink     = {trace_file_write, file};
+  bool         isDumped = bus_trace_dump(&trace, &sink);
+  bool         isClosed = (0 == fclose(file));
+  if (!isDumped || !isClosed) {
+    printf("can't write %s\n", path);
+    return 1;
+  }
+  printf("%u transactions in %u bytes, %.2f bytes per transaction\n",
+         trace.total,
+         trace.used + BUS_TRACE_HEADER_SIZE,
+         (double)trace.used / trace.total);
+  return 0;
+}
+
+static int trace_print(const char* path) {
+  uint32_t       size = trace_load(path);
+  BusTraceHeader header;
+  if (!bus_trace_parse_header(traceDump, size, &header)) {
+    printf("%s is not a bus trace\n", path);
+    return 1;
+  }
+  printf("%u transactions, %u dropped before the dump\n", header.total, header.dropped);
+
+  BusTraceRecord record = {0};
+  record.timeUs         = header.firstUs;
+  for (uint32_t offset = BUS_TRACE_HEADER_SIZE; offset < size;) {
+    offset = bus_trace_parse_record(traceDump, size, offset, &record);
+    if (0 == offset) {
+      printf("trace cut short\n");
+      return 1;
+    }
+    printf("%10u us %-5s 0x%02X retry %u%s ",
+           record.timeUs,
+           (record.flags & BUS_TRACE_WRITE) ? "write" : "read",
+           record.reg,
+           record.flags & BUS_TRACE_RETRY_M,
+           (record.flags & BUS_TRACE_ERROR) ? " error" : "");
+    for (uint8_t byteIndex = 0; byteIndex < record.length; ++byteIndex) {
+      printf(" %02X", record.data[byteIndex]);
+    }
+    printf("\n");
+  }
+  return 0;
+}
+
+/**
+ * @brief replay a trace and compare the transactions per direction and register
+ * @return 0 if the driver did exactly the captured transactions, 2 if it diverged
+ */
+static int trace_replay(const char* path, const Bmp280ComProtocol protocol) {
+  static uint32_t capturedCount[2][256];
+  static uint32_t replayedCount[2][256];
+  static uint8_t  replayDump[TRACE_RING_SIZE + BUS_TRACE_HEADER_SIZE];
+  bmp280          sensor;
+  BusTrace        trace;
+  TimeSource      timeSource;
+  BusTraceHeader  header;
+  float           temperature = 0;
+  float           pressure    = 0;
+
+  uint32_t size = trace_load(path);
+  if (!sim_replay_init(&simReplay, traceDump, size) ||
+      !bus_trace_parse_header(traceDump, size, &header) ||
+      !trace_count(traceDump, size, capturedCount)) {
+    printf("%s is not a bus trace\n", path);
+    return 1;
+  }
+
+  sim_tm4c_reset();
+  if (I2C == protocol) {
+    sim_i2c0_attach(&simReplayOps, &simReplay, TRACE_I2C_ADDR);
+  } else {
+    sim_ssi0_attach(&simReplayOps, &simReplay);
+  }
+  sim_time_source(&timeSource);
+  bus_trace_init(&trace, traceRing, sizeof(traceRing), &timeSource);
+
+  // a driver that reads less than the captured one still ends, every read moves the cursor
+  uint64_t      startNs = sim_now_ns();
+  Bmp280ErrCode errCode = trace_bring_up(&sensor, protocol, &trace);
+  for (uint32_t sampleIndex = 0;
+       ERR_NO_ERR == errCode && !sim_replay_is_done(&simReplay) && sampleIndex < header.total;
+       ++sampleIndex) {
+    errCode = bmp280_get_temp_press(&sensor, &temperature, &pressure);
+  }
+  uint64_t busNs = sim_now_ns() - startNs;
+
+  TraceBuffer  replayBuffer = {replayDump, sizeof(replayDump), 0};
+  BusTraceSink sink         = {trace_buffer_write, &replayBuffer};
+  if (!bus_trace_dump(&trace, &sink) ||
+      !trace_count(replayBuffer.data, replayBuffer.used, replayedCount)) {
+    printf("replay trace overflowed\n");
+    return 1;
+  }
+
+  printf("%-5s %-4s %9s %9s\n", "dir", "reg", "captured", "replayed");
+  for (int isWrite = 0; isWrite < 2; ++isWrite) {
+    for (int reg = 0; reg < 256; ++reg) {
+      if (0 == capturedCount[isWrite][reg] && 0 == replayedCount[isWrite][reg]) { continue; }
+      printf("%-5s 0x%02X %9u %9u%s\n",
+             isWrite ? "write" : "read",
+             reg,
+             capturedCount[isWrite][reg],
+             replayedCount[isWrite][reg],
+             (capturedCount[isWrite][reg] != replayedCount[isWrite][reg]) ? "  <-" : "");
+    }
+  }
+  printf("%u captured, %u replayed: %u matched, %u missing, %u extra, %u writes differ\n",
+         header.total,
+         trace.total,
+         simReplay.matched,
+         simReplay.missing,
+         simReplay.extra,
+         simReplay.dataMismatch);
+  printf("replay took %.1f us of bus time, last sample %.2f C %.1f Pa, %s\n",
+         (double)busNs / 1000,
+         temperature,
+         pressure,
+         (ERR_NO_ERR == errCode) ? "ok" : "error");
+
+  bool isSame = (0 == simReplay.missing && 0 == simReplay.extra && 0 == simReplay.dataMismatch);
+  return isSame ? 0 : 2;
+}
+
+int main(int argc, char** argv) {
+  Bmp280ComProtocol protocol = I2C;
+  if (argc >= 2 && 0 == strcmp(argv[1], "print") && 3 == argc) { return trace_print(argv[2]); }
+  if (argc >= 4 && trace_parse_protocol(argv[3], &protocol)) {
+    if (0 == strcmp(argv[1], "capture") && argc <= 5) {
+      return trace_capture(argv[2], protocol, (5 == argc) ? atoi(argv[4]) : TRACE_DEFAULT_SAMPLE);
+    }
+    if (0 == strcmp(argv[1], "replay") && 4 == argc) { return trace_replay(argv[2], protocol); }
+  }
+
+  printf("usage: %s capture <trace> <i2c|spi> [samples]\n", argv[0]);
+  printf("       %s print <trace>\n", argv[0]);
+  printf("       %s replay <trace> <i2c|spi>\n", argv[0]);
+  return 1;
+}
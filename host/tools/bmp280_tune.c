@@ -0,0 +1,79 @@
+/**
+ * @brief the setting BMP280_Tune picks for a sample rate, latency and noise budget, or why there
+ * is none, next to the predictions for the presets of the datasheet
+ *
+ * @code
+ * bmp280_tune 10 500 1.0     at least 10 Hz, within 500 ms and 1 Pa RMS
+ * bmp280_tune 1              at least 1 Hz, latency and noise left free
+ * @endcode
+ *
+ * @file bmp280_tune.c
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "include/BMP280_Tune.h"
+
+static const char* const tuneCoeffName[]   = {"x0", "x1", "x2", "x4", "x8", "x16"};
+static const char* const tuneStandbyName[] = {
+    "0.5 ms", "62.5 ms", "125 ms", "250 ms", "500 ms", "1000 ms", "2000 ms", "4000 ms"};
+static const char* const tunePresetName[]  = {
+    "HandLow", "HandDynamic", "WeatherStat", "ElevDetec", "DropDetec", "IndoorNav"};
+
+static const char* const tuneStatusText[] = {
+    [TUNE_OK]                  = "",
+    [TUNE_ODR_UNREACHABLE]     = "no setting samples that fast, the fastest is",
+    [TUNE_NOISE_UNREACHABLE]   = "no setting that fast is that quiet, the quietest is",
+    [TUNE_LATENCY_UNREACHABLE] = "no setting that fast responds that quickly, the quickest is",
+    [TUNE_CONFLICT] = "the noise and the latency can't both be met, the quietest in time is"};
+
+// forced mode is taken as converting back to back, its standby time plays no part
+static void tune_print(const char* name, const Bmp280TuneResult* result) {
+  bool isForced = (Forced == result->mode);
+  printf("  %-12s osrs_t %-3s osrs_p %-3s filter %-3s %-6s %-7s %7.2f Hz %8.1f ms %5.2f Pa "
+         "%7.2f uA\n",
+         name,
+         tuneCoeffName[result->tempSamp],
+         tuneCoeffName[result->presSamp],
+         tuneCoeffName[result->iirFilter],
+         isForced ? "forced" : "normal",
+         isForced ? "" : tuneStandbyName[result->standbyTime],
+         result->odrHz,
+         result->latencyMs,
+         result->noisePa,
+         result->currentUa);
+}
+
+int main(int argc, char** argv) {
+  if (argc < 2 || argc > 4) {
+    printf("usage: %s <sample rate Hz> [max latency ms] [max RMS noise Pa]\n", argv[0]);
+    return 2;
+  }
+
+  Bmp280TuneTarget target = {.odrHz        = strtof(argv[1], NULL),
+                             .maxLatencyMs = (argc > 2) ? strtof(argv[2], NULL) : 0,
+                             .maxNoisePa   = (argc > 3) ? strtof(argv[3], NULL) : 0};
+  Bmp280TuneResult result;
+  Bmp280TuneStatus status = bmp280_tune(&target, &result);
+  if (TUNE_OK == status) {
+    printf("best setting:\n");
+  } else {
+    printf("%s:\n", tuneStatusText[status]);
+  }
+  tune_print("", &result);
+
+  printf("presets:\n");
+  for (int preset = HandLow; preset <= IndoorNav; ++preset) {
+    bmp280 sensor;
+    if (ERR_NO_ERR != bmp280_create_predefined_settings(&sensor, preset) ||
+        ERR_NO_ERR != bmp280_tune_predict(&sensor, &result)) {
+      continue;
+    }
+    tune_print(tunePresetName[preset], &result);
+  }
+  return (TUNE_OK == status) ? 0 : 1;
+}
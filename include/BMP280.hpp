@@ -0,0 +1,256 @@
+/**
+ * @brief header-only C++ front end of the BMP280 driver, the transport and the settings are bound
+ * at compile time
+ *
+ * Bmp280<Transport, Settings> does the same job as BMP280_Drv but the register bytes are
+ * constexpr, invalid settings fail to compile and the read path calls the transfers of BMP280_Bus
+ * directly instead of through the ops of sensor->bus. Failed transfers are retried and the bus
+ * recovered like in bmp280_get_register. Compensation is still done by BMP280_Ware
+ *
+ * @code
+ * Bmp280<Bmp280I2c<0x77>, Bmp280HandDynamic> sensor;
+ * sensor.open();
+ * sensor.reset();
+ * sensor.update_setting();
+ * sensor.get_temp_press(&temperature, &pressure);
+ * @endcode
+ *
+ * @file BMP280.hpp
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#ifndef _BMP280_HPP
+#define _BMP280_HPP
+
+#include <stdint.h>
+
+extern "C" {
+#include "include/BMP280_Bus.h"
+#include "include/BMP280_Drv.h"
+#include "include/BMP280_Utils.h"
+#include "include/BMP280_Ware.h"
+#include "include/TivaC_I2C.h"
+#include "include/TivaC_SPI.h"
+#include "include/TivaC_CycleCounter.h"
+}
+
+/* Register codes, same mapping as the tables in BMP280_Utils.c */
+constexpr uint8_t bmp280_osrs_code(const Bmp280Coeff coeff) {
+  return (coeff >= x0 && coeff <= x16) ? static_cast<uint8_t>(coeff) : BMP280_CODE_INVALID;
+}
+
+constexpr uint8_t bmp280_filter_code(const Bmp280Coeff coeff) {
+  return (x0 == coeff) ? BMP280_FILTER_OFF
+                       : ((coeff >= x2 && coeff <= x16) ? static_cast<uint8_t>(coeff - 1)
+                                                        : BMP280_CODE_INVALID);
+}
+
+constexpr uint8_t bmp280_mode_code(const Bmp280OperMode mode) {
+  return (Sleep == mode)    ? BMP280_MODE_SLEEP
+         : (Forced == mode) ? BMP280_MODE_FORCED
+         : (Normal == mode) ? BMP280_MODE_NORMAL
+                            : BMP280_CODE_INVALID;
+}
+
+constexpr uint8_t bmp280_standby_code(const Bmp280StandbyTime standbyTime) {
+  return (standbyTime >= t0_5ms && standbyTime <= t4000ms) ? static_cast<uint8_t>(standbyTime)
+                                                           : BMP280_CODE_INVALID;
+}
+
+/**
+ * @brief oversampling, filter, mode and standby settings with their register bytes
+ */
+template <Bmp280Coeff       TempSamp,
+          Bmp280Coeff       PresSamp,
+          Bmp280Coeff       IirFilter,
+          Bmp280OperMode    Mode,
+          Bmp280StandbyTime StandbyTime = t0_5ms>
+struct Bmp280Settings {
+  static_assert(BMP280_CODE_INVALID != bmp280_osrs_code(TempSamp),
+                "invalid temperature oversampling");
+  static_assert(BMP280_CODE_INVALID != bmp280_osrs_code(PresSamp), "invalid pressure oversampling");
+  static_assert(BMP280_CODE_INVALID != bmp280_filter_code(IirFilter),
+                "invalid IIR filter coefficient, x1 is not supported");
+  static_assert(BMP280_CODE_INVALID != bmp280_mode_code(Mode), "invalid power mode");
+  static_assert(BMP280_CODE_INVALID != bmp280_standby_code(StandbyTime), "invalid standby time");
+
+  static constexpr uint8_t ctrlMeasByte = BMP280_CTRL_MEAS_BYTE(
+      bmp280_osrs_code(TempSamp), bmp280_osrs_code(PresSamp), bmp280_mode_code(Mode));
+  static constexpr uint8_t configByte =
+      BMP280_CONFIG_BYTE(bmp280_standby_code(StandbyTime), bmp280_filter_code(IirFilter));
+};
+
+// the predefined settings of bmp280_create_predefined_settings
+using Bmp280HandLow     = Bmp280Settings<x2, x16, x4, Normal, t62_5ms>;
+using Bmp280HandDynamic = Bmp280Settings<x1, x4, x16, Normal, t0_5ms>;
+using Bmp280WeatherStat = Bmp280Settings<x1, x1, x0, Forced>;
+using Bmp280ElevDetec   = Bmp280Settings<x1, x4, x4, Normal, t125ms>;
+using Bmp280DropDetec   = Bmp280Settings<x1, x2, x0, Normal, t0_5ms>;
+using Bmp280IndoorNav   = Bmp280Settings<x2, x16, x16, Normal, t0_5ms>;
+
+/**
+ * @brief I2C0 transport for a bmp280 at Address, one attempt per transfer
+ */
+template <uint8_t Address>
+struct Bmp280I2c {
+  static Bmp280ErrCode open() {
+    return (I2C0_NO_ERR == i2c0_open()) ? ERR_NO_ERR : ERR_PORT_NOT_OPEN;
+  }
+
+  static Bmp280ErrCode close() {
+    return (I2C0_NO_ERR == i2c0_close()) ? ERR_NO_ERR : ERR_BUS_FAIL;
+  }
+
+  static bool read(const uint8_t startAddr, uint8_t* regData, const uint8_t totalRegister) {
+    return bmp280_i2c0_read(NULL, Address, startAddr, regData, totalRegister);
+  }
+
+  static bool write(const uint8_t regAddr, const uint8_t regData) {
+    return bmp280_i2c0_write(NULL, Address, regAddr, regData);
+  }
+
+  static void recover() { bmp280_i2c0_recover(NULL); }
+};
+
+/**
+ * @brief SSI0 transport, chip select on PA3, opened with the settings of bmp280_bus_spi0
+ */
+struct Bmp280Spi {
+  static Bmp280ErrCode open() {
+    return bmp280_bus_spi0()->ops->open(NULL) ? ERR_NO_ERR : ERR_PORT_NOT_OPEN;
+  }
+
+  static Bmp280ErrCode close() {
+    return (SPI_ERR_NO_ERR == spi_close()) ? ERR_NO_ERR : ERR_BUS_FAIL;
+  }
+
+  static bool read(const uint8_t startAddr, uint8_t* regData, const uint8_t totalRegister) {
+    return bmp280_spi0_read(NULL, 0, startAddr, regData, totalRegister);
+  }
+
+  static bool write(const uint8_t regAddr, const uint8_t regData) {
+    return bmp280_spi0_write(NULL, 0, regAddr, regData);
+  }
+
+  static void recover() {}  // SPI has no bus state to recover, the transfer is only repeated
+};
+
+/**
+ * @brief a bmp280 on Transport running with Settings
+ */
+template <class Transport, class Settings>
+class Bmp280 {
+ public:
+  Bmp280() : calibParam(), isCalibLoaded(false) {}
+
+  Bmp280ErrCode open() { return Transport::open(); }
+
+  Bmp280ErrCode close() { return Transport::close(); }
+
+  Bmp280ErrCode get_id(uint8_t* returnID) { return read_register(BMP280_IDARR, returnID, 1); }
+
+  /**
+   * @brief soft reset, return once im_update clears, same as bmp280_reset_wait: timed on the cycle
+   * counter, bounded by a count of status reads only on a part without it
+   */
+  Bmp280ErrCode reset(uint32_t* wakeTimeUs = NULL) {
+    BMP280_TRY_FUNC(write_register(BMP280_RESADDR, BMP280_RESET_CMD));
+    bool     isTimed    = cycle_counter_open();
+    uint32_t startCycle = isTimed ? cycle_counter_get() : 0;
+    uint32_t totalPoll  = 0;
+    bool     isUpdating = true;
+    while (isUpdating) {
+      bool isOver = isTimed ? cycle_counter_elapsed_us(startCycle) > BMP280_RESET_TIMEOUT_US
+                            : totalPoll >= BMP280_RESET_MAX_POLL;
+      if (isOver) { return ERR_RESET_TIMEOUT; }
+      BMP280_TRY_FUNC(get_status(NULL, &isUpdating));
+      ++totalPoll;
+    }
+    if (NULL != wakeTimeUs) { *wakeTimeUs = isTimed ? cycle_counter_elapsed_us(startCycle) : 0; }
+    return ERR_NO_ERR;
+  }
+
+  /**
+   * @brief write config then ctrl_meas, both bytes are compile time constants
+   */
+  Bmp280ErrCode update_setting() {
+    BMP280_TRY_FUNC(write_register(BMP280_BASEADDR + Config, Settings::configByte));
+    BMP280_TRY_FUNC(write_register(BMP280_BASEADDR + Ctrl_meas, Settings::ctrlMeasByte));
+    return ERR_NO_ERR;
+  }
+
+  Bmp280ErrCode get_status(bool* isMeasuring, bool* isUpdating) {
+    uint8_t statusReturn;
+    BMP280_TRY_FUNC(read_register(BMP280_BASEADDR + Status, &statusReturn, 1));
+    if (NULL != isMeasuring) { *isMeasuring = statusReturn & BMP280_MEASURING_MASK; }
+    if (NULL != isUpdating) { *isUpdating = statusReturn & BMP280_UPDATING_MASK; }
+    return ERR_NO_ERR;
+  }
+
+  Bmp280ErrCode get_calibration_data(Bmp280CalibParam* calibParamReturn = NULL) {
+    uint8_t rawCalibData[BMP280_CALIB_DATA_SIZE];
+    BMP280_TRY_FUNC(read_register(BMP280_CALIB_START_ADDR, rawCalibData, sizeof(rawCalibData)));
+    bmp280_get_calib_param(rawCalibData, &calibParam);
+    isCalibLoaded = true;
+    if (NULL != calibParamReturn) { *calibParamReturn = calibParam; }
+    return ERR_NO_ERR;
+  }
+
+  /**
+   * @brief read pressure and temperature in one 6 byte burst and compensate them
+   * @param temperatureC return temperature
+   * @param pressPa return pressure
+   */
+  Bmp280ErrCode get_temp_press(float* temperatureC, float* pressPa) {
+    if (!isCalibLoaded) { BMP280_TRY_FUNC(get_calibration_data()); }
+
+    uint8_t rawData[RAW_PRESS_TOTAL_BYTE + RAW_TEM_TOTAL_BYTE];
+    BMP280_TRY_FUNC(read_register(BMP280_BASEADDR + Press_msb, rawData, sizeof(rawData)));
+
+    // temperature has to be compensated first since it refreshes t_fine, the integers are turned
+    // into floats at the end like in bmp280_get_temp_press
+    int32_t temperatureCentiC =
+        bmp280_compensate_T_int32(parse_raw_adc(&rawData[RAW_PRESS_TOTAL_BYTE]), &calibParam);
+    uint32_t pressQ24_8 = bmp280_compensate_P_int64(parse_raw_adc(&rawData[0]), &calibParam);
+    *temperatureC       = static_cast<float>(temperatureCentiC) * 0.01;
+    *pressPa            = static_cast<float>(pressQ24_8) / 256.0;
+    return ERR_NO_ERR;
+  }
+
+ private:
+  /**
+   * @brief a failed transfer is tried again up to BMP280_BUS_MAX_RETRY times with the bus
+   * recovered first, as in bmp280_get_register and bmp280_write_register
+   */
+  static Bmp280ErrCode read_register(const uint8_t startAddr,
+                                     uint8_t*      regData,
+                                     const uint8_t totalRegister) {
+    bool isDone = Transport::read(startAddr, regData, totalRegister);
+    for (uint8_t retryIndex = 0; !isDone && retryIndex < BMP280_BUS_MAX_RETRY; ++retryIndex) {
+      Transport::recover();
+      isDone = Transport::read(startAddr, regData, totalRegister);
+    }
+    return isDone ? ERR_NO_ERR : ERR_BUS_FAIL;
+  }
+
+  static Bmp280ErrCode write_register(const uint8_t regAddr, const uint8_t regData) {
+    bool isDone = Transport::write(regAddr, regData);
+    for (uint8_t retryIndex = 0; !isDone && retryIndex < BMP280_BUS_MAX_RETRY; ++retryIndex) {
+      Transport::recover();
+      isDone = Transport::write(regAddr, regData);
+    }
+    return isDone ? ERR_NO_ERR : ERR_BUS_FAIL;
+  }
+
+  static int32_t parse_raw_adc(const uint8_t* rawData) {
+    return static_cast<int32_t>((static_cast<uint32_t>(rawData[0]) << 12) |
+                                (static_cast<uint32_t>(rawData[1]) << 4) |
+                                (static_cast<uint32_t>(rawData[2]) >> 4));
+  }
+
+  Bmp280CalibParam calibParam;
+  bool             isCalibLoaded;
+};
+
+#endif
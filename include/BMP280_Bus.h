@@ -0,0 +1,86 @@
+/**
+ * @brief register transport of a bmp280 behind function pointers, so one driver handle can sit on
+ * the TivaC I2C0 or SPI0 peripheral, a simulated bus or a remote one
+ *
+ * Everything a transfer changes (peripheral registers, bus counters, the state of the devices on
+ * the bus) belongs to the bus. The driver takes the bus lock around each register transfer with
+ * its retries, so handles on the same bus can be used from different threads as long as each
+ * handle is used by one thread at a time
+ *
+ * @file BMP280_Bus.h
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#ifndef _BMP280_BUS_H
+#define _BMP280_BUS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "include/Bus_Stats.h"
+
+/**
+ * @brief mutual exclusion for one bus, see host/Host_BusLock.h for a pthread one
+ */
+typedef struct {
+  void (*lock)(void* context);
+  void (*unlock)(void* context);
+  void* context;
+} BusLock;
+
+/**
+ * @brief operations of a bus, address is the I2C address of the device and unused on SPI
+ */
+typedef struct {
+  bool (*open)(void* context);
+  void (*close)(void* context);
+  bool (*is_open)(void* context);
+  bool (*read)(void*         context,
+               const uint8_t address,
+               const uint8_t startAddr,
+               uint8_t*      regData,
+               const uint8_t totalRegister);
+  bool (*write)(void* context, const uint8_t address, const uint8_t regAddr, const uint8_t regData);
+  void (*recover)(void* context);  //!< called before a retry, NULL if there is nothing to recover
+  void (*get_stats)(void* context, BusStats* stats);  //!< NULL if the bus keeps no counters
+  void (*reset_stats)(void* context);
+} Bmp280BusOps;
+
+typedef struct {
+  const Bmp280BusOps* ops;
+  void*               context;
+  const BusLock*      lock;  //!< NULL for a bus used from one thread only
+} Bmp280Bus;
+
+// the TivaC peripherals, the default bus of bmp280_init for I2C and SPI
+Bmp280Bus* bmp280_bus_i2c0(void);
+Bmp280Bus* bmp280_bus_spi0(void);
+
+// the transfers behind those two, for a caller that binds the bus at compile time such as
+// BMP280.hpp, context is unused
+bool bmp280_i2c0_read(void*         context,
+                      const uint8_t address,
+                      const uint8_t startAddr,
+                      uint8_t*      regData,
+                      const uint8_t totalRegister);
+bool bmp280_i2c0_write(void*         context,
+                       const uint8_t address,
+                       const uint8_t regAddr,
+                       const uint8_t regData);
+void bmp280_i2c0_recover(void* context);
+bool bmp280_spi0_read(void*         context,
+                      const uint8_t address,
+                      const uint8_t startAddr,
+                      uint8_t*      regData,
+                      const uint8_t totalRegister);
+bool bmp280_spi0_write(void*         context,
+                       const uint8_t address,
+                       const uint8_t regAddr,
+                       const uint8_t regData);
+
+// lock or unlock the bus, nothing happens if it has no lock
+void bmp280_bus_lock(const Bmp280Bus* bus);
+void bmp280_bus_unlock(const Bmp280Bus* bus);
+
+#endif
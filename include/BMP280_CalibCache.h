@@ -0,0 +1,43 @@
+/**
+ * @brief calibration cache that lets a cold start skip reading the whole calibration block
+ *
+ * @file BMP280_CalibCache.h
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#ifndef _BMP280_CALIB_CACHE_H
+#define _BMP280_CALIB_CACHE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "include/BMP280_Drv.h"
+
+/**
+ * @brief number of calibration bytes read from the sensor to validate a cached block
+ */
+#define BMP280_CALIB_CHECK_SIZE 4
+
+/**
+ * @brief storage backend of the cache, read and write return false on failure
+ *
+ * The cache reads and writes a single record of a fixed size, the backend only needs to keep the
+ * bytes, validation is done by the cache
+ */
+typedef struct {
+  bool (*read)(void* context, uint8_t* data, const uint16_t size);
+  bool (*write)(void* context, const uint8_t* data, const uint16_t size);
+  void* context;
+} Bmp280CalibStore;
+
+// load calibration into the sensor struct from the store if it matches the sensor, otherwise read
+// it from the sensor and refresh the store, isCacheHit can be NULL
+Bmp280ErrCode bmp280_load_calibration_cached(bmp280*                 sensor,
+                                             const Bmp280CalibStore* store,
+                                             bool*                   isCacheHit);
+
+// store backed by the TM4C EEPROM, eeprom_open has to be called before the store is used
+void bmp280_calib_store_eeprom(Bmp280CalibStore* store, const uint32_t eepromAddress);
+
+#endif
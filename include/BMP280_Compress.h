@@ -0,0 +1,70 @@
+/**
+ * @brief block compressor for streams of raw bmp280 samples, for uplinks that charge per byte
+ *
+ * Samples are gathered into blocks of up to BMP280_COMPRESS_BLOCK. Each channel of a block is
+ * stored as zig-zag coded deltas from the previous sample, either as LEB128 varints or bit packed
+ * at the width of the largest delta, whichever is shorter. Every keyInterval blocks a keyframe
+ * carries the first sample in full so a decoder can start or resync there, the blocks in between
+ * need the one before them. All the state is in the encoder struct, about 270 bytes
+ *
+ *   block     flags | sample count | keyframe: 5 bytes packed like BMP280_RawLog |
+ *             pressure channel | temperature channel
+ *   flags     bit 7 keyframe, bit 6 pressure bit packed, bit 5 temperature bit packed
+ *   channel   varints, or a width byte followed by the deltas bit packed lsb first
+ *
+ * @file BMP280_Compress.h
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#ifndef _BMP280_COMPRESS_H
+#define _BMP280_COMPRESS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define BMP280_COMPRESS_BLOCK 32
+#define BMP280_COMPRESS_KEYFRAME 0x80
+#define BMP280_COMPRESS_PRESS_PACKED 0x40
+#define BMP280_COMPRESS_TEMP_PACKED 0x20
+
+// flags, count, keyframe and two channels of 3 byte varints, the worst case of a 20 bit delta
+#define BMP280_COMPRESS_MAX_BLOCK (2 + 5 + 2 * 3 * BMP280_COMPRESS_BLOCK)
+
+typedef struct {
+  int32_t  rawTemp[BMP280_COMPRESS_BLOCK];
+  int32_t  rawPress[BMP280_COMPRESS_BLOCK];
+  uint8_t  total;        //!< samples in the current block
+  uint16_t keyInterval;  //!< blocks from one keyframe to the next, 1 makes every block a keyframe
+  uint16_t sinceKey;     //!< blocks written since the last keyframe
+  int32_t  lastTemp;     //!< last sample of the previous block
+  int32_t  lastPress;
+} Bmp280CompressEncoder;
+
+typedef struct {
+  bool    hasKeyframe;
+  int32_t lastTemp;
+  int32_t lastPress;
+} Bmp280CompressDecoder;
+
+void bmp280_compress_init(Bmp280CompressEncoder* encoder, const uint16_t keyInterval);
+// add a sample, return the size of the block written to block once it is full, 0 before
+uint16_t bmp280_compress_add(Bmp280CompressEncoder* encoder,
+                             const int32_t          rawTemp,
+                             const int32_t          rawPress,
+                             uint8_t                block[BMP280_COMPRESS_MAX_BLOCK]);
+// write the samples gathered so far as a shorter block, 0 if there are none
+uint16_t bmp280_compress_flush(Bmp280CompressEncoder* encoder,
+                               uint8_t                block[BMP280_COMPRESS_MAX_BLOCK]);
+
+void bmp280_decompress_init(Bmp280CompressDecoder* decoder);
+// decode one block into rawTemp and rawPress, which hold BMP280_COMPRESS_BLOCK samples, return the
+// bytes used or 0 if the block is malformed or a delta block comes before any keyframe
+uint16_t bmp280_decompress_block(Bmp280CompressDecoder* decoder,
+                                 const uint8_t*         block,
+                                 const uint32_t         size,
+                                 int32_t*               rawTemp,
+                                 int32_t*               rawPress,
+                                 uint8_t*               totalSample);
+
+#endif
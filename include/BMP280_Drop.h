@@ -0,0 +1,71 @@
+/**
+ * @brief drop and free fall detection on the pressure stream of the DropDetec preset, cheap
+ * enough to run in the interrupt that reads the samples
+ *
+ * The descent speed is the difference between the mean pressure of the last span samples and
+ * the mean of the span samples before them, compared with thresholds turned into pressure sums
+ * once at init, so a sample costs a few additions and no multiply, division or floating point.
+ * The drop starts after confirm samples in a row at or over enterMmS and ends on the first
+ * sample under exitMmS, the callback is called on both. The estimate is the speed weighted over
+ * the last 2 * span samples, so a step of the descent speed to enterMmS or more is reported at
+ * most 2 * span + confirm - 1 samples later, a wider span trades that latency for less noise
+ *
+ * Speeds become pressure rates through the slope of the barometric formula at the typical
+ * pressure of the site, within a few percent over the first thousand meters around it
+ *
+ * @file BMP280_Drop.h
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#ifndef _BMP280_DROP_H
+#define _BMP280_DROP_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define BMP280_DROP_MAX_SPAN 16
+#define BMP280_DROP_MAX_SPEED_MM_S 100000
+#define BMP280_DROP_MAX_PERIOD_US 10000000
+
+// called from bmp280_drop_add, so from the interrupt if that is where it runs
+typedef void (*Bmp280DropCallback)(void* context, const bool isFalling);
+
+typedef struct {
+  uint32_t periodUs;   //!< time between two samples, up to BMP280_DROP_MAX_PERIOD_US
+  uint32_t ambientQ8;  //!< typical pressure of the site, Q24.8 Pa within 300 to 1100 hPa
+  uint32_t enterMmS;   //!< descent speed that starts a drop
+  uint32_t exitMmS;    //!< descent speed under which the drop ends, less than enterMmS
+  uint8_t  span;       //!< samples per mean, 1 to BMP280_DROP_MAX_SPAN
+  uint8_t  confirm;    //!< samples in a row over enterMmS before the drop starts, at least 1
+} Bmp280DropConfig;
+
+typedef struct {
+  uint32_t pressQ8[2 * BMP280_DROP_MAX_SPAN];  //!< ring of the last 2 * span samples
+  uint32_t recentSum;                          //!< the last span samples
+  uint32_t olderSum;                           //!< the span samples before them
+  int64_t  enterSum;                           //!< recentSum - olderSum at enterMmS
+  int64_t  exitSum;
+  uint8_t  span;
+  uint8_t  confirm;
+  uint8_t  head;         //!< slot of the oldest sample
+  uint8_t  totalSample;  //!< up to 2 * span, no detection until the ring is full
+  uint8_t  overCount;    //!< samples in a row over enterSum
+  bool     isFalling;
+
+  Bmp280DropCallback callback;  //!< NULL to only poll the return of bmp280_drop_add
+  void*              context;
+} Bmp280Drop;
+
+// false if a value of config is out of range
+bool bmp280_drop_init(Bmp280Drop*             drop,
+                      const Bmp280DropConfig* config,
+                      Bmp280DropCallback      callback,
+                      void*                   context);
+// forget the samples, e.g. after a gap in the stream, without calling the callback
+void bmp280_drop_reset(Bmp280Drop* drop);
+
+// pressure of the next sample from bmp280_get_temp_press_fixed, true while falling
+bool bmp280_drop_add(Bmp280Drop* drop, const uint32_t pressQ8);
+
+#endif
@@ -12,7 +12,12 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+#include "include/BMP280_Bus.h"
 #include "include/BMP280_Ware.h"
+#include "include/Bus_Stats.h"
+#include "include/Bus_Trace.h"
+#include "include/Latency_Hist.h"
+#include "include/Time_Source.h"
 
 /**
  * @brief enum of all the sensors' settings and error code
@@ -47,6 +52,21 @@ typedef enum { Uninitialized = -1, UltraLow, Low, Standard, UltraHigh } Bmp280Sa
  */
 typedef enum { Uninitialized_coeff = -1, x0, x1, x2, x4, x8, x16 } Bmp280Coeff;
 
+/**
+ * @brief inactive time between two measurements in normal mode, t0_5ms is 0.5 ms
+ */
+typedef enum {
+  Uninitialized_standby = -1,
+  t0_5ms,
+  t62_5ms,
+  t125ms,
+  t250ms,
+  t500ms,
+  t1000ms,
+  t2000ms,
+  t4000ms
+} Bmp280StandbyTime;
+
 /**
  * @brief error code for the bmp280
  */
@@ -55,7 +75,10 @@ typedef enum {
   ERR_PORT_NOT_OPEN,
   ERR_SETTING_UNITIALIZED,
   ERR_SETTING_UNRECOGNIZED,
-  ERR_SENSOR_UNITIALIZED  //!< indicate that bmp280 struct is not valid
+  ERR_SENSOR_UNITIALIZED,  //!< indicate that bmp280 struct is not valid
+  ERR_CALIB_STORE_FAIL,    //!< calibration cache couldn't be written, calibration is still loaded
+  ERR_RESET_TIMEOUT,       //!< the bmp280 didn't finish copying its NVM after a reset
+  ERR_BUS_FAIL             //!< the i2c/spi transfer failed
 } Bmp280ErrCode;
 
 /**
@@ -66,6 +89,30 @@ typedef struct {
   bool isUpdating;
 } Bmp280Status;
 
+/**
+ * @brief per sensor counters, see bmp280_get_stats
+ */
+typedef struct {
+  uint32_t sample;        //!< successful reads of the data registers
+  uint32_t compensation;  //!< temperature and pressure compensations, 2 for a combined read
+  uint32_t failedRead;    //!< reads of the data registers that returned an error
+  uint32_t retry;         //!< register transfers repeated after a bus error
+
+  //!< filled only while a time source is set, see bmp280_set_time_source
+  LatencyHist readLatency;  //!< whole bmp280_get_temp/press call
+  LatencyHist busTime;      //!< transfer of the data registers
+  LatencyHist compTime;     //!< compensation of the raw values
+  LatencyHist sampleAge;    //!< end of the conversion to delivery of the sample
+} Bmp280SensorStats;
+
+/**
+ * @brief counters of a sensor together with the counters of the bus it is on
+ */
+typedef struct {
+  Bmp280SensorStats sensor;
+  BusStats          bus;
+} Bmp280Stats;
+
 /**
  * @brief data structure of a bmp280
  */
@@ -74,6 +121,7 @@ typedef struct bmp280Sensor {
   uint8_t           ID;
   uint8_t           address;
   Bmp280ComProtocol protocol;
+  const Bmp280Bus*  bus;  //!< the TivaC peripheral of the protocol unless bmp280_set_bus moved it
 
   //!< oversampling settings
   Bmp280Coeff         tempSamp;
@@ -82,13 +130,40 @@ typedef struct bmp280Sensor {
   Bmp280SamplSettings samplSet;
   Bmp280OperMode      mode;
 
-  float standbyTime;  //!< unit is ms, check the data sheet for list of allowed values
+  Bmp280StandbyTime standbyTime;
+
+  //!< register bytes encoding the settings above, written by bmp280_update_setting
+  uint8_t ctrlMeasByte;
+  uint8_t configByte;
 
   Bmp280Status lastKnowStatus;
+
+  //!< factory calibration, loaded from the sensor on the first read
+  Bmp280CalibParam calibParam;
+  bool             isCalibLoaded;
+
+  //!< pressure-only reads done since calibParam.t_fine was last refreshed
+  uint8_t tFineAge;
+  //!< how many pressure-only reads may reuse t_fine, 0 means always read temperature too
+  uint8_t tFineMaxAge;
+
+  //!< clock used to timestamp samples, NULL leaves the timestamps at 0
+  const TimeSource* timeSource;
+  uint32_t          conversionAnchorUs;  //!< end of a conversion the later ones are scheduled from
+  uint32_t          conversionDoneUs;    //!< estimated end of the conversion of the last sample
+  uint32_t          deliveredUs;         //!< when the last sample was returned to the caller
+
+  //!< every register transfer is recorded here, NULL turns tracing off
+  BusTrace* trace;
+
+#if BUS_STATS_ENABLE
+  Bmp280SensorStats stats;
+#endif
 } bmp280;
 
 /*functions used for beginning or wrapping up communications*/
-// initialized the bmp280 struct with either predefined settings or customized
+// initialized the bmp280 struct with either predefined settings or customized, settings must be
+// changed through these so the register bytes are kept in sync
 // calling this functions will not result in a write to the hardware
 Bmp280ErrCode bmp280_create_predefined_settings(bmp280*                     sensor,
                                                 const Bmp280MeasureSettings settings);
@@ -110,20 +185,41 @@ Bmp280ErrCode bmp280_update_setting(bmp280* sensor);
 Bmp280ErrCode bmp280_get_id(bmp280* sensor, uint8_t* ID);
 Bmp280ErrCode bmp280_get_temp(bmp280* sensor, float* temperature);
 Bmp280ErrCode bmp280_get_press(bmp280* sensor, float* pressure);
-Bmp280ErrCode bmp280_get_temp_press(bmp280*          sensor,
-                                    float*           temperatureC,
-                                    float*           pressPa,
-                                    Bmp280CalibParam calibParam);
+Bmp280ErrCode bmp280_get_temp_press(bmp280* sensor, float* temperatureC, float* pressPa);
+// 0.01 C and Q24.8 Pa straight from the integer compensation
+Bmp280ErrCode bmp280_get_temp_press_fixed(bmp280*   sensor,
+                                          int32_t*  temperatureCentiC,
+                                          uint32_t* pressQ24_8);
+Bmp280ErrCode bmp280_get_raw_temp_press(bmp280* sensor, int32_t* rawTemp, int32_t* rawPress);
+Bmp280ErrCode bmp280_set_tfine_max_age(bmp280* sensor, const uint8_t maxAge);
 Bmp280ErrCode bmp280_reset(bmp280* sensor);
+Bmp280ErrCode bmp280_reset_wait(bmp280* sensor, uint32_t* wakeTimeUs);
 Bmp280ErrCode bmp280_get_ctr_meas(bmp280* sensor, uint8_t* ctrlMeasRtr);
 Bmp280ErrCode bmp280_get_config(bmp280* sensor, uint8_t* configReturn);
 Bmp280ErrCode bmp280_get_calibration_data(bmp280* sensor, Bmp280CalibParam* calibParam);
 Bmp280ErrCode bmp280_get_status(bmp280* sensor);
+
+// counters of the sensor and of its bus, all 0 when built with BUS_STATS_ENABLE=0
+Bmp280ErrCode bmp280_get_stats(bmp280* sensor, Bmp280Stats* stats);
+Bmp280ErrCode bmp280_reset_stats(bmp280* sensor);  // also resets the bus counters
+
+// timestamp samples with source, NULL turns timing off, the source must outlive the sensor. The
+// reset is timed with it, or else with the DWT cycle counter
+Bmp280ErrCode bmp280_set_time_source(bmp280* sensor, const TimeSource* source);
+// when the last sample finished converting and when it was delivered, either can be NULL
+Bmp280ErrCode bmp280_get_sample_time(bmp280*   sensor,
+                                     uint32_t* conversionDoneUs,
+                                     uint32_t* deliveredUs);
+// put the sensor on another bus before bmp280_open, NULL goes back to the TivaC peripheral
+Bmp280ErrCode bmp280_set_bus(bmp280* sensor, const Bmp280Bus* bus);
+// record every register transfer into trace, NULL turns tracing off, the trace must outlive the
+// sensor
+Bmp280ErrCode bmp280_set_trace(bmp280* sensor, BusTrace* trace);
 Bmp280ErrCode bmp280_create_custom_setting(bmp280*                   sensor,
                                            const Bmp280Coeff         tempSamp,
                                            const Bmp280Coeff         presSamp,
                                            const Bmp280Coeff         iirFilter,
                                            const Bmp280SamplSettings samplSet,
                                            const Bmp280OperMode      mode,
-                                           const float               standbyTime);
+                                           const Bmp280StandbyTime   standbyTime);
 #endif
\ No newline at end of file
@@ -0,0 +1,47 @@
+/**
+ * @brief the IIR filter of the bmp280 in software, so the sensor can run with its filter off and
+ * give one unfiltered stream for event detection next to filtered ones at any coefficient
+ *
+ * Each stage runs the recurrence of the datasheet, filtered = (filtered * (c - 1) + value) / c,
+ * as filtered += (value - filtered) >> log2(c), the same result with the division rounded down
+ * and no multiply. Fed the 20 bit raw values of a sensor whose filter is off, a stage gives the
+ * datasheet recurrence at that coefficient on them, starting from the first sample like the filter
+ * does after a write to config, and reaches 75 % of a step after the samples of the datasheet's
+ * table. The chip doesn't document its rounding and likely keeps more bits in its filter memory,
+ * the recurrence without rounding stays within c - 1 raw LSB of about 0.16 Pa of a stage (see
+ * bench_iir). Compensated values can be filtered too, the rounding down then happens on their
+ * finer scale
+ *
+ * @file BMP280_Iir.h
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#ifndef _BMP280_IIR_H
+#define _BMP280_IIR_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "include/BMP280_Drv.h"
+
+#define BMP280_IIR_MAX_STAGE 5  // x0, x2, x4, x8 and x16 at once
+
+typedef struct {
+  int32_t state[BMP280_IIR_MAX_STAGE];
+  uint8_t shift[BMP280_IIR_MAX_STAGE];  //!< log2 of the coefficient, 0 for the filter off
+  uint8_t totalStage;
+  bool    hasSample;
+} Bmp280Iir;
+
+// one stage per coefficient, the values of iirFilter from x0 to x16 except x1, false for x1 or
+// more than BMP280_IIR_MAX_STAGE stages
+bool bmp280_iir_init(Bmp280Iir* iir, const Bmp280Coeff* coeff, const uint8_t totalStage);
+// start again from the next sample
+void bmp280_iir_reset(Bmp280Iir* iir);
+
+// run value through every stage
+void    bmp280_iir_add(Bmp280Iir* iir, const int32_t value);
+int32_t bmp280_iir_get(const Bmp280Iir* iir, const uint8_t stage);
+
+#endif
@@ -0,0 +1,54 @@
+/**
+ * @brief compensation of many bmp280s at once for a gateway, calibration kept one array per
+ * coefficient with one lane per sensor
+ *
+ * bmp280_multi_compensate runs the integer formulas of BMP280_Ware over every lane, the
+ * temperature pass is plain 32 bit arithmetic the compiler can vectorize and the pressure pass
+ * reads each coefficient from its own contiguous array. Results are bit for bit those of
+ * bmp280_get_temp_press with the same calibration and raw values
+ *
+ * @file BMP280_Multi.h
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#ifndef _BMP280_MULTI_H
+#define _BMP280_MULTI_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "include/BMP280_Ware.h"
+
+#ifndef BMP280_MULTI_MAX_SENSOR
+#define BMP280_MULTI_MAX_SENSOR 256
+#endif
+
+typedef struct {
+  uint16_t dig_t1[BMP280_MULTI_MAX_SENSOR];
+  int16_t  dig_t2[BMP280_MULTI_MAX_SENSOR];
+  int16_t  dig_t3[BMP280_MULTI_MAX_SENSOR];
+  uint16_t dig_p1[BMP280_MULTI_MAX_SENSOR];
+  int16_t  dig_p2[BMP280_MULTI_MAX_SENSOR];
+  int16_t  dig_p3[BMP280_MULTI_MAX_SENSOR];
+  int16_t  dig_p4[BMP280_MULTI_MAX_SENSOR];
+  int16_t  dig_p5[BMP280_MULTI_MAX_SENSOR];
+  int16_t  dig_p6[BMP280_MULTI_MAX_SENSOR];
+  int16_t  dig_p7[BMP280_MULTI_MAX_SENSOR];
+  int16_t  dig_p8[BMP280_MULTI_MAX_SENSOR];
+  int16_t  dig_p9[BMP280_MULTI_MAX_SENSOR];
+  int32_t  t_fine[BMP280_MULTI_MAX_SENSOR];  //!< of the last compensation, per lane
+  uint16_t totalSensor;
+} Bmp280MultiCalib;
+
+void bmp280_multi_init(Bmp280MultiCalib* multi);
+// copy the calibration of one sensor into the next lane, false if all lanes are taken
+bool bmp280_multi_add(Bmp280MultiCalib* multi, const Bmp280CalibParam* calibParam, uint16_t* lane);
+// one raw sample per lane in, temperature in C and pressure in Pa per lane out
+void bmp280_multi_compensate(Bmp280MultiCalib* multi,
+                             const int32_t*    rawTemp,
+                             const int32_t*    rawPress,
+                             float*            temperatureC,
+                             float*            pressPa);
+
+#endif
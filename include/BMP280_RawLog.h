@@ -0,0 +1,86 @@
+/**
+ * @brief packed log of raw bmp280 samples, small enough for flash and uplink and recompensated
+ * later with the calibration stored once in the header
+ *
+ * A log is a BMP280_RAW_LOG_HEADER_SIZE byte header followed by records. All fields are little
+ * endian:
+ *
+ *   header  'B' 'R' 'L' version | tick in us (u32) | time of the first record in us (u32) |
+ *           calibration, 24 bytes in the register layout of 0x88..0x9F
+ *   record  time since the previous record in ticks, LEB128 varint |
+ *           adc_P[19:12] | adc_P[11:4] | adc_P[3:0] adc_T[19:16] | adc_T[15:8] | adc_T[7:0]
+ *
+ * With one sample per second and a 1 ms tick a record is 7 bytes, against 12 for two floats and
+ * a u32 timestamp
+ *
+ * @file BMP280_RawLog.h
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#ifndef _BMP280_RAW_LOG_H
+#define _BMP280_RAW_LOG_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "include/BMP280_Ware.h"
+
+#define BMP280_RAW_LOG_VERSION 1
+#define BMP280_RAW_LOG_HEADER_SIZE (12 + BMP280_CALIB_DATA_SIZE)
+#define BMP280_RAW_LOG_ADC_SIZE 5     // two 20 bit adc values
+#define BMP280_RAW_LOG_MAX_RECORD 10  // 5 byte varint and the adc values
+
+/**
+ * @brief one raw sample, timeUs is when its conversion ended
+ */
+typedef struct {
+  uint32_t timeUs;
+  int32_t  rawTemp;
+  int32_t  rawPress;
+} Bmp280RawSample;
+
+/**
+ * @brief state of a log being written, small enough to keep on the MCU
+ */
+typedef struct {
+  uint32_t tickUs;
+  uint32_t lastUs;  //!< time of the previous record rounded to the tick, deltas don't drift
+} Bmp280RawLogEncoder;
+
+/**
+ * @brief state of a log being read
+ */
+typedef struct {
+  Bmp280CalibParam calibParam;
+  uint32_t         tickUs;
+  uint32_t         lastUs;
+} Bmp280RawLogDecoder;
+
+/* encoding, header then one record per sample */
+// write the header into header, tickUs is the resolution of the timestamps and must not be 0
+void bmp280_raw_log_start(Bmp280RawLogEncoder*    encoder,
+                          const Bmp280CalibParam* calibParam,
+                          const uint32_t          startUs,
+                          const uint32_t          tickUs,
+                          uint8_t                 header[BMP280_RAW_LOG_HEADER_SIZE]);
+// write one record into record, return its size
+uint8_t bmp280_raw_log_encode(Bmp280RawLogEncoder*   encoder,
+                              const Bmp280RawSample* sample,
+                              uint8_t                record[BMP280_RAW_LOG_MAX_RECORD]);
+
+/* decoding */
+bool bmp280_raw_log_open(Bmp280RawLogDecoder* decoder, const uint8_t* log, const uint32_t size);
+// decode the record at offset, return the offset of the next one or 0 if it is cut short
+uint32_t bmp280_raw_log_decode(Bmp280RawLogDecoder* decoder,
+                               const uint8_t*       log,
+                               const uint32_t       size,
+                               const uint32_t       offset,
+                               Bmp280RawSample*     sample);
+// compensate a decoded sample with the calibration of the log
+void bmp280_raw_log_compensate(Bmp280RawLogDecoder*   decoder,
+                               const Bmp280RawSample* sample,
+                               float*                 temperatureC,
+                               float*                 pressPa);
+
+#endif
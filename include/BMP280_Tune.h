@@ -0,0 +1,73 @@
+/**
+ * @brief pick the oversampling, IIR filter and standby time of normal mode from what the consumer
+ * of the samples needs, and predict the rate, latency, noise and current of any setting
+ *
+ * The predictions follow the datasheet:
+ *
+ *   rate     1 / (measurement time + standby time), typical measurement time from
+ *            bmp280_measure_time_us
+ *   noise    6.6 Pa RMS at x1 pressure oversampling divided by sqrt(osrs_p), the IIR filter at
+ *            coefficient c divides the variance by 2c - 1
+ *   latency  from a pressure step to an output with 75% of it, at worst: the step just misses a
+ *            conversion, so a period, the measurement and n - 1 more periods, n being 1, 2, 5, 11
+ *            or 22 samples with the filter off or at x2 to x16
+ *   current  per conversion 325 uA through the start-up and the temperature measurement, 720 uA
+ *            through the pressure one, 0.2 uA in standby, within a few percent of the 1 Hz
+ *            figures of the datasheet
+ *
+ * The temperature oversampling is the one the datasheet recommends, x2 with x16 on pressure and
+ * x1 otherwise. Of the settings that sample at least as fast as the target, stay within the noise
+ * budget and the latency, the one drawing the least current is picked, ties going to less noise
+ *
+ * @file BMP280_Tune.h
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#ifndef _BMP280_TUNE_H
+#define _BMP280_TUNE_H
+
+#include "include/BMP280_Drv.h"
+
+/**
+ * @brief why no setting meets the target, the result then holds the closest one
+ */
+typedef enum {
+  TUNE_OK,
+  TUNE_ODR_UNREACHABLE,      //!< nothing samples that fast, result is the fastest setting
+  TUNE_NOISE_UNREACHABLE,    //!< nothing that fast is that quiet, result is the quietest
+  TUNE_LATENCY_UNREACHABLE,  //!< nothing that fast responds that quickly, result is the quickest
+  TUNE_CONFLICT              //!< not both noise and latency, result is the quietest in the latency
+} Bmp280TuneStatus;
+
+typedef struct {
+  float odrHz;         //!< samples per second the consumer needs, 0 for any
+  float maxLatencyMs;  //!< 0 for no limit
+  float maxNoisePa;    //!< RMS pressure noise, 0 for no limit
+} Bmp280TuneTarget;
+
+typedef struct {
+  Bmp280Coeff         tempSamp;
+  Bmp280Coeff         presSamp;
+  Bmp280Coeff         iirFilter;
+  Bmp280SamplSettings samplSet;
+  Bmp280OperMode      mode;         //!< Normal from bmp280_tune, that of the sensor when predicted
+  Bmp280StandbyTime   standbyTime;  //!< not part of the rate when mode is Forced
+
+  float odrHz;
+  float latencyMs;
+  float noisePa;
+  float currentUa;
+} Bmp280TuneResult;
+
+// the best normal mode setting for target, result is filled whatever the status
+Bmp280TuneStatus bmp280_tune(const Bmp280TuneTarget* target, Bmp280TuneResult* result);
+
+// give the sensor the setting of result in normal mode, then bmp280_update_setting writes it
+Bmp280ErrCode bmp280_tune_apply(bmp280* sensor, const Bmp280TuneResult* result);
+
+// predictions for the settings of sensor, e.g. a preset, a sensor in forced mode is taken as
+// converting back to back
+Bmp280ErrCode bmp280_tune_predict(bmp280* sensor, Bmp280TuneResult* result);
+
+#endif
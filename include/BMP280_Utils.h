@@ -12,6 +12,84 @@
 
 #include "include/BMP280_Drv.h"
 
+// offset from BMP280 base register
+typedef enum {
+  Status = 0,
+  Ctrl_meas,
+  Config,
+  Press_msb = 4,
+  Press_lsb,
+  Press_xlsb,
+  Temp_msb,
+  Temp_lsb,
+  Temp_xlsb
+} bmp280_regName;
+
+// added with the bmp280_regName to get the correct address
+#define BMP280_BASEADDR 0xF3
+
+#define RAW_TEM_TOTAL_BYTE 3
+#define RAW_PRESS_TOTAL_BYTE 3
+#define BMP280_CALIB_START_ADDR 0x88
+
+// the two special addresses
+#define BMP280_RESADDR 0xE0
+#define BMP280_IDARR 0xD0
+
+// bit 7 of the register address selects read (1) or write (0) on SPI
+#define BMP280_SPI_READ_BIT 0x80
+
+#define BMP280_RESET_CMD 0xB6         // obtain from page 24 datasheet
+#define BMP280_RESET_TIMEOUT_US 5000  // NVM copy after reset takes about 2 ms
+// bound of the reset wait on a part without a clock, a status read takes over 1 us on either bus
+#define BMP280_RESET_MAX_POLL BMP280_RESET_TIMEOUT_US
+
+// transfers repeated after a bus error, an I2C bus is recovered before each of them
+#ifndef BMP280_BUS_MAX_RETRY
+#define BMP280_BUS_MAX_RETRY 2
+#endif
+
+// field codes of the ctrl_meas and config registers, datasheet pg 25-26
+#define BMP280_OSRS_SKIP 0x0
+#define BMP280_OSRS_X1 0x1
+#define BMP280_OSRS_X2 0x2
+#define BMP280_OSRS_X4 0x3
+#define BMP280_OSRS_X8 0x4
+#define BMP280_OSRS_X16 0x5
+
+#define BMP280_MODE_SLEEP 0x0
+#define BMP280_MODE_FORCED 0x1
+#define BMP280_MODE_NORMAL 0x3
+
+#define BMP280_STANDBY_0_5MS 0x0
+#define BMP280_STANDBY_62_5MS 0x1
+#define BMP280_STANDBY_125MS 0x2
+#define BMP280_STANDBY_250MS 0x3
+#define BMP280_STANDBY_500MS 0x4
+#define BMP280_STANDBY_1000MS 0x5
+#define BMP280_STANDBY_2000MS 0x6
+#define BMP280_STANDBY_4000MS 0x7
+
+#define BMP280_FILTER_OFF 0x0
+#define BMP280_FILTER_X2 0x1
+#define BMP280_FILTER_X4 0x2
+#define BMP280_FILTER_X8 0x3
+#define BMP280_FILTER_X16 0x4
+
+// marks a setting that has no register code, e.g. x1 for the IIR filter
+#define BMP280_CODE_INVALID 0xFF
+
+#define BMP280_CTRL_MEAS_BYTE(osrsT, osrsP, mode) \
+  ((uint8_t)(((osrsT) << 5) | ((osrsP) << 2) | (mode)))
+// spi3w_en is always 0, the driver only uses 4 wire SPI
+#define BMP280_CONFIG_BYTE(standby, filter) ((uint8_t)(((standby) << 5) | ((filter) << 2)))
+
+#define BMP280_MEASURING_MASK 0x8
+#define BMP280_UPDATING_MASK 0x1
+
+// tFineAge value meaning that t_fine has never been computed
+#define BMP280_TFINE_STALE 0xFF
+
 #define BMP280_TRY_FUNC(funcToExecute)             \
   do {                                             \
     Bmp280ErrCode errCode;                         \
@@ -22,7 +100,11 @@
 /* functions used for creating data byte to write to bmp280 based on bmp280
  settings */
 Bmp280ErrCode bmp280_make_ctrl_byte(bmp280* sensor, uint8_t* controlByte);
-uint8_t       bmp280_make_cfg_byte(bmp280* sensor, uint8_t* returnByte);
+Bmp280ErrCode bmp280_make_cfg_byte(bmp280* sensor, uint8_t* returnByte);
+
+/* timing, typical values from the datasheet pg 18-19 */
+uint32_t bmp280_measure_time_us(const bmp280* sensor);  // one temperature and pressure conversion
+uint32_t bmp280_standby_time_us(const bmp280* sensor);  // t_sb between conversions in normal mode
 
 /* error checking */
 // check for unitialized value in sensor settings
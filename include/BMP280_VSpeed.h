@@ -0,0 +1,69 @@
+/**
+ * @brief vertical position and speed from the altitude stream, an alpha-beta filter in fixed point
+ *
+ * Each sample costs a handful of 64 bit multiplies and no division, the state is a few words
+ * instead of a window of samples to fit a slope to. The gains come from a noise model, the
+ * spread of the vertical acceleration the filter should follow and the noise of the altitude it
+ * is fed, through the tracking index of Kalata:
+ *
+ *   lambda = accelNoise * period^2 / altitudeNoise
+ *   r      = (4 + lambda - sqrt(8 * lambda + lambda^2)) / 4
+ *   alpha  = 1 - r^2, beta = 2 * (2 - alpha) - 4 * sqrt(1 - alpha)
+ *
+ * A larger acceleration noise follows changes faster, a larger altitude noise smooths more. The
+ * gains are made once for the nominal sample period, the prediction uses the time since the last
+ * sample so a late sample doesn't bias the speed
+ *
+ * The position is kept in 64 bits so any altitude of the int32 input fits: BMP280_Altitude gives
+ * -12.4 to 9.7 km over its range, and 300 hPa is 9.2 km above the standard sea level, past the
+ * 8388 m an int32 holds in Q8 mm. The speed is an int32, within 8388 m/s
+ *
+ * The travel since the last sample is speed * elapsed in 64 bits, it holds while the product
+ * stays under 2^63 / 4295 Q8 mm us, 8388 m/s over 1 s or 500 m/s over 16 s. A sample more than
+ * BMP280_VSPEED_MAX_GAP_PERIOD nominal periods after the previous one, e.g. when the sensor was
+ * stopped, starts the filter over at its altitude with no speed instead of predicting across the
+ * gap, so the bound is met for any period up to the 4 s standby as long as the speed stays under
+ * 500 m/s
+ *
+ * @file BMP280_VSpeed.h
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#ifndef _BMP280_VSPEED_H
+#define _BMP280_VSPEED_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define BMP280_VSPEED_MAX_GAP_PERIOD 4
+
+typedef struct {
+  uint32_t alphaQ16;
+  uint32_t betaPerSecondQ16;  //!< beta / period, a residual in mm to a speed correction in mm/s
+  uint32_t maxGapUs;          //!< longer gaps between samples start the filter over
+  int64_t  positionQ8;        //!< mm
+  int32_t  speedQ8;           //!< mm/s, positive going up
+  bool     hasSample;
+} Bmp280VSpeed;
+
+// gains from the noise model for samples every periodUs, false if one of the values is 0
+bool bmp280_vspeed_init(Bmp280VSpeed*  vspeed,
+                        const uint32_t periodUs,
+                        const uint32_t accelNoiseMmS2,
+                        const uint32_t altitudeNoiseMm);
+// or gains picked by hand, alpha and beta in Q16
+bool bmp280_vspeed_init_gains(Bmp280VSpeed*  vspeed,
+                              const uint32_t periodUs,
+                              const uint32_t alphaQ16,
+                              const uint32_t betaQ16);
+
+// elapsedUs is the time since the previous sample, e.g. from bmp280_get_sample_time, longer than
+// BMP280_VSPEED_MAX_GAP_PERIOD periods starts over
+void    bmp280_vspeed_update(Bmp280VSpeed*  vspeed,
+                             const int32_t  altitudeMm,
+                             const uint32_t elapsedUs);
+int32_t bmp280_vspeed_altitude_mm(const Bmp280VSpeed* vspeed);
+int32_t bmp280_vspeed_speed_mm_s(const Bmp280VSpeed* vspeed);
+
+#endif
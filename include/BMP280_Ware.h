@@ -75,8 +75,63 @@ typedef struct {
   int32_t  t_fine;
 } Bmp280CalibParam;
 
-float bmp280_compensate_T_int32(int32_t adc_T, Bmp280CalibParam* calData);
-float bmp280_compensate_P_int64(int32_t adc_P, Bmp280CalibParam* calData);
+// 0.01 C and Q24.8 Pa as in the Bosch reference, integer all the way for parts without an FPU
+int32_t  bmp280_compensate_T_int32(int32_t adc_T, Bmp280CalibParam* calData);
+uint32_t bmp280_compensate_P_int64(int32_t adc_P, Bmp280CalibParam* calData);
+
+/**
+ * @brief fine temperature of the Bosch reference, the coefficients are taken by value so that
+ * callers keeping them in other layouts than Bmp280CalibParam run the same arithmetic
+ */
+static inline int32_t bmp280_calc_t_fine(int32_t  adc_T,
+                                         uint16_t dig_t1,
+                                         int16_t  dig_t2,
+                                         int16_t  dig_t3) {
+  int32_t var1 = ((((adc_T >> 3) - ((int32_t)dig_t1 << 1))) * ((int32_t)dig_t2)) >> 11;
+  int32_t var2 = (((((adc_T >> 4) - ((int32_t)dig_t1)) * ((adc_T >> 4) - ((int32_t)dig_t1))) >>
+                   12) *
+                  ((int32_t)dig_t3)) >>
+                 14;
+  return var1 + var2;
+}
+
+/**
+ * @brief temperature in 0.01 C from the fine temperature
+ */
+static inline int32_t bmp280_calc_centi_c(int32_t t_fine) { return (t_fine * 5 + 128) >> 8; }
+
+/**
+ * @brief pressure in Pa as Q24.8 from the raw reading and the fine temperature, 0 when the
+ * calibration would divide by zero
+ */
+static inline uint32_t bmp280_calc_press_q24_8(int32_t  adc_P,
+                                               int32_t  t_fine,
+                                               uint16_t dig_p1,
+                                               int16_t  dig_p2,
+                                               int16_t  dig_p3,
+                                               int16_t  dig_p4,
+                                               int16_t  dig_p5,
+                                               int16_t  dig_p6,
+                                               int16_t  dig_p7,
+                                               int16_t  dig_p8,
+                                               int16_t  dig_p9) {
+  int64_t var1, var2, p;
+  var1 = ((int64_t)t_fine) - 128000;
+  var2 = var1 * var1 * (int64_t)dig_p6;
+  var2 = var2 + ((var1 * (int64_t)dig_p5) << 17);
+  var2 = var2 + (((int64_t)dig_p4) << 35);
+  var1 = ((var1 * var1 * (int64_t)dig_p3) >> 8) + ((var1 * (int64_t)dig_p2) << 12);
+  var1 = (((((int64_t)1) << 47) + var1)) * ((int64_t)dig_p1) >> 33;
+  if (var1 == 0) {
+    return 0;  // avoid exception caused by division by zero
+  }
+  p    = 1048576 - adc_P;
+  p    = (((p << 31) - var2) * 3125) / var1;
+  var1 = (((int64_t)dig_p9) * (p >> 13) * (p >> 13)) >> 25;
+  var2 = (((int64_t)dig_p8) * p) >> 19;
+  p    = ((p + var1 + var2) >> 8) + (((int64_t)dig_p7) << 4);
+  return (uint32_t)p;
+}
 
 #define BMP280_DIG_T1_LSB_POS UINT8_C(0)
 #define BMP280_DIG_T1_MSB_POS UINT8_C(1)
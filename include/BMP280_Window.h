@@ -0,0 +1,78 @@
+/**
+ * @brief min, max, mean and standard deviation of temperature and pressure over fixed windows,
+ * e.g. 1 s, 1 min and 10 min for telemetry, without storing the samples
+ *
+ * A window keeps integer sums of the samples and of their squares relative to its first sample,
+ * the shifted form of the running variance, exact in 64 bit where the squares of Q24.8 pressure
+ * itself would overflow, or in float lose everything to cancellation. A sample costs a few
+ * additions and one multiply per value, the division and square root only happen when a window
+ * closes. Windows follow each other, aligned on the time of the first sample, so a window with no
+ * samples in a gap is skipped, and the statistics of the last closed window stay readable until
+ * the next one closes. Values must stay within BMP280_WINDOW_MAX_SPREAD of the first sample of
+ * their window, and a window holds at most BMP280_WINDOW_MAX_SAMPLE samples, 10 min at 1.7 kHz
+ *
+ * @file BMP280_Window.h
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#ifndef _BMP280_WINDOW_H
+#define _BMP280_WINDOW_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define BMP280_WINDOW_MAX_SPREAD (1L << 21)  // 8192 Pa in Q24.8, 209 C in 0.01 C
+#define BMP280_WINDOW_MAX_SAMPLE (1UL << 20)
+
+/**
+ * @brief statistics of one value over a window, in the unit of the value
+ */
+typedef struct {
+  int32_t  min;
+  int32_t  max;
+  int32_t  mean;    //!< rounded to the nearest unit
+  uint32_t stdDev;  //!< population standard deviation, rounded down
+  uint32_t count;   //!< samples in the window, the other fields are 0 without any
+} Bmp280WindowStat;
+
+/**
+ * @brief running sums of one value
+ */
+typedef struct {
+  int32_t  offset;     //!< first sample of the window
+  int64_t  sum;        //!< of value - offset
+  uint64_t sumSquare;  //!< of (value - offset)^2
+  int32_t  min;
+  int32_t  max;
+  uint32_t count;
+} Bmp280WindowSum;
+
+typedef struct {
+  uint32_t         lengthUs;
+  uint32_t         startUs;  //!< start of the open window
+  Bmp280WindowSum  temp;
+  Bmp280WindowSum  press;
+  Bmp280WindowStat lastTemp;  //!< of the last closed window
+  Bmp280WindowStat lastPress;
+} Bmp280Window;
+
+// false if lengthUs is 0 or over 2^31, the timestamps wrap after 71 min
+bool bmp280_window_init(Bmp280Window* window, const uint32_t lengthUs);
+
+// a sample from bmp280_get_temp_press_fixed taken at timeUs, e.g. from bmp280_get_sample_time,
+// true when it closed the window before it
+bool bmp280_window_add(Bmp280Window*  window,
+                       const uint32_t timeUs,
+                       const int32_t  temperatureCentiC,
+                       const uint32_t pressQ24_8);
+
+// statistics of the last closed window, or of the open one so far, either pointer can be NULL
+void bmp280_window_get_last(const Bmp280Window* window,
+                            Bmp280WindowStat*   temperature,
+                            Bmp280WindowStat*   pressure);
+void bmp280_window_get_open(const Bmp280Window* window,
+                            Bmp280WindowStat*   temperature,
+                            Bmp280WindowStat*   pressure);
+
+#endif
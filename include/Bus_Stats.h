@@ -0,0 +1,46 @@
+/**
+ * @brief counters kept by the I2C0 and SPI layers, build with BUS_STATS_ENABLE=0 to compile them
+ * out
+ *
+ * @file Bus_Stats.h
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#ifndef _BUS_STATS_H
+#define _BUS_STATS_H
+
+#include <stdint.h>
+
+#ifndef BUS_STATS_ENABLE
+#define BUS_STATS_ENABLE 1
+#endif
+
+/**
+ * @brief activity of one bus since the last reset of its counters
+ */
+typedef struct {
+  uint32_t transaction;    //!< single/multiple byte transfers on i2c, spi_transfer calls on spi
+  uint32_t byteTx;
+  uint32_t byteRx;
+  uint32_t waitCall;       //!< bus waits, including the ones that didn't have to spin
+  uint32_t waitSpinTotal;  //!< polls of the busy flag summed over all waits
+  uint32_t waitSpinMax;    //!< longest single wait
+  uint32_t timeout;
+  uint32_t busError;
+  uint32_t csAssert;       //!< spi only, falling edges of chip select
+  uint32_t recovery;       //!< i2c only, runs of i2c0_recover_bus
+} BusStats;
+
+#if BUS_STATS_ENABLE
+#define BUS_STATS_ADD(stats, field, value) ((stats).field += (value))
+#define BUS_STATS_MAX(stats, field, value)                    \
+  do {                                                        \
+    if ((value) > (stats).field) { (stats).field = (value); } \
+  } while (0)
+#else
+#define BUS_STATS_ADD(stats, field, value) ((void)0)
+#define BUS_STATS_MAX(stats, field, value) ((void)0)
+#endif
+
+#endif
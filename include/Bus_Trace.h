@@ -0,0 +1,104 @@
+/**
+ * @brief ring of register transactions in a compact binary form, for capturing what a driver did
+ * on the bus in the field and replaying it on a PC
+ *
+ * A record is a flags byte, the register, the data length, the time since the previous record as
+ * a LEB128 varint and the data bytes, 4 to 5 bytes for a register write. When the ring is full
+ * the oldest records are dropped. bus_trace_dump streams the ring, oldest record first, behind a
+ * BUS_TRACE_HEADER_SIZE byte header:
+ *
+ *   'B' 'T' 'R' version | time of the first record (u32 LE) | records (u32 LE) | dropped (u32 LE)
+ *
+ * @file Bus_Trace.h
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#ifndef _BUS_TRACE_H
+#define _BUS_TRACE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "include/Time_Source.h"
+
+#define BUS_TRACE_VERSION 1
+#define BUS_TRACE_HEADER_SIZE 16
+#define BUS_TRACE_MAX_DATA 32  // longer transfers are recorded with their first 32 bytes
+
+// flags byte of a record
+#define BUS_TRACE_WRITE 0x80    // register write, a read otherwise
+#define BUS_TRACE_ERROR 0x40    // the transaction failed after its retries, no data is recorded
+#define BUS_TRACE_RETRY_M 0x0F  // retries it took, saturates at 15
+
+/**
+ * @brief one transaction, timeUs is absolute once decoded
+ */
+typedef struct {
+  uint8_t  flags;
+  uint8_t  reg;
+  uint8_t  length;
+  uint32_t timeUs;
+  uint8_t  data[BUS_TRACE_MAX_DATA];
+} BusTraceRecord;
+
+/**
+ * @brief destination of bus_trace_dump, a UART or a file, write returns false on failure
+ */
+typedef struct {
+  bool (*write)(void* context, const uint8_t* data, const uint16_t size);
+  void* context;
+} BusTraceSink;
+
+/**
+ * @brief ring over a caller supplied buffer
+ */
+typedef struct {
+  uint8_t*          buffer;
+  uint32_t          size;
+  uint32_t          head;        //!< where the next record is written
+  uint32_t          tail;        //!< first byte of the oldest record
+  uint32_t          used;        //!< bytes held
+  uint32_t          firstUs;     //!< time of the oldest record
+  uint32_t          lastUs;      //!< time of the newest record
+  uint32_t          total;       //!< records held
+  uint32_t          dropped;     //!< records overwritten since the last clear
+  const TimeSource* timeSource;  //!< NULL records every transaction at time 0
+} BusTrace;
+
+/**
+ * @brief header of a dumped trace
+ */
+typedef struct {
+  uint8_t  version;
+  uint32_t firstUs;
+  uint32_t total;
+  uint32_t dropped;
+} BusTraceHeader;
+
+void bus_trace_init(BusTrace*         trace,
+                    uint8_t*          buffer,
+                    const uint32_t    size,
+                    const TimeSource* timeSource);
+void bus_trace_clear(BusTrace* trace);
+
+// append a transaction, dropping the oldest records to make room
+void bus_trace_add(BusTrace*      trace,
+                   const uint8_t  flags,
+                   const uint8_t  reg,
+                   const uint8_t* data,
+                   const uint8_t  length);
+
+// stream the header and every record, false if the sink failed
+bool bus_trace_dump(const BusTrace* trace, const BusTraceSink* sink);
+
+/* decoding of a dump */
+bool bus_trace_parse_header(const uint8_t* dump, const uint32_t size, BusTraceHeader* header);
+// decode the record at offset, timeUs is the time of the previous record on input, return the
+// offset of the next record or 0 if the record is cut short
+uint32_t bus_trace_parse_record(const uint8_t*  dump,
+                                const uint32_t  size,
+                                const uint32_t  offset,
+                                BusTraceRecord* record);
+
+#endif
@@ -0,0 +1,34 @@
+/**
+ * @brief fixed size log2 histogram of durations in microseconds
+ *
+ * Bucket 0 counts 0 us and bucket n counts [2^(n-1), 2^n) us, the last bucket also takes
+ * everything longer. Percentiles are reported as the upper edge of their bucket so they are at
+ * most a factor 2 pessimistic
+ *
+ * @file Latency_Hist.h
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#ifndef _LATENCY_HIST_H
+#define _LATENCY_HIST_H
+
+#include <stdint.h>
+
+#define LATENCY_HIST_BUCKET 24  // up to 2^23 us, about 8 s
+
+typedef struct {
+  uint32_t bucket[LATENCY_HIST_BUCKET];
+  uint32_t count;
+  uint32_t maxUs;
+} LatencyHist;
+
+void latency_hist_reset(LatencyHist* hist);
+void latency_hist_add(LatencyHist* hist, const uint32_t durationUs);
+// add the samples of other, e.g. to combine the histograms of several threads or processes
+void latency_hist_merge(LatencyHist* hist, const LatencyHist* other);
+
+// upper edge of the bucket holding the given percentile, 0 for an empty histogram
+uint32_t latency_hist_percentile_us(const LatencyHist* hist, const uint8_t percent);
+
+#endif
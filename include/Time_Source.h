@@ -0,0 +1,31 @@
+/**
+ * @brief monotonic microsecond clock behind a function pointer so the drivers can be timed with
+ * SysTick or DWT on the TivaC, clock_gettime on a PC or the virtual clock of the simulator
+ *
+ * @file Time_Source.h
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#ifndef _TIME_SOURCE_H
+#define _TIME_SOURCE_H
+
+#include <stdint.h>
+
+/**
+ * @brief a clock that counts up in microseconds and wraps at 2^32, about 71 minutes
+ */
+typedef struct {
+  uint32_t (*now_us)(void* context);
+  void* context;
+} TimeSource;
+
+uint32_t time_source_now_us(const TimeSource* source);
+
+// time since startUs, correct across one wrap of the clock
+uint32_t time_source_elapsed_us(const TimeSource* source, const uint32_t startUs);
+
+// signed difference laterUs - earlierUs, for timestamps less than 35 minutes apart
+int32_t time_source_diff_us(const uint32_t laterUs, const uint32_t earlierUs);
+
+#endif
@@ -0,0 +1,46 @@
+/**
+ * @brief DWT cycle counter of the Cortex-M4 and the deadlines the drivers time their waits with
+ *
+ * @file TivaC_CycleCounter.h
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#ifndef _TIVAC_CYCLE_COUNTER_H
+#define _TIVAC_CYCLE_COUNTER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define CYCLE_COUNTER_CLOCK_MHZ 16  // the counter runs from the 16 MHz system clock
+#define CYCLE_COUNTER_MAX_US (0xFFFFFFFF / CYCLE_COUNTER_CLOCK_MHZ)  // one wrap, about 268 s
+#define CYCLE_COUNTER_POLL_PER_US CYCLE_COUNTER_CLOCK_MHZ  // a register poll takes at least a cycle
+
+/**
+ * @brief a time limit for a busy wait, budgets are capped at CYCLE_COUNTER_MAX_US
+ *
+ * the limit is timed on the cycle counter, which the deadline enables itself. Only on a part
+ * without the counter it is a count of CYCLE_COUNTER_POLL_PER_US polls per microsecond, never
+ * shorter than the budget but up to as many times longer as a poll takes cycles
+ */
+typedef struct {
+  uint32_t startCycle;
+  uint32_t budgetUs;
+  uint32_t pollLeft;  //!< used when isTimed is false
+  bool     isTimed;
+} CycleDeadline;
+
+// enable the counter without clearing it, so it can be shared with a debugger or a time source,
+// return whether the part has one. Only a write to the debug registers turns it off again
+bool cycle_counter_open(void);
+
+uint32_t cycle_counter_get(void);
+
+// time since startCycle, only valid for intervals shorter than CYCLE_COUNTER_MAX_US
+uint32_t cycle_counter_elapsed_us(const uint32_t startCycle);
+
+// deadline budgetUs from now and whether it has passed, call the latter once per poll
+CycleDeadline cycle_deadline(const uint32_t budgetUs);
+bool          cycle_deadline_expired(CycleDeadline* deadline);
+
+#endif
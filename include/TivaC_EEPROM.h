@@ -0,0 +1,36 @@
+/**
+ * @brief contain EEPROM error enum and function prototypes
+ *
+ * @file TivaC_EEPROM.h
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#ifndef _TIVAC_EEPROM_H
+#define _TIVAC_EEPROM_H
+
+#include <stdint.h>
+
+#define EEPROM_TRY_FUNC(funcToExecute)                \
+  do {                                                \
+    EepromErrCode errCode = funcToExecute;            \
+    if (errCode != EEPROM_NO_ERR) { return errCode; } \
+  } while (0)
+
+typedef enum {
+  EEPROM_NO_ERR = 0,
+  EEPROM_TIMEOUT,
+  EEPROM_RETRY_FAIL,   //!< the EEPROM reported a failed erase/program during power up
+  EEPROM_INVAL_ADDR,   //!< address is not word aligned or outside of the EEPROM
+  EEPROM_WRITE_FAIL    //!< the EEPROM refused a write, for example because of a protected block
+} EepromErrCode;
+
+EepromErrCode eeprom_open(void);  // enable the EEPROM module, must be called first
+
+// address is in bytes and has to be word aligned, data is transferred in 32 bit words
+EepromErrCode eeprom_read(const uint32_t address, uint32_t* data, const uint32_t totalWord);
+EepromErrCode eeprom_write(const uint32_t address, const uint32_t* data, const uint32_t totalWord);
+
+EepromErrCode eeprom_wait_done(void);  // wait until the EEPROM finishes the current operation
+
+#endif
@@ -13,6 +13,8 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include "include/Bus_Stats.h"
+
 #define REMAIN_TRANSMIT 2
 #define NO_REMAIN_TRANSMIT 0
 
@@ -61,4 +63,11 @@ I2c0ErrCode i2c0_check_master_enabled(void);  // check if the master mode is ena
 // wait until the i2c bus is not busy, do not call unless master/slave mode enabled
 I2c0ErrCode i2c0_wait_bus(void);
 
+// free a slave holding SDA low by clocking SCL as GPIO, then stop and reopen the controller
+I2c0ErrCode i2c0_recover_bus(void);
+
+// counters are all 0 when built with BUS_STATS_ENABLE=0
+void i2c0_get_stats(BusStats* stats);
+void i2c0_reset_stats(void);
+
 #endif
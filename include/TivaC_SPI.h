@@ -12,6 +12,8 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+#include "include/Bus_Stats.h"
+
 /**
  * @brief the smallest transfer size of the spi, note that this is different from the transfer size
  * in the spi structure, a complete transfer is made up of small 8 bit transfers
@@ -89,4 +91,8 @@ SpiErrCode spi_transfer(const SpiSettings setting,
                         uint8_t*          dataRx,
                         const uint8_t     dataRxLenByte);
 
+// counters are all 0 when built with BUS_STATS_ENABLE=0
+void spi_get_stats(BusStats* stats);
+void spi_reset_stats(void);
+
 #endif
\ No newline at end of file
@@ -11,7 +11,10 @@
 
 #include <stdint.h>
 #include "include/TivaC_SPI.h"
-#include "include/tm4c123gh6pm.h"
+#include "include/TivaC_CycleCounter.h"
+#include "external/TivaC_Utils/include/tm4c123gh6pm.h"
+
+extern BusStats spiStats;  // shared by the SPI files, read it through spi_get_stats
 
 /* Error Checking */
 SpiErrCode spi_check_setting(
@@ -22,20 +25,26 @@ SpiErrCode spi_check_rx_not_empty(void);
 
 /* Calculation */
 SpiErrCode spi_calc_clock_prescalc(const SpiSettings setting, uint8_t* preScalc, uint8_t* scr);
+// time budget for totalFrame frames at the bit rate of setting
+CycleDeadline spi_deadline(const SpiSettings setting, const uint16_t totalFrame);
 
 /* Common Utility Action */
-SpiErrCode spi_bus_wait(void);
+SpiErrCode spi_bus_wait(CycleDeadline* deadline);
+SpiErrCode spi_rx_wait(CycleDeadline* deadline);  // until the receive FIFO isn't empty
 void       spi_enable_spi(void);
 void       spi_disable_spi(void);
 void       spi_pull_cs_low(void);
 void       spi_pull_cs_high(void);
-SpiErrCode spi_send_dummy_byte(void);  // used to stretching communication
-void       spi_data_delay(void);       // delay between receiving and reading the data
+// used to stretching communication
+SpiErrCode spi_send_dummy_byte(CycleDeadline* deadline);
 
 /* Protocol Handling */
-SpiErrCode spi_rx_one_data_unit(const SpiSettings setting, uint8_t* totalByteRxed, uint8_t* dataRx);
+SpiErrCode spi_rx_one_data_unit(CycleDeadline* deadline,
+                                uint8_t*       totalByteRxed,
+                                uint8_t*       dataRx);
 
-SpiErrCode spi_tx_one_data_unit(const uint8_t  transferSize,
+SpiErrCode spi_tx_one_data_unit(CycleDeadline* deadline,
+                                const uint8_t  transferSize,
                                 uint8_t*       totalByteTxed,
                                 const uint8_t* dataTx);
 void       spi_clear_rx_buffer(void);
@@ -0,0 +1,28 @@
+/**
+ * @brief free running SysTick counter for applications and time sources that count on it
+ *
+ * @file TivaC_SysTick.h
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#ifndef _TIVAC_SYSTICK_H
+#define _TIVAC_SYSTICK_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define SYSTICK_CLOCK_MHZ 16         // SysTick runs from the 16 MHz system clock
+#define SYSTICK_MAX_TICK 0x00FFFFFF  // 24 bit counter, wraps after about 1 s at 16 MHz
+
+// take SysTick over as a free running counter for the application, the SysTick interrupt and any
+// RTOS tick on it are turned off. The drivers never call it, their waits run on the cycle counter
+void systick_open(void);
+bool systick_is_free_running(void);
+
+uint32_t systick_get_tick(void);  // counts up, only the lower 24 bits are valid
+
+// time since startTick, only valid for intervals shorter than one wrap of the counter
+uint32_t systick_elapsed_us(const uint32_t startTick);
+
+#endif
@@ -0,0 +1,34 @@
+/**
+ * @brief TivaC time sources, SysTick works on every part, the DWT cycle counter is finer but is
+ * shared with debuggers
+ *
+ * Both counters are narrower than the 32 bit microsecond clock, the source extends them every time
+ * it is read so it has to be read at least once per wrap of the counter: about 1 s for SysTick and
+ * 268 s for DWT at 16 MHz
+ *
+ * @file TivaC_TimeSource.h
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#ifndef _TIVAC_TIMESOURCE_H
+#define _TIVAC_TIMESOURCE_H
+
+#include <stdint.h>
+
+#include "include/Time_Source.h"
+
+/**
+ * @brief state of a source built on a hardware counter, owned by the caller
+ */
+typedef struct {
+  uint32_t lastCount;
+  uint32_t cycleRemainder;  //!< cycles not yet converted to a whole microsecond
+  uint32_t nowUs;
+} TivaCTimeContext;
+
+// SysTick is started through systick_open
+void tivac_time_source_systick(TimeSource* source, TivaCTimeContext* context);
+void tivac_time_source_dwt(TimeSource* source, TivaCTimeContext* context);
+
+#endif
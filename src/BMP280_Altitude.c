@@ -0,0 +1,111 @@
+/**
+ * @brief altitude from Q24.8 pressure in fixed point, see BMP280_Altitude.h
+ *
+ * @file BMP280_Altitude.c
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#include "include/BMP280_Altitude.h"
+
+#define BMP280_ALTITUDE_ONE_Q30 ((uint32_t)1 << 30)
+#define BMP280_ALTITUDE_INDEX_SHIFT 22  // 30 fraction bits of the mantissa, 8 of them index
+#define BMP280_ALTITUDE_FRAC_MASK (((uint32_t)1 << BMP280_ALTITUDE_INDEX_SHIFT) - 1)
+#define BMP280_ALTITUDE_SCALE_MM 44330000
+
+/**
+ * @brief m^0.1903 in Q30 for m = 1 + i / 256, each entry lifted by half the sag of the chords next
+ * to it under the curve, which halves the worst interpolation error
+ */
+static const uint32_t bmp280AltitudePowLut[257] = {
+    1073741982, 1074538897, 1075333306, 1076125226, 1076914674, 1077701667, 1078486222, 1079268356,
+    1080048086, 1080825429, 1081600400, 1082373015, 1083143291, 1083911243, 1084676887, 1085440239,
+    1086201313, 1086960125, 1087716690, 1088471022, 1089223137, 1089973048, 1090720770, 1091466318,
+    1092209705, 1092950946, 1093690053, 1094427042, 1095161925, 1095894716, 1096625428, 1097354074,
+    1098080667, 1098805220, 1099527747, 1100248258, 1100966768, 1101683288, 1102397831, 1103110408,
+    1103821032, 1104529715, 1105236469, 1105941305, 1106644235, 1107345270, 1108044422, 1108741701,
+    1109437120, 1110130690, 1110822420, 1111512322, 1112200408, 1112886686, 1113571169, 1114253867,
+    1114934789, 1115613946, 1116291349, 1116967007, 1117640930, 1118313129, 1118983614, 1119652393,
+    1120319477, 1120984875, 1121648596, 1122310651, 1122971049, 1123629797, 1124286907, 1124942387,
+    1125596246, 1126248492, 1126899135, 1127548184, 1128195647, 1128841533, 1129485850, 1130128607,
+    1130769813, 1131409475, 1132047602, 1132684203, 1133319284, 1133952855, 1134584923, 1135215497,
+    1135844584, 1136472192, 1137098328, 1137723001, 1138346218, 1138967987, 1139588315, 1140207210,
+    1140824678, 1141440728, 1142055366, 1142668600, 1143280437, 1143890884, 1144499948, 1145107636,
+    1145713954, 1146318911, 1146922512, 1147524765, 1148125676, 1148725252, 1149323499, 1149920424,
+    1150516033, 1151110334, 1151703332, 1152295033, 1152885445, 1153474573, 1154062423, 1154649002,
+    1155234316, 1155818371, 1156401172, 1156982727, 1157563041, 1158142119, 1158719968, 1159296593,
+    1159872001, 1160446197, 1161019186, 1161590975, 1162161569, 1162730973, 1163299193, 1163866234,
+    1164432103, 1164996804, 1165560343, 1166122724, 1166683955, 1167244038, 1167802981, 1168360788,
+    1168917464, 1169473014, 1170027443, 1170580757, 1171132960, 1171684058, 1172234055, 1172782956,
+    1173330767, 1173877491, 1174423134, 1174967700, 1175511195, 1176053622, 1176594987, 1177135295,
+    1177674549, 1178212755, 1178749916, 1179286038, 1179821125, 1180355182, 1180888212, 1181420221,
+    1181951212, 1182481190, 1183010159, 1183538124, 1184065089, 1184591058, 1185116035, 1185640024,
+    1186163030, 1186685057, 1187206108, 1187726188, 1188245301, 1188763450, 1189280641, 1189796876,
+    1190312160, 1190826497, 1191339890, 1191852344, 1192363862, 1192874448, 1193384105, 1193892838,
+    1194400651, 1194907547, 1195413529, 1195918601, 1196422768, 1196926032, 1197428398, 1197929869,
+    1198430447, 1198930138, 1199428944, 1199926869, 1200423917, 1200920090, 1201415393, 1201909829,
+    1202403400, 1202896111, 1203387965, 1203878965, 1204369114, 1204858416, 1205346874, 1205834491,
+    1206321271, 1206807216, 1207292330, 1207776616, 1208260078, 1208742717, 1209224538, 1209705544,
+    1210185737, 1210665121, 1211143698, 1211621473, 1212098447, 1212574623, 1213050006, 1213524597,
+    1213998400, 1214471417, 1214943651, 1215415106, 1215885784, 1216355688, 1216824821, 1217293186,
+    1217760785, 1218227621, 1218693698, 1219159017, 1219623582, 1220087395, 1220550459, 1221012777,
+    1221474351, 1221935185, 1222395280, 1222854639, 1223313265, 1223771161, 1224228329, 1224684772,
+    1225140492,
+};
+
+// 2^(0.1903 * e) in Q30 for the power of 2 e = -2 to 1 of the ratio
+static const uint32_t bmp280AltitudePowScale[4] = {824760501, 941052519, 1073741824, 1225140447};
+
+void bmp280_altitude_init(Bmp280Altitude* altitude) {
+  bmp280_altitude_set_reference(altitude, BMP280_ALTITUDE_SEA_LEVEL_Q8);
+}
+
+bool bmp280_altitude_set_reference(Bmp280Altitude* altitude, const uint32_t referenceQ8) {
+  if (referenceQ8 < BMP280_ALTITUDE_MIN_Q8 || referenceQ8 > BMP280_ALTITUDE_MAX_Q8) {
+    return false;
+  }
+  altitude->referenceQ8 = referenceQ8;
+  altitude->inverse     = ((uint64_t)1 << 62) / referenceQ8;
+  return true;
+}
+
+/**
+ * @brief both pressures are within 300 to 1100 hPa, so the ratio is within 0.27 to 3.7 and its
+ * power of 2 within -2 to 1
+ *
+ */
+int32_t bmp280_altitude_mm(const Bmp280Altitude* altitude, const uint32_t pressQ8) {
+  uint32_t press = pressQ8;
+  if (press < BMP280_ALTITUDE_MIN_Q8) { press = BMP280_ALTITUDE_MIN_Q8; }
+  if (press > BMP280_ALTITUDE_MAX_Q8) { press = BMP280_ALTITUDE_MAX_Q8; }
+
+  // p / p0 in Q30, below 2^32
+  uint64_t ratio = ((uint64_t)press * altitude->inverse) >> 32;
+  uint8_t  scale;
+  uint32_t mantissa;
+  if (ratio >= 2 * (uint64_t)BMP280_ALTITUDE_ONE_Q30) {
+    scale    = 3;
+    mantissa = (uint32_t)(ratio >> 1);
+  } else if (ratio >= BMP280_ALTITUDE_ONE_Q30) {
+    scale    = 2;
+    mantissa = (uint32_t)ratio;
+  } else if (ratio >= BMP280_ALTITUDE_ONE_Q30 / 2) {
+    scale    = 1;
+    mantissa = (uint32_t)ratio << 1;
+  } else {
+    scale    = 0;
+    mantissa = (uint32_t)ratio << 2;
+  }
+
+  uint32_t offset = mantissa - BMP280_ALTITUDE_ONE_Q30;
+  uint32_t index  = offset >> BMP280_ALTITUDE_INDEX_SHIFT;
+  uint32_t frac   = offset & BMP280_ALTITUDE_FRAC_MASK;
+  uint32_t low    = bmp280AltitudePowLut[index];
+  uint32_t step   = bmp280AltitudePowLut[index + 1] - low;
+  uint32_t power  = low + (uint32_t)(((uint64_t)step * frac) >> BMP280_ALTITUDE_INDEX_SHIFT);
+  int64_t ratioPower = (int64_t)(((uint64_t)power * bmp280AltitudePowScale[scale]) >> 30);
+
+  int64_t altitudeMm =
+      (int64_t)BMP280_ALTITUDE_SCALE_MM * ((int64_t)BMP280_ALTITUDE_ONE_Q30 - ratioPower);
+  return (int32_t)((altitudeMm + ((int64_t)1 << 29)) >> 30);
+}
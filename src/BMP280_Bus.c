@@ -0,0 +1,180 @@
+/**
+ * @brief the TivaC I2C0 and SPI0 peripherals as bmp280 buses, see BMP280_Bus.h
+ *
+ * @file BMP280_Bus.c
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#include "include/BMP280_Bus.h"
+
+#include <stddef.h>
+
+#include "include/BMP280_Utils.h"
+#include "include/TivaC_I2C.h"
+#include "include/TivaC_SPI.h"
+
+static const SpiSettings bmp280SpiSetting = {.spiBitRateMbits = 0.3,
+                                             .cpuClockMHz     = 16,
+                                             .cpol            = 1,
+                                             .cpha            = 1,
+                                             .operMode        = Freescale,
+                                             .isLoopBack      = false,
+                                             .transferSizeBit = 8,
+                                             .role            = Master,
+                                             .clockSource     = Systemclock};
+
+/* I2C0 */
+
+static bool bmp280_i2c0_open(void* context) {
+  (void)context;
+  return I2C0_NO_ERR == i2c0_open();
+}
+
+static void bmp280_i2c0_close(void* context) {
+  (void)context;
+  i2c0_close();
+}
+
+static bool bmp280_i2c0_is_open(void* context) {
+  (void)context;
+  return I2C0_NO_ERR == i2c0_check_master_enabled();
+}
+
+bool bmp280_i2c0_read(void*         context,
+                      const uint8_t address,
+                      const uint8_t startAddr,
+                      uint8_t*      regData,
+                      const uint8_t totalRegister) {
+  (void)context;
+  if (I2C0_NO_ERR != i2c0_wait_bus()) { return false; }
+  if (totalRegister > 1) {
+    // write data with no stop signal
+    return I2C0_NO_ERR == i2c0_single_data_write(address, startAddr, true) &&
+           I2C0_NO_ERR == i2c0_multiple_data_byte_read(address, regData, totalRegister);
+  }
+  if (totalRegister == 1) {
+    // write data with no stop signal
+    if (I2C0_NO_ERR != i2c0_single_data_write(address, startAddr, true) ||
+        I2C0_NO_ERR != i2c0_wait_bus()) {
+      return false;
+    }
+
+    // read 3 bytes bc reading single byte seems to create weird behaviours with this sensor
+    uint8_t inputBuffer[3];
+    if (I2C0_NO_ERR != i2c0_multiple_data_byte_read(address, inputBuffer, 3)) { return false; }
+    *regData = inputBuffer[0];
+  }
+  return true;
+}
+
+bool bmp280_i2c0_write(void*         context,
+                       const uint8_t address,
+                       const uint8_t regAddr,
+                       const uint8_t regData) {
+  (void)context;
+  uint8_t regDataPair[2] = {regAddr, regData};
+  return I2C0_NO_ERR == i2c0_multiple_data_byte_write(address, regDataPair, 2);
+}
+
+/**
+ * @brief a glitch can leave the bmp280 holding SDA low, so the bus is recovered before a retry
+ *
+ */
+void bmp280_i2c0_recover(void* context) {
+  (void)context;
+  i2c0_recover_bus();
+}
+
+static void bmp280_i2c0_get_stats(void* context, BusStats* stats) {
+  (void)context;
+  i2c0_get_stats(stats);
+}
+
+static void bmp280_i2c0_reset_stats(void* context) {
+  (void)context;
+  i2c0_reset_stats();
+}
+
+static const Bmp280BusOps bmp280I2c0Ops = {.open        = bmp280_i2c0_open,
+                                           .close       = bmp280_i2c0_close,
+                                           .is_open     = bmp280_i2c0_is_open,
+                                           .read        = bmp280_i2c0_read,
+                                           .write       = bmp280_i2c0_write,
+                                           .recover     = bmp280_i2c0_recover,
+                                           .get_stats   = bmp280_i2c0_get_stats,
+                                           .reset_stats = bmp280_i2c0_reset_stats};
+
+/* SPI0, SPI has no bus state to recover so a failed transfer is only repeated */
+
+static bool bmp280_spi0_open(void* context) {
+  (void)context;
+  return SPI_ERR_NO_ERR == spi_open(bmp280SpiSetting);
+}
+
+static void bmp280_spi0_close(void* context) {
+  (void)context;
+  spi_close();
+}
+
+static bool bmp280_spi0_is_open(void* context) {
+  (void)context;
+  return SPI_ERR_NO_ERR == spi_check_spi_enabled();
+}
+
+bool bmp280_spi0_read(void*         context,
+                      const uint8_t address,
+                      const uint8_t startAddr,
+                      uint8_t*      regData,
+                      const uint8_t totalRegister) {
+  (void)context;
+  (void)address;
+  uint8_t addressList[1] = {startAddr};
+  return SPI_ERR_NO_ERR == spi_transfer(bmp280SpiSetting, addressList, 1, regData, totalRegister);
+}
+
+bool bmp280_spi0_write(void*         context,
+                       const uint8_t address,
+                       const uint8_t regAddr,
+                       const uint8_t regData) {
+  (void)context;
+  (void)address;
+  // a set bit 7 makes the bmp280 treat the address as a read
+  uint8_t regDataPair[2] = {regAddr & ~BMP280_SPI_READ_BIT, regData};
+  return SPI_ERR_NO_ERR == spi_transfer(bmp280SpiSetting, regDataPair, 2, NULL, 0);
+}
+
+static void bmp280_spi0_get_stats(void* context, BusStats* stats) {
+  (void)context;
+  spi_get_stats(stats);
+}
+
+static void bmp280_spi0_reset_stats(void* context) {
+  (void)context;
+  spi_reset_stats();
+}
+
+static const Bmp280BusOps bmp280Spi0Ops = {.open        = bmp280_spi0_open,
+                                           .close       = bmp280_spi0_close,
+                                           .is_open     = bmp280_spi0_is_open,
+                                           .read        = bmp280_spi0_read,
+                                           .write       = bmp280_spi0_write,
+                                           .recover     = NULL,
+                                           .get_stats   = bmp280_spi0_get_stats,
+                                           .reset_stats = bmp280_spi0_reset_stats};
+
+// not const so an RTOS build can give the peripherals a lock
+static Bmp280Bus bmp280I2c0Bus = {.ops = &bmp280I2c0Ops, .context = NULL, .lock = NULL};
+static Bmp280Bus bmp280Spi0Bus = {.ops = &bmp280Spi0Ops, .context = NULL, .lock = NULL};
+
+Bmp280Bus* bmp280_bus_i2c0(void) { return &bmp280I2c0Bus; }
+
+Bmp280Bus* bmp280_bus_spi0(void) { return &bmp280Spi0Bus; }
+
+void bmp280_bus_lock(const Bmp280Bus* bus) {
+  if (NULL != bus->lock) { bus->lock->lock(bus->lock->context); }
+}
+
+void bmp280_bus_unlock(const Bmp280Bus* bus) {
+  if (NULL != bus->lock) { bus->lock->unlock(bus->lock->context); }
+}
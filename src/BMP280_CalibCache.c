@@ -0,0 +1,142 @@
+/**
+ * @brief Calibration cache, keeps the parsed calibration block in non-volatile storage so that a
+ * cold start only needs a short read to validate it
+ *
+ * @file BMP280_CalibCache.c
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#include "include/BMP280_CalibCache.h"
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "include/BMP280_Drv.h"
+#include "include/BMP280_Utils.h"
+#include "include/BMP280_Ware.h"
+#include "include/TivaC_EEPROM.h"
+
+#define BMP280_CALIB_CACHE_MAGIC 0xB2
+#define BMP280_CRC8_POLY 0x31
+#define BMP280_CRC8_INIT 0xFF
+
+// the largest record the EEPROM store can move in one go
+#define BMP280_EEPROM_STORE_MAX_WORD 16
+
+/**
+ * @brief layout of the cached block, the chip ID and the first calibration bytes of the sensor
+ * the block was read from are kept to detect a swapped sensor
+ */
+typedef struct {
+  uint8_t          magic;
+  uint8_t          chipId;
+  uint8_t          check[BMP280_CALIB_CHECK_SIZE];
+  uint8_t          crc;
+  uint8_t          reserved;
+  Bmp280CalibParam calibParam;
+} Bmp280CalibCacheRecord;
+
+/**
+ * @brief crc8 used to catch corrupted or never written records
+ *
+ */
+static uint8_t bmp280_calib_crc(const uint8_t* data, const uint16_t size) {
+  uint8_t crc = BMP280_CRC8_INIT;
+  for (uint16_t dataIndex = 0; dataIndex < size; ++dataIndex) {
+    crc ^= data[dataIndex];
+    for (uint8_t bitIndex = 0; bitIndex < 8; ++bitIndex) {
+      crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ BMP280_CRC8_POLY) : (uint8_t)(crc << 1);
+    }
+  }
+  return crc;
+}
+
+/**
+ * @brief crc of the record with the crc field itself zeroed
+ *
+ */
+static uint8_t bmp280_calib_record_crc(const Bmp280CalibCacheRecord* record) {
+  Bmp280CalibCacheRecord crcRecord = *record;
+  crcRecord.crc                    = 0;
+  return bmp280_calib_crc((const uint8_t*)&crcRecord, sizeof(crcRecord));
+}
+
+/**
+ * @brief use the cached calibration if it is intact and was read from this sensor, otherwise read
+ * the calibration block from the sensor and write it back to the store
+ * @param store where the cache is kept
+ * @param isCacheHit return whether the calibration came from the store
+ */
+Bmp280ErrCode bmp280_load_calibration_cached(bmp280*                 sensor,
+                                             const Bmp280CalibStore* store,
+                                             bool*                   isCacheHit) {
+  BMP280_TRY_FUNC(bmp280_port_prep(sensor));
+  if (NULL != isCacheHit) { *isCacheHit = false; }
+
+  uint8_t chipId;
+  uint8_t check[BMP280_CALIB_CHECK_SIZE];
+  BMP280_TRY_FUNC(bmp280_get_id(sensor, &chipId));
+  BMP280_TRY_FUNC(
+      bmp280_get_register(sensor, BMP280_CALIB_START_ADDR, check, BMP280_CALIB_CHECK_SIZE));
+
+  Bmp280CalibCacheRecord record;
+  if (store->read(store->context, (uint8_t*)&record, sizeof(record)) &&
+      BMP280_CALIB_CACHE_MAGIC == record.magic && chipId == record.chipId &&
+      0 == memcmp(check, record.check, BMP280_CALIB_CHECK_SIZE) &&
+      bmp280_calib_record_crc(&record) == record.crc) {
+    sensor->calibParam    = record.calibParam;
+    sensor->isCalibLoaded = true;
+    // force the next pressure read to refresh t_fine, it is not part of the cache
+    sensor->tFineAge = BMP280_TFINE_STALE;
+
+    if (NULL != isCacheHit) { *isCacheHit = true; }
+    return ERR_NO_ERR;
+  }
+
+  BMP280_TRY_FUNC(bmp280_get_calibration_data(sensor, NULL));
+
+  memset(&record, 0, sizeof(record));
+  record.magic             = BMP280_CALIB_CACHE_MAGIC;
+  record.chipId            = chipId;
+  record.calibParam        = sensor->calibParam;
+  record.calibParam.t_fine = 0;
+  memcpy(record.check, check, BMP280_CALIB_CHECK_SIZE);
+  record.crc = bmp280_calib_record_crc(&record);
+
+  if (false == store->write(store->context, (const uint8_t*)&record, sizeof(record))) {
+    return ERR_CALIB_STORE_FAIL;
+  }
+  return ERR_NO_ERR;
+}
+
+static bool bmp280_eeprom_store_read(void* context, uint8_t* data, const uint16_t size) {
+  uint32_t wordBuffer[BMP280_EEPROM_STORE_MAX_WORD];
+  uint32_t totalWord = (size + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+  if (totalWord > BMP280_EEPROM_STORE_MAX_WORD) { return false; }
+
+  if (EEPROM_NO_ERR != eeprom_read((uint32_t)(uintptr_t)context, wordBuffer, totalWord)) {
+    return false;
+  }
+  memcpy(data, wordBuffer, size);
+  return true;
+}
+
+static bool bmp280_eeprom_store_write(void* context, const uint8_t* data, const uint16_t size) {
+  uint32_t wordBuffer[BMP280_EEPROM_STORE_MAX_WORD] = {0};
+  uint32_t totalWord = (size + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+  if (totalWord > BMP280_EEPROM_STORE_MAX_WORD) { return false; }
+
+  memcpy(wordBuffer, data, size);
+  return EEPROM_NO_ERR == eeprom_write((uint32_t)(uintptr_t)context, wordBuffer, totalWord);
+}
+
+/**
+ * @brief create a store that keeps the cache in the TM4C EEPROM
+ * @param eepromAddress word aligned byte address of the record in the EEPROM
+ */
+void bmp280_calib_store_eeprom(Bmp280CalibStore* store, const uint32_t eepromAddress) {
+  store->read    = bmp280_eeprom_store_read;
+  store->write   = bmp280_eeprom_store_write;
+  store->context = (void*)(uintptr_t)eepromAddress;
+}
@@ -0,0 +1,245 @@
+/**
+ * @brief block compressor for streams of raw bmp280 samples, see BMP280_Compress.h for the format
+ *
+ * @file BMP280_Compress.c
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#include "include/BMP280_Compress.h"
+
+#include <stddef.h>
+
+#define BMP280_COMPRESS_ADC_MASK 0xFFFFF
+#define BMP280_COMPRESS_MAX_VARINT 3  // a zig-zag coded 20 bit delta fits in 21 bits
+#define BMP280_COMPRESS_MAX_WIDTH 21
+
+static uint32_t bmp280_zigzag(const int32_t value) {
+  return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+}
+
+static int32_t bmp280_unzigzag(const uint32_t value) {
+  return (int32_t)(value >> 1) ^ -(int32_t)(value & 1);
+}
+
+static uint8_t bmp280_varint_size(const uint32_t value) {
+  return (value < 0x80) ? 1 : ((value < 0x4000) ? 2 : 3);
+}
+
+static uint8_t bmp280_bit_width(uint32_t value) {
+  uint8_t width = 0;
+  while (value > 0) {
+    value >>= 1;
+    ++width;
+  }
+  return width;
+}
+
+/**
+ * @brief write the deltas of one channel, prev is the sample before the first one
+ * @return bytes written, isPacked returns the format that was chosen
+ */
+static uint16_t bmp280_compress_channel(const int32_t* values,
+                                        const uint8_t  total,
+                                        const int32_t  prev,
+                                        uint8_t*       out,
+                                        bool*          isPacked) {
+  uint32_t zigzag[BMP280_COMPRESS_BLOCK];
+  uint32_t varintSize = 0;
+  uint32_t maxZigzag  = 0;
+  for (uint8_t sampleIndex = 0; sampleIndex < total; ++sampleIndex) {
+    int32_t before      = (0 == sampleIndex) ? prev : values[sampleIndex - 1];
+    zigzag[sampleIndex] = bmp280_zigzag(values[sampleIndex] - before);
+    varintSize += bmp280_varint_size(zigzag[sampleIndex]);
+    maxZigzag |= zigzag[sampleIndex];
+  }
+  uint8_t  width      = bmp280_bit_width(maxZigzag);
+  uint32_t packedSize = 1 + ((uint32_t)width * total + 7) / 8;
+
+  uint16_t size = 0;
+  *isPacked     = packedSize < varintSize;
+  if (!*isPacked) {
+    for (uint8_t sampleIndex = 0; sampleIndex < total; ++sampleIndex) {
+      uint32_t value = zigzag[sampleIndex];
+      while (value >= 0x80) {
+        out[size++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+      }
+      out[size++] = (uint8_t)value;
+    }
+    return size;
+  }
+
+  out[size++]      = width;
+  uint32_t bits    = 0;
+  uint8_t  bitUsed = 0;
+  for (uint8_t sampleIndex = 0; sampleIndex < total; ++sampleIndex) {
+    // width is at most 21 so 7 pending bits plus the value still fit in 32
+    bits |= zigzag[sampleIndex] << bitUsed;
+    bitUsed += width;
+    while (bitUsed >= 8) {
+      out[size++] = (uint8_t)bits;
+      bits >>= 8;
+      bitUsed -= 8;
+    }
+  }
+  if (bitUsed > 0) { out[size++] = (uint8_t)bits; }
+  return size;
+}
+
+/**
+ * @brief read the deltas of one channel and turn them back into samples
+ * @return bytes used, 0 if the channel runs past the end of the block
+ */
+static uint32_t bmp280_decompress_channel(const uint8_t* in,
+                                          const uint32_t size,
+                                          const bool     isPacked,
+                                          const uint8_t  total,
+                                          int32_t*       prev,
+                                          int32_t*       values) {
+  uint32_t cursor = 0;
+  if (!isPacked) {
+    for (uint8_t sampleIndex = 0; sampleIndex < total; ++sampleIndex) {
+      uint32_t value = 0;
+      for (uint8_t shift = 0;; shift += 7) {
+        if (cursor >= size || shift >= 7 * BMP280_COMPRESS_MAX_VARINT) { return 0; }
+        uint8_t group = in[cursor++];
+        value |= (uint32_t)(group & 0x7F) << shift;
+        if (!(group & 0x80)) { break; }
+      }
+      *prev += bmp280_unzigzag(value);
+      values[sampleIndex] = *prev;
+    }
+    return cursor;
+  }
+
+  if (cursor >= size) { return 0; }
+  uint8_t width = in[cursor++];
+  if (width > BMP280_COMPRESS_MAX_WIDTH || cursor + ((uint32_t)width * total + 7) / 8 > size) {
+    return 0;
+  }
+  uint32_t mask    = (1UL << width) - 1;
+  uint32_t bits    = 0;
+  uint8_t  bitUsed = 0;
+  for (uint8_t sampleIndex = 0; sampleIndex < total; ++sampleIndex) {
+    while (bitUsed < width) {
+      bits |= (uint32_t)in[cursor++] << bitUsed;
+      bitUsed += 8;
+    }
+    *prev += bmp280_unzigzag(bits & mask);
+    values[sampleIndex] = *prev;
+    bits >>= width;
+    bitUsed -= width;
+  }
+  return cursor;
+}
+
+void bmp280_compress_init(Bmp280CompressEncoder* encoder, const uint16_t keyInterval) {
+  encoder->total       = 0;
+  encoder->keyInterval = (0 == keyInterval) ? 1 : keyInterval;
+  encoder->sinceKey    = 0;
+  encoder->lastTemp    = 0;
+  encoder->lastPress   = 0;
+}
+
+uint16_t bmp280_compress_add(Bmp280CompressEncoder* encoder,
+                             const int32_t          rawTemp,
+                             const int32_t          rawPress,
+                             uint8_t                block[BMP280_COMPRESS_MAX_BLOCK]) {
+  encoder->rawTemp[encoder->total]  = rawTemp & BMP280_COMPRESS_ADC_MASK;
+  encoder->rawPress[encoder->total] = rawPress & BMP280_COMPRESS_ADC_MASK;
+  ++encoder->total;
+  return (BMP280_COMPRESS_BLOCK == encoder->total) ? bmp280_compress_flush(encoder, block) : 0;
+}
+
+uint16_t bmp280_compress_flush(Bmp280CompressEncoder* encoder,
+                               uint8_t                block[BMP280_COMPRESS_MAX_BLOCK]) {
+  if (0 == encoder->total) { return 0; }
+
+  bool     isKeyframe = (0 == encoder->sinceKey);
+  uint16_t size       = 2;
+  block[1]            = encoder->total;
+  if (isKeyframe) {
+    // the deltas of a keyframe start from its own first sample
+    uint32_t rawPress = (uint32_t)encoder->rawPress[0];
+    uint32_t rawTemp  = (uint32_t)encoder->rawTemp[0];
+    block[size++]     = (uint8_t)(rawPress >> 12);
+    block[size++]     = (uint8_t)(rawPress >> 4);
+    block[size++]     = (uint8_t)((rawPress << 4) | (rawTemp >> 16));
+    block[size++]     = (uint8_t)(rawTemp >> 8);
+    block[size++]     = (uint8_t)rawTemp;
+
+    encoder->lastPress = encoder->rawPress[0];
+    encoder->lastTemp  = encoder->rawTemp[0];
+  }
+
+  bool isPressPacked;
+  bool isTempPacked;
+  size += bmp280_compress_channel(
+      encoder->rawPress, encoder->total, encoder->lastPress, &block[size], &isPressPacked);
+  size += bmp280_compress_channel(
+      encoder->rawTemp, encoder->total, encoder->lastTemp, &block[size], &isTempPacked);
+  block[0] = (isKeyframe ? BMP280_COMPRESS_KEYFRAME : 0) |
+             (isPressPacked ? BMP280_COMPRESS_PRESS_PACKED : 0) |
+             (isTempPacked ? BMP280_COMPRESS_TEMP_PACKED : 0);
+
+  encoder->lastPress = encoder->rawPress[encoder->total - 1];
+  encoder->lastTemp  = encoder->rawTemp[encoder->total - 1];
+  encoder->total     = 0;
+  encoder->sinceKey  = (encoder->sinceKey + 1) % encoder->keyInterval;
+  return size;
+}
+
+void bmp280_decompress_init(Bmp280CompressDecoder* decoder) {
+  decoder->hasKeyframe = false;
+  decoder->lastTemp    = 0;
+  decoder->lastPress   = 0;
+}
+
+uint16_t bmp280_decompress_block(Bmp280CompressDecoder* decoder,
+                                 const uint8_t*         block,
+                                 const uint32_t         size,
+                                 int32_t*               rawTemp,
+                                 int32_t*               rawPress,
+                                 uint8_t*               totalSample) {
+  if (size < 2 || 0 == block[1] || block[1] > BMP280_COMPRESS_BLOCK) { return 0; }
+  uint8_t  flags  = block[0];
+  uint8_t  total  = block[1];
+  uint32_t cursor = 2;
+
+  // work on copies, keyframe included, so a malformed block leaves the decoder where it was
+  int32_t lastPress = decoder->lastPress;
+  int32_t lastTemp  = decoder->lastTemp;
+  if (flags & BMP280_COMPRESS_KEYFRAME) {
+    if (cursor + 5 > size) { return 0; }
+    const uint8_t* adc = &block[cursor];
+    lastPress = (int32_t)(((uint32_t)adc[0] << 12) | ((uint32_t)adc[1] << 4) | (adc[2] >> 4));
+    lastTemp  = (int32_t)((((uint32_t)adc[2] & 0x0F) << 16) | ((uint32_t)adc[3] << 8) | adc[4]);
+    cursor += 5;
+  } else if (!decoder->hasKeyframe) {
+    return 0;
+  }
+
+  uint32_t used = bmp280_decompress_channel(&block[cursor],
+                                            size - cursor,
+                                            flags & BMP280_COMPRESS_PRESS_PACKED,
+                                            total,
+                                            &lastPress,
+                                            rawPress);
+  if (0 == used) { return 0; }
+  cursor += used;
+  used = bmp280_decompress_channel(&block[cursor],
+                                   size - cursor,
+                                   flags & BMP280_COMPRESS_TEMP_PACKED,
+                                   total,
+                                   &lastTemp,
+                                   rawTemp);
+  if (0 == used) { return 0; }
+  cursor += used;
+
+  decoder->lastPress   = lastPress;
+  decoder->lastTemp    = lastTemp;
+  decoder->hasKeyframe = true;
+  *totalSample         = total;
+  return (uint16_t)cursor;
+}
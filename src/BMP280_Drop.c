@@ -0,0 +1,100 @@
+/**
+ * @brief drop detection on the pressure stream, see BMP280_Drop.h
+ *
+ * @file BMP280_Drop.c
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#include "include/BMP280_Drop.h"
+
+#include <stddef.h>
+
+// -dh/dp of the barometric formula times p, 44330 m * 0.1903, a scale height
+#define BMP280_DROP_SCALE_HEIGHT_M 8436ULL
+#define BMP280_DROP_MIN_AMBIENT_Q8 (30000UL * 256)
+#define BMP280_DROP_MAX_AMBIENT_Q8 (110000UL * 256)
+
+/**
+ * @brief recentSum - olderSum while descending at speedMmS: the means are span samples apart, so
+ * the difference is span * span * period times the rate of the pressure, speed * p / H
+ *
+ * The descent over a period times span^2 is at most 10^5 mm/s * 10^7 us * 256 < 2^48 in nm, so
+ * under 2^38 in um, and times a pressure under 2^25 in Q24.8 under 2^63 whatever init accepts
+ */
+static int64_t bmp280_drop_threshold(const Bmp280DropConfig* config, const uint32_t speedMmS) {
+  uint64_t descentUm = (uint64_t)speedMmS * config->periodUs * config->span * config->span / 1000;
+  return (int64_t)(descentUm * config->ambientQ8 / (BMP280_DROP_SCALE_HEIGHT_M * 1000000));
+}
+
+bool bmp280_drop_init(Bmp280Drop*             drop,
+                      const Bmp280DropConfig* config,
+                      Bmp280DropCallback      callback,
+                      void*                   context) {
+  if (0 == config->periodUs || config->periodUs > BMP280_DROP_MAX_PERIOD_US) { return false; }
+  if (config->ambientQ8 < BMP280_DROP_MIN_AMBIENT_Q8 ||
+      config->ambientQ8 > BMP280_DROP_MAX_AMBIENT_Q8 || 0 == config->confirm) {
+    return false;
+  }
+  if (0 == config->span || config->span > BMP280_DROP_MAX_SPAN) { return false; }
+  if (config->exitMmS >= config->enterMmS || config->enterMmS > BMP280_DROP_MAX_SPEED_MM_S) {
+    return false;
+  }
+
+  drop->enterSum = bmp280_drop_threshold(config, config->enterMmS);
+  drop->exitSum  = bmp280_drop_threshold(config, config->exitMmS);
+  if (drop->enterSum <= drop->exitSum) { return false; }
+  drop->span     = config->span;
+  drop->confirm  = config->confirm;
+  drop->callback = callback;
+  drop->context  = context;
+  bmp280_drop_reset(drop);
+  return true;
+}
+
+void bmp280_drop_reset(Bmp280Drop* drop) {
+  drop->recentSum   = 0;
+  drop->olderSum    = 0;
+  drop->head        = 0;
+  drop->totalSample = 0;
+  drop->overCount   = 0;
+  drop->isFalling   = false;
+}
+
+bool bmp280_drop_add(Bmp280Drop* drop, const uint32_t pressQ8) {
+  uint8_t ringSize = 2 * drop->span;
+  if (drop->totalSample < ringSize) {
+    // filling up, the first span samples are the older mean
+    drop->pressQ8[drop->totalSample] = pressQ8;
+    if (drop->totalSample < drop->span) {
+      drop->olderSum += pressQ8;
+    } else {
+      drop->recentSum += pressQ8;
+    }
+    ++drop->totalSample;
+    return false;
+  }
+
+  // the oldest sample leaves, the one in the middle moves from the recent to the older mean
+  uint8_t middle = drop->head + drop->span;
+  if (middle >= ringSize) { middle -= ringSize; }
+  drop->olderSum += drop->pressQ8[middle] - drop->pressQ8[drop->head];
+  drop->recentSum += pressQ8 - drop->pressQ8[middle];
+  drop->pressQ8[drop->head] = pressQ8;
+  if (++drop->head == ringSize) { drop->head = 0; }
+
+  // falling raises the pressure
+  int64_t rise = (int64_t)drop->recentSum - drop->olderSum;
+  if (!drop->isFalling) {
+    drop->overCount = (rise >= drop->enterSum) ? drop->overCount + 1 : 0;
+    if (drop->overCount >= drop->confirm) {
+      drop->isFalling = true;
+      drop->overCount = 0;
+      if (NULL != drop->callback) { drop->callback(drop->context, true); }
+    }
+  } else if (rise < drop->exitSum) {
+    drop->isFalling = false;
+    if (NULL != drop->callback) { drop->callback(drop->context, false); }
+  }
+  return drop->isFalling;
+}
@@ -11,40 +11,211 @@
 
 #include <assert.h>
 #include <stdbool.h>
+#include <stddef.h>
 
 #include "external/TivaC_Utils/include/TivaC_Other_Utils.h"
 #include "external/TivaC_Utils/include/bit_manipulation.h"
 #include "include/BMP280_Utils.h"
 #include "include/BMP280_Ware.h"
-#include "include/TivaC_I2C.h"
-#include "include/TivaC_SPI.h"
+#include "include/TivaC_CycleCounter.h"
 
-// offset from BMP280 base register
-typedef enum {
-  Status = 0,
-  Ctrl_meas,
-  Config,
-  Press_msb = 4,
-  Press_lsb,
-  Press_xlsb,
-  Temp_msb,
-  Temp_lsb,
-  Temp_xlsb
-} bmp280_regName;
+/**
+ * @brief assemble a 20 bit raw adc value from its msb, lsb and xlsb registers
+ *
+ */
+static int32_t bmp280_parse_raw_adc(const uint8_t* rawData) {
+  return (int32_t)((((uint32_t)(rawData[0])) << 12) | (((uint32_t)(rawData[1])) << 4) |
+                   ((uint32_t)rawData[2] >> 4));
+}
+
+/**
+ * @brief current time of the sensor's time source, 0 when it has none
+ *
+ */
+static uint32_t bmp280_now_us(const bmp280* sensor) {
+  return (NULL != sensor->timeSource) ? time_source_now_us(sensor->timeSource) : 0;
+}
 
-// added with the bmp280_regName to get the correct address
-#define BMP280_BASEADDR 0xF3
+/**
+ * @brief whether the reset wait can be timed: on the time source of the sensor, or on the cycle
+ * counter, which is enabled here, false only on a part without the counter
+ *
+ */
+static bool bmp280_reset_is_timed(const bmp280* sensor) {
+  return (NULL != sensor->timeSource) || cycle_counter_open();
+}
 
-#define RAW_TEM_TOTAL_BYTE 3
-#define RAW_PRESS_TOTAL_BYTE 3
-#define BMP280_CALIB_START_ADDR 0x88
+/**
+ * @brief start of a timed reset wait, on the time source of the sensor when it has one so handles
+ * on a host bus keep their own clock, on the cycle counter otherwise
+ *
+ */
+static uint32_t bmp280_reset_start(const bmp280* sensor) {
+  return (NULL != sensor->timeSource) ? time_source_now_us(sensor->timeSource)
+                                      : cycle_counter_get();
+}
 
-// the two special addresses
-#define BMP280_RESADDR 0xE0
-#define BMP280_IDARR 0xD0
+static uint32_t bmp280_reset_elapsed_us(const bmp280* sensor, const uint32_t start) {
+  return (NULL != sensor->timeSource) ? time_source_elapsed_us(sensor->timeSource, start)
+                                      : cycle_counter_elapsed_us(start);
+}
 
-#define BMP280_MEASURING_MASK 0x8
-#define BMP280_UPDATING_MASK 0x1
+/**
+ * @brief the TivaC peripheral of the protocol
+ *
+ */
+static const Bmp280Bus* bmp280_default_bus(const Bmp280ComProtocol protocol) {
+  return (SPI == protocol) ? bmp280_bus_spi0() : bmp280_bus_i2c0();
+}
+
+/**
+ * @brief estimate when the sample held by the data registers at atUs finished converting
+ *
+ * A burst read locks the data registers when it starts, so atUs is the start of the read, a
+ * conversion that ends while the bytes are on the bus is not in the sample
+ * The schedule follows the typical timings of the datasheet from conversionAnchorUs: in normal
+ * mode a conversion ends every t_measure + t_sb, in forced mode the anchor is the only one
+ */
+static uint32_t bmp280_conversion_done_us(const bmp280* sensor, const uint32_t atUs) {
+  int32_t sinceAnchorUs = time_source_diff_us(atUs, sensor->conversionAnchorUs);
+  if (Normal != sensor->mode || sinceAnchorUs <= 0) { return sensor->conversionAnchorUs; }
+
+  uint32_t periodUs = bmp280_measure_time_us(sensor) + bmp280_standby_time_us(sensor);
+  return sensor->conversionAnchorUs + ((uint32_t)sinceAnchorUs / periodUs) * periodUs;
+}
+
+/**
+ * @brief read the data registers and count the outcome in the sensor stats
+ * @param readStartUs return when the read started, the sample is the one held at that time
+ */
+static Bmp280ErrCode bmp280_read_sample(bmp280*       sensor,
+                                        const uint8_t startAddr,
+                                        uint8_t*      rawData,
+                                        const uint8_t totalRegister,
+                                        uint32_t*     readStartUs) {
+  uint32_t startUs = bmp280_now_us(sensor);
+  *readStartUs     = startUs;
+  Bmp280ErrCode errCode = bmp280_get_register(sensor, startAddr, rawData, totalRegister);
+  if (ERR_NO_ERR != errCode) {
+    BUS_STATS_ADD(sensor->stats, failedRead, 1);
+    return errCode;
+  }
+  BUS_STATS_ADD(sensor->stats, sample, 1);
+#if BUS_STATS_ENABLE
+  if (NULL != sensor->timeSource) {
+    latency_hist_add(&sensor->stats.busTime, time_source_elapsed_us(sensor->timeSource, startUs));
+  }
+#else
+  (void)startUs;
+#endif
+  return ERR_NO_ERR;
+}
+
+/**
+ * @brief timestamp a sample that is about to be returned and record its latencies
+ * @param startUs when the read was requested
+ * @param readStartUs when the data registers were read, see bmp280_read_sample
+ * @param compStartUs when the compensation started
+ */
+static void bmp280_deliver_sample(bmp280*        sensor,
+                                  const uint32_t startUs,
+                                  const uint32_t readStartUs,
+                                  const uint32_t compStartUs) {
+  if (NULL == sensor->timeSource) { return; }
+  sensor->deliveredUs      = time_source_now_us(sensor->timeSource);
+  sensor->conversionDoneUs = bmp280_conversion_done_us(sensor, readStartUs);
+#if BUS_STATS_ENABLE
+  int32_t sampleAgeUs = time_source_diff_us(sensor->deliveredUs, sensor->conversionDoneUs);
+  latency_hist_add(&sensor->stats.readLatency, sensor->deliveredUs - startUs);
+  latency_hist_add(&sensor->stats.compTime, sensor->deliveredUs - compStartUs);
+  latency_hist_add(&sensor->stats.sampleAge, (sampleAgeUs > 0) ? (uint32_t)sampleAgeUs : 0);
+#else
+  (void)startUs;
+  (void)compStartUs;
+#endif
+}
+
+/**
+ * @brief read calibration data into the sensor struct if it has not been done yet
+ *
+ */
+static Bmp280ErrCode bmp280_load_calibration(bmp280* sensor) {
+  if (false == sensor->isCalibLoaded) {
+    BMP280_TRY_FUNC(bmp280_get_calibration_data(sensor, NULL));
+  }
+  return ERR_NO_ERR;
+}
+
+/**
+ * @brief predefined settings together with their register bytes, kept in flash
+ */
+typedef struct {
+  Bmp280Coeff         tempSamp;
+  Bmp280Coeff         presSamp;
+  Bmp280Coeff         iirFilter;
+  Bmp280SamplSettings samplSet;
+  Bmp280OperMode      mode;
+  Bmp280StandbyTime   standbyTime;
+  uint8_t             ctrlMeasByte;
+  uint8_t             configByte;
+} Bmp280Preset;
+
+// recommended settings from the datasheet pg 19, indexed by Bmp280MeasureSettings
+static const Bmp280Preset bmp280Presets[] = {
+    [HandLow]     = {.tempSamp     = x2,
+                     .presSamp     = x16,
+                     .iirFilter    = x4,
+                     .samplSet     = UltraHigh,
+                     .mode         = Normal,
+                     .standbyTime  = t62_5ms,
+                     .ctrlMeasByte = BMP280_CTRL_MEAS_BYTE(
+                         BMP280_OSRS_X2, BMP280_OSRS_X16, BMP280_MODE_NORMAL),
+                     .configByte   = BMP280_CONFIG_BYTE(BMP280_STANDBY_62_5MS, BMP280_FILTER_X4)},
+    [HandDynamic] = {.tempSamp     = x1,
+                     .presSamp     = x4,
+                     .iirFilter    = x16,
+                     .samplSet     = Standard,
+                     .mode         = Normal,
+                     .standbyTime  = t0_5ms,
+                     .ctrlMeasByte = BMP280_CTRL_MEAS_BYTE(
+                         BMP280_OSRS_X1, BMP280_OSRS_X4, BMP280_MODE_NORMAL),
+                     .configByte   = BMP280_CONFIG_BYTE(BMP280_STANDBY_0_5MS, BMP280_FILTER_X16)},
+    [WeatherStat] = {.tempSamp     = x1,
+                     .presSamp     = x1,
+                     .iirFilter    = x0,
+                     .samplSet     = UltraLow,
+                     .mode         = Forced,
+                     .standbyTime  = t0_5ms,  // unused in forced mode
+                     .ctrlMeasByte = BMP280_CTRL_MEAS_BYTE(
+                         BMP280_OSRS_X1, BMP280_OSRS_X1, BMP280_MODE_FORCED),
+                     .configByte   = BMP280_CONFIG_BYTE(BMP280_STANDBY_0_5MS, BMP280_FILTER_OFF)},
+    [ElevDetec]   = {.tempSamp     = x1,
+                     .presSamp     = x4,
+                     .iirFilter    = x4,
+                     .samplSet     = Standard,
+                     .mode         = Normal,
+                     .standbyTime  = t125ms,
+                     .ctrlMeasByte = BMP280_CTRL_MEAS_BYTE(
+                         BMP280_OSRS_X1, BMP280_OSRS_X4, BMP280_MODE_NORMAL),
+                     .configByte   = BMP280_CONFIG_BYTE(BMP280_STANDBY_125MS, BMP280_FILTER_X4)},
+    [DropDetec]   = {.tempSamp     = x1,
+                     .presSamp     = x2,
+                     .iirFilter    = x0,
+                     .samplSet     = Low,
+                     .mode         = Normal,
+                     .standbyTime  = t0_5ms,
+                     .ctrlMeasByte = BMP280_CTRL_MEAS_BYTE(
+                         BMP280_OSRS_X1, BMP280_OSRS_X2, BMP280_MODE_NORMAL),
+                     .configByte   = BMP280_CONFIG_BYTE(BMP280_STANDBY_0_5MS, BMP280_FILTER_OFF)},
+    [IndoorNav]   = {.tempSamp     = x2,
+                     .presSamp     = x16,
+                     .iirFilter    = x16,
+                     .samplSet     = UltraHigh,
+                     .mode         = Normal,
+                     .standbyTime  = t0_5ms,
+                     .ctrlMeasByte = BMP280_CTRL_MEAS_BYTE(
+                         BMP280_OSRS_X2, BMP280_OSRS_X16, BMP280_MODE_NORMAL),
+                     .configByte   = BMP280_CONFIG_BYTE(BMP280_STANDBY_0_5MS, BMP280_FILTER_X16)}};
 
 /**
  * @brief initialize the bmp280 with predefined value in the datasheet
@@ -52,64 +223,20 @@ typedef enum {
  */
 Bmp280ErrCode bmp280_create_predefined_settings(bmp280*                     sensor,
                                                 const Bmp280MeasureSettings settings) {
-  switch (settings) {
-    case HandLow:
-      sensor->mode        = Normal;
-      sensor->tempSamp    = x2;
-      sensor->presSamp    = x16;
-      sensor->samplSet    = UltraHigh;
-      sensor->iirFilter   = x4;
-      sensor->standbyTime = 62.5;
-      break;
-
-    case HandDynamic:
-      sensor->mode        = Normal;
-      sensor->tempSamp    = x1;
-      sensor->presSamp    = x4;
-      sensor->samplSet    = Standard;
-      sensor->iirFilter   = x16;
-      sensor->standbyTime = 0.5;
-      break;
-
-    case WeatherStat:
-      sensor->mode        = Forced;
-      sensor->tempSamp    = x1;
-      sensor->presSamp    = x1;
-      sensor->samplSet    = UltraLow;
-      sensor->iirFilter   = x0;
-      sensor->standbyTime = 0.5;  // 0.05 is placeholder for now
-      break;
-
-    case ElevDetec:
-      sensor->mode        = Normal;
-      sensor->tempSamp    = x1;
-      sensor->presSamp    = x4;
-      sensor->samplSet    = Standard;
-      sensor->iirFilter   = x4;
-      sensor->standbyTime = 125;
-      break;
-
-    case DropDetec:
-      sensor->mode        = Normal;
-      sensor->tempSamp    = x1;
-      sensor->presSamp    = x2;
-      sensor->samplSet    = Low;
-      sensor->iirFilter   = x0;
-      sensor->standbyTime = 0.5;
-      break;
-
-    case IndoorNav:
-      sensor->mode        = Normal;
-      sensor->tempSamp    = x2;
-      sensor->presSamp    = x16;
-      sensor->samplSet    = UltraHigh;
-      sensor->iirFilter   = x16;
-      sensor->standbyTime = 0.5;
-      break;
-
-    default:
-      return ERR_SETTING_UNRECOGNIZED;
+  if (NULL == sensor) { return ERR_SENSOR_UNITIALIZED; }
+  if ((uint32_t)settings >= sizeof(bmp280Presets) / sizeof(bmp280Presets[0])) {
+    return ERR_SETTING_UNRECOGNIZED;
   }
+
+  const Bmp280Preset* preset = &bmp280Presets[settings];
+  sensor->mode               = preset->mode;
+  sensor->tempSamp           = preset->tempSamp;
+  sensor->presSamp           = preset->presSamp;
+  sensor->samplSet           = preset->samplSet;
+  sensor->iirFilter          = preset->iirFilter;
+  sensor->standbyTime        = preset->standbyTime;
+  sensor->ctrlMeasByte       = preset->ctrlMeasByte;
+  sensor->configByte         = preset->configByte;
   return ERR_NO_ERR;
 }
 
@@ -123,7 +250,7 @@ Bmp280ErrCode bmp280_create_custom_setting(bmp280*                   sensor,
                                            const Bmp280Coeff         iirFilter,
                                            const Bmp280SamplSettings samplSet,
                                            const Bmp280OperMode      mode,
-                                           const float               standbyTime) {
+                                           const Bmp280StandbyTime   standbyTime) {
   sensor->mode        = mode;
   sensor->tempSamp    = tempSamp;
   sensor->presSamp    = presSamp;
@@ -131,6 +258,8 @@ Bmp280ErrCode bmp280_create_custom_setting(bmp280*                   sensor,
   sensor->iirFilter   = iirFilter;
   sensor->standbyTime = standbyTime;
   BMP280_TRY_FUNC(bmp280_check_setting(sensor));
+  BMP280_TRY_FUNC(bmp280_make_ctrl_byte(sensor, &sensor->ctrlMeasByte));
+  BMP280_TRY_FUNC(bmp280_make_cfg_byte(sensor, &sensor->configByte));
   return ERR_NO_ERR;
 }
 
@@ -144,7 +273,23 @@ Bmp280ErrCode bmp280_init(bmp280* sensor, const Bmp280ComProtocol protocol, cons
 
   sensor->address  = address;
   sensor->protocol = protocol;  // settings obtained in datasheet pg 19
-
+  sensor->bus      = bmp280_default_bus(protocol);
+
+  // calibration is read lazily on the first measurement
+  sensor->isCalibLoaded = false;
+  sensor->tFineAge      = BMP280_TFINE_STALE;
+  sensor->tFineMaxAge   = 0;
+
+  sensor->timeSource         = NULL;
+  sensor->conversionAnchorUs = 0;
+  sensor->conversionDoneUs   = 0;
+  sensor->deliveredUs        = 0;
+  sensor->trace              = NULL;
+
+#if BUS_STATS_ENABLE
+  Bmp280SensorStats emptyStats = {0};
+  sensor->stats                = emptyStats;
+#endif
   return ERR_NO_ERR;
 }
 
@@ -154,7 +299,7 @@ Bmp280ErrCode bmp280_init(bmp280* sensor, const Bmp280ComProtocol protocol, cons
  */
 Bmp280ErrCode bmp280_open(bmp280* sensor) {
   BMP280_TRY_FUNC(bmp280_check_setting(sensor));
-  bmp280_open_i2c_spi(sensor);
+  BMP280_TRY_FUNC(bmp280_open_i2c_spi(sensor));
   return ERR_NO_ERR;
 }
 
@@ -172,25 +317,49 @@ Bmp280ErrCode bmp280_close(bmp280* sensor) {
  *
  */
 Bmp280ErrCode bmp280_get_id(bmp280* sensor, uint8_t* returnID) {
-  bmp280_get_register(sensor, BMP280_IDARR, returnID, 1);
+  BMP280_TRY_FUNC(bmp280_get_register(sensor, BMP280_IDARR, returnID, 1));
   sensor->ID = *returnID;
   return ERR_NO_ERR;
 }
 
 /**
  * @brief perform power reset on the bmp280
- * There is a 5ms seconds delay to allow the bmp280 to properly wake up
+ * return once the bmp280 has copied its NVM, see bmp280_reset_wait
  */
-Bmp280ErrCode bmp280_reset(bmp280* sensor) {
+Bmp280ErrCode bmp280_reset(bmp280* sensor) { return bmp280_reset_wait(sensor, NULL); }
+
+/**
+ * @brief perform power reset on the bmp280 and poll im_update until the NVM copy is done
+ *
+ * The copy typically takes about 2 ms, the spin gives up after BMP280_RESET_TIMEOUT_US, or after
+ * BMP280_RESET_MAX_POLL status reads on a part with neither a time source nor the cycle counter
+ * @param wakeTimeUs return time from the reset command to the bmp280 being ready, 0 only when the
+ * wait can't be timed, can be NULL
+ */
+Bmp280ErrCode bmp280_reset_wait(bmp280* sensor, uint32_t* wakeTimeUs) {
   BMP280_TRY_FUNC(bmp280_port_prep(sensor));
 
   uint8_t resetRegister[1];
   uint8_t resetData[1];
   resetRegister[0] = BMP280_RESADDR;
-  resetData[0]     = 0xB6;  // obtain from page 24 datasheet
+  resetData[0]     = BMP280_RESET_CMD;
+
+  BMP280_TRY_FUNC(bmp280_write_register(sensor, resetRegister, 1, resetData));
+  bool     isTimed   = bmp280_reset_is_timed(sensor);
+  uint32_t start     = isTimed ? bmp280_reset_start(sensor) : 0;
+  uint32_t totalPoll = 0;
+
+  // im_update stays set while the NVM data is copied into the image registers
+  sensor->lastKnowStatus.isUpdating = true;
+  while (sensor->lastKnowStatus.isUpdating) {
+    bool isOver = isTimed ? bmp280_reset_elapsed_us(sensor, start) > BMP280_RESET_TIMEOUT_US
+                          : totalPoll >= BMP280_RESET_MAX_POLL;
+    if (isOver) { return ERR_RESET_TIMEOUT; }
+    BMP280_TRY_FUNC(bmp280_get_status(sensor));
+    ++totalPoll;
+  }
 
-  bmp280_write_register(sensor, resetRegister, 1, resetData);
-  delayms(5);  // give the board some time to wake up
+  if (NULL != wakeTimeUs) { *wakeTimeUs = isTimed ? bmp280_reset_elapsed_us(sensor, start) : 0; }
   return ERR_NO_ERR;
 }
 
@@ -200,20 +369,17 @@ Bmp280ErrCode bmp280_reset(bmp280* sensor) {
  *
  */
 Bmp280ErrCode bmp280_update_setting(bmp280* sensor) {
-  // preparing data byte for writing to bmp280 register
-  uint8_t i2cRegisterList[2];
-  uint8_t i2cRegisterData[2];
-
-  // handle control byte first
-  i2cRegisterList[0] = BMP280_BASEADDR + Ctrl_meas;
-  bmp280_make_ctrl_byte(sensor, &i2cRegisterData[0]);
-
-  // handle config byte
-  i2cRegisterList[1] = BMP280_BASEADDR + Config;
-  bmp280_make_cfg_byte(sensor, &i2cRegisterData[1]);
-
-  bmp280_write_register(sensor, i2cRegisterList, 2, i2cRegisterData);
-
+  // config goes first, in normal mode t_sb and the filter should be set before the mode starts
+  // the measurements
+  uint8_t configRegister[1]   = {BMP280_BASEADDR + Config};
+  uint8_t ctrlMeasRegister[1] = {BMP280_BASEADDR + Ctrl_meas};
+  BMP280_TRY_FUNC(bmp280_write_register(sensor, configRegister, 1, &sensor->configByte));
+
+  // writing ctrl_meas starts the first conversion in normal mode and the only one in forced mode,
+  // the schedule starts with the write, the same point of the transfer the reads are timed at
+  uint32_t writeStartUs = bmp280_now_us(sensor);
+  BMP280_TRY_FUNC(bmp280_write_register(sensor, ctrlMeasRegister, 1, &sensor->ctrlMeasByte));
+  sensor->conversionAnchorUs = writeStartUs + bmp280_measure_time_us(sensor);
   return ERR_NO_ERR;
 }
 
@@ -222,7 +388,7 @@ Bmp280ErrCode bmp280_update_setting(bmp280* sensor) {
  *
  */
 Bmp280ErrCode bmp280_get_ctr_meas(bmp280* sensor, uint8_t* ctrlMeasReturn) {
-  bmp280_get_register(sensor, BMP280_BASEADDR + Ctrl_meas, ctrlMeasReturn, 1);
+  BMP280_TRY_FUNC(bmp280_get_register(sensor, BMP280_BASEADDR + Ctrl_meas, ctrlMeasReturn, 1));
   return ERR_NO_ERR;
 }
 
@@ -231,7 +397,7 @@ Bmp280ErrCode bmp280_get_ctr_meas(bmp280* sensor, uint8_t* ctrlMeasReturn) {
  *
  */
 Bmp280ErrCode bmp280_get_config(bmp280* sensor, uint8_t* configReturn) {
-  bmp280_get_register(sensor, BMP280_BASEADDR + Config, configReturn, 1);
+  BMP280_TRY_FUNC(bmp280_get_register(sensor, BMP280_BASEADDR + Config, configReturn, 1));
   return ERR_NO_ERR;
 }
 
@@ -241,7 +407,7 @@ Bmp280ErrCode bmp280_get_config(bmp280* sensor, uint8_t* configReturn) {
  */
 Bmp280ErrCode bmp280_get_status(bmp280* sensor) {
   uint8_t statusReturn;
-  bmp280_get_register(sensor, BMP280_BASEADDR + Status, &statusReturn, 1);
+  BMP280_TRY_FUNC(bmp280_get_register(sensor, BMP280_BASEADDR + Status, &statusReturn, 1));
   bit_get(statusReturn, BMP280_MEASURING_MASK) ? (sensor->lastKnowStatus.isMeasuring = true)
                                                : (sensor->lastKnowStatus.isMeasuring = false);
   bit_get(statusReturn, BMP280_UPDATING_MASK) ? (sensor->lastKnowStatus.isUpdating = true)
@@ -250,40 +416,229 @@ Bmp280ErrCode bmp280_get_status(bmp280* sensor) {
 }
 
 /**
- * @brief used to read compensated temperature and pressure
+ * @brief used to read compensated temperature and pressure in one burst
  * @param temperatureC return temperature
  * @param pressPa return pressure
- * @param calibParam calibration data obtained beforehand
  */
-Bmp280ErrCode bmp280_get_temp_press(bmp280*          sensor,
-                                    float*           temperatureC,
-                                    float*           pressPa,
-                                    Bmp280CalibParam calibParam) {
+Bmp280ErrCode bmp280_get_temp_press(bmp280* sensor, float* temperatureC, float* pressPa) {
+  int32_t  temperatureCentiC;
+  uint32_t pressQ24_8;
+  BMP280_TRY_FUNC(bmp280_get_temp_press_fixed(sensor, &temperatureCentiC, &pressQ24_8));
+  *temperatureC = (float)temperatureCentiC * 0.01;
+  *pressPa      = (float)pressQ24_8 / 256.0;
+  return ERR_NO_ERR;
+}
+
+/**
+ * @brief bmp280_get_temp_press without the float conversion, for fixed point consumers
+ * @param temperatureCentiC return temperature in 0.01 C
+ * @param pressQ24_8 return pressure in Pa as Q24.8, as it comes out of bmp280_compensate_P_int64
+ */
+Bmp280ErrCode bmp280_get_temp_press_fixed(bmp280*   sensor,
+                                          int32_t*  temperatureCentiC,
+                                          uint32_t* pressQ24_8) {
+  uint32_t startUs = bmp280_now_us(sensor);
+  uint32_t readStartUs;
   BMP280_TRY_FUNC(bmp280_port_prep(sensor));
-  uint8_t rawData[RAW_TEM_TOTAL_BYTE + RAW_PRESS_TOTAL_BYTE + 3];
-  bmp280_get_register(
-      sensor, BMP280_BASEADDR + Press_msb, rawData, RAW_TEM_TOTAL_BYTE + RAW_PRESS_TOTAL_BYTE + 3);
-  int32_t rawPress = (int32_t)((((uint32_t)(rawData[0])) << 12) | (((uint32_t)(rawData[1])) << 4) |
-                               ((uint32_t)rawData[2] >> 4));
-
-  int32_t rawTemp = (int32_t)((((int32_t)(rawData[3])) << 12) | (((int32_t)(rawData[4])) << 4) |
-                              (((int32_t)(rawData[5])) >> 4));
-  *temperatureC   = (float)bmp280_compensate_T_int32(rawTemp, &calibParam) * 0.01;
-  *pressPa        = (float)bmp280_compensate_P_int64(rawPress, &calibParam) / 256.0;
+  BMP280_TRY_FUNC(bmp280_load_calibration(sensor));
+  uint8_t rawData[RAW_PRESS_TOTAL_BYTE + RAW_TEM_TOTAL_BYTE];
+  BMP280_TRY_FUNC(bmp280_read_sample(
+      sensor, BMP280_BASEADDR + Press_msb, rawData, sizeof(rawData), &readStartUs));
+  int32_t rawPress = bmp280_parse_raw_adc(&rawData[0]);
+  int32_t rawTemp  = bmp280_parse_raw_adc(&rawData[RAW_PRESS_TOTAL_BYTE]);
+
+  // temperature has to be compensated first since it refreshes t_fine
+  uint32_t compStartUs = bmp280_now_us(sensor);
+  *temperatureCentiC   = bmp280_compensate_T_int32(rawTemp, &sensor->calibParam);
+  *pressQ24_8          = bmp280_compensate_P_int64(rawPress, &sensor->calibParam);
+  sensor->tFineAge     = 0;
+  BUS_STATS_ADD(sensor->stats, compensation, 2);
+  bmp280_deliver_sample(sensor, startUs, readStartUs, compStartUs);
+  return ERR_NO_ERR;
+}
+
+/**
+ * @brief read the pressure and temperature adc values in one burst without compensating them,
+ * e.g. to log them with BMP280_RawLog and compensate them later
+ * @param rawTemp return 20 bit temperature adc value
+ * @param rawPress return 20 bit pressure adc value
+ */
+Bmp280ErrCode bmp280_get_raw_temp_press(bmp280* sensor, int32_t* rawTemp, int32_t* rawPress) {
+  uint32_t startUs = bmp280_now_us(sensor);
+  uint32_t readStartUs;
+  BMP280_TRY_FUNC(bmp280_port_prep(sensor));
+  uint8_t rawData[RAW_PRESS_TOTAL_BYTE + RAW_TEM_TOTAL_BYTE];
+  BMP280_TRY_FUNC(bmp280_read_sample(
+      sensor, BMP280_BASEADDR + Press_msb, rawData, sizeof(rawData), &readStartUs));
+  *rawPress = bmp280_parse_raw_adc(&rawData[0]);
+  *rawTemp  = bmp280_parse_raw_adc(&rawData[RAW_PRESS_TOTAL_BYTE]);
+  bmp280_deliver_sample(sensor, startUs, readStartUs, bmp280_now_us(sensor));
+  return ERR_NO_ERR;
+}
+
+/**
+ * @brief read only the temperature registers and refresh t_fine
+ * @param temperature return temperature in degree C
+ */
+Bmp280ErrCode bmp280_get_temp(bmp280* sensor, float* temperature) {
+  uint32_t startUs = bmp280_now_us(sensor);
+  uint32_t readStartUs;
+  BMP280_TRY_FUNC(bmp280_port_prep(sensor));
+  BMP280_TRY_FUNC(bmp280_load_calibration(sensor));
+  uint8_t rawData[RAW_TEM_TOTAL_BYTE];
+  BMP280_TRY_FUNC(bmp280_read_sample(
+      sensor, BMP280_BASEADDR + Temp_msb, rawData, RAW_TEM_TOTAL_BYTE, &readStartUs));
+
+  uint32_t compStartUs = bmp280_now_us(sensor);
+  *temperature =
+      (float)bmp280_compensate_T_int32(bmp280_parse_raw_adc(rawData), &sensor->calibParam) * 0.01;
+  sensor->tFineAge = 0;
+  BUS_STATS_ADD(sensor->stats, compensation, 1);
+  bmp280_deliver_sample(sensor, startUs, readStartUs, compStartUs);
+  return ERR_NO_ERR;
+}
+
+/**
+ * @brief read pressure, only the pressure registers are read while t_fine is recent enough
+ *
+ * Pressure compensation depends on t_fine from the temperature, once t_fine has been reused
+ * tFineMaxAge times both values are read again in one burst, see bmp280_set_tfine_max_age
+ * @param pressure return pressure in Pa
+ */
+Bmp280ErrCode bmp280_get_press(bmp280* sensor, float* pressure) {
+  if (sensor->tFineAge >= sensor->tFineMaxAge) {
+    float temperature;
+    return bmp280_get_temp_press(sensor, &temperature, pressure);
+  }
+
+  uint32_t startUs = bmp280_now_us(sensor);
+  uint32_t readStartUs;
+  BMP280_TRY_FUNC(bmp280_port_prep(sensor));
+  uint8_t rawData[RAW_PRESS_TOTAL_BYTE];
+  BMP280_TRY_FUNC(bmp280_read_sample(
+      sensor, BMP280_BASEADDR + Press_msb, rawData, RAW_PRESS_TOTAL_BYTE, &readStartUs));
+
+  uint32_t compStartUs = bmp280_now_us(sensor);
+  *pressure =
+      (float)bmp280_compensate_P_int64(bmp280_parse_raw_adc(rawData), &sensor->calibParam) / 256.0;
+  ++sensor->tFineAge;
+  BUS_STATS_ADD(sensor->stats, compensation, 1);
+  bmp280_deliver_sample(sensor, startUs, readStartUs, compStartUs);
+  return ERR_NO_ERR;
+}
+
+/**
+ * @brief set how many pressure-only reads may reuse the last t_fine
+ *
+ * 0 makes every bmp280_get_press read temperature as well, larger values save 3 bytes per read at
+ * the cost of compensating with a temperature that is up to maxAge samples old
+ */
+Bmp280ErrCode bmp280_set_tfine_max_age(bmp280* sensor, const uint8_t maxAge) {
+  if (NULL == sensor) { return ERR_SENSOR_UNITIALIZED; }
+  sensor->tFineMaxAge = maxAge;
   return ERR_NO_ERR;
 }
 
 /**
  * @brief used to read factory calibration data from the bmp280
  *
+ * the data is kept in the sensor struct for later reads, calibParam can be NULL if the caller
+ * doesn't need a copy
  */
 Bmp280ErrCode bmp280_get_calibration_data(bmp280* sensor, Bmp280CalibParam* calibParam) {
   BMP280_TRY_FUNC(bmp280_port_prep(sensor));
   uint8_t rawCalibData[BMP280_CALIB_DATA_SIZE + 5];
 
   // LSB bits are at lower addr compared to MSB so the first number read will be LSB
-  bmp280_get_register(sensor, BMP280_CALIB_START_ADDR, rawCalibData, BMP280_CALIB_DATA_SIZE + 5);
-  bmp280_get_calib_param(rawCalibData, calibParam);
+  BMP280_TRY_FUNC(bmp280_get_register(
+      sensor, BMP280_CALIB_START_ADDR, rawCalibData, BMP280_CALIB_DATA_SIZE + 5));
+  bmp280_get_calib_param(rawCalibData, &sensor->calibParam);
+  sensor->isCalibLoaded = true;
+  sensor->tFineAge      = BMP280_TFINE_STALE;
+
+  if (NULL != calibParam) { *calibParam = sensor->calibParam; }
+  return ERR_NO_ERR;
+}
+
+/**
+ * @brief copy the counters of the sensor and of the bus it is on
+ *
+ */
+Bmp280ErrCode bmp280_get_stats(bmp280* sensor, Bmp280Stats* stats) {
+  if (NULL == sensor) { return ERR_SENSOR_UNITIALIZED; }
+  Bmp280Stats emptyStats = {0};
+  *stats                 = emptyStats;
+#if BUS_STATS_ENABLE
+  stats->sensor = sensor->stats;
+  if (NULL != sensor->bus->ops->get_stats) {
+    bmp280_bus_lock(sensor->bus);
+    sensor->bus->ops->get_stats(sensor->bus->context, &stats->bus);
+    bmp280_bus_unlock(sensor->bus);
+  }
+#endif
+  return ERR_NO_ERR;
+}
+
+/**
+ * @brief clear the counters of the sensor and of the bus it is on
+ *
+ */
+Bmp280ErrCode bmp280_reset_stats(bmp280* sensor) {
+  if (NULL == sensor) { return ERR_SENSOR_UNITIALIZED; }
+#if BUS_STATS_ENABLE
+  Bmp280SensorStats emptyStats = {0};
+  sensor->stats                = emptyStats;
+  if (NULL != sensor->bus->ops->reset_stats) {
+    bmp280_bus_lock(sensor->bus);
+    sensor->bus->ops->reset_stats(sensor->bus->context);
+    bmp280_bus_unlock(sensor->bus);
+  }
+#endif
+  return ERR_NO_ERR;
+}
+
+/**
+ * @brief timestamp samples and fill the latency histograms with source
+ *
+ * The conversion schedule is anchored by bmp280_update_setting, set the source before it
+ */
+Bmp280ErrCode bmp280_set_time_source(bmp280* sensor, const TimeSource* source) {
+  if (NULL == sensor) { return ERR_SENSOR_UNITIALIZED; }
+  sensor->timeSource = source;
+  return ERR_NO_ERR;
+}
 
+/**
+ * @brief move the sensor to another bus, NULL puts it back on the TivaC peripheral of its protocol
+ *
+ * Call it before bmp280_open, the address given to bmp280_init is kept
+ */
+Bmp280ErrCode bmp280_set_bus(bmp280* sensor, const Bmp280Bus* bus) {
+  if (NULL == sensor) { return ERR_SENSOR_UNITIALIZED; }
+  sensor->bus = (NULL != bus) ? bus : bmp280_default_bus(sensor->protocol);
+  return ERR_NO_ERR;
+}
+
+/**
+ * @brief record every register transfer of the sensor into trace, see Bus_Trace.h
+ *
+ */
+Bmp280ErrCode bmp280_set_trace(bmp280* sensor, BusTrace* trace) {
+  if (NULL == sensor) { return ERR_SENSOR_UNITIALIZED; }
+  sensor->trace = trace;
+  return ERR_NO_ERR;
+}
+
+/**
+ * @brief timestamps of the last sample, both 0 until a sample is read with a time source set
+ * @param conversionDoneUs return estimated end of the conversion, see bmp280_conversion_done_us
+ * @param deliveredUs return when the sample was returned to the caller
+ */
+Bmp280ErrCode bmp280_get_sample_time(bmp280*   sensor,
+                                     uint32_t* conversionDoneUs,
+                                     uint32_t* deliveredUs) {
+  if (NULL == sensor) { return ERR_SENSOR_UNITIALIZED; }
+  if (NULL != conversionDoneUs) { *conversionDoneUs = sensor->conversionDoneUs; }
+  if (NULL != deliveredUs) { *deliveredUs = sensor->deliveredUs; }
   return ERR_NO_ERR;
 }
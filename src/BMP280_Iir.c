@@ -0,0 +1,43 @@
+/**
+ * @brief the IIR filter of the bmp280 in software, see BMP280_Iir.h
+ *
+ * @file BMP280_Iir.c
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#include "include/BMP280_Iir.h"
+
+// log2 of the coefficient of iirFilter, x1 has no filter setting
+static const uint8_t bmp280IirShift[] = {[x0] = 0, [x2] = 1, [x4] = 2, [x8] = 3, [x16] = 4};
+
+bool bmp280_iir_init(Bmp280Iir* iir, const Bmp280Coeff* coeff, const uint8_t totalStage) {
+  if (0 == totalStage || totalStage > BMP280_IIR_MAX_STAGE) { return false; }
+  for (uint8_t stage = 0; stage < totalStage; ++stage) {
+    if (coeff[stage] < x0 || coeff[stage] > x16 || x1 == coeff[stage]) { return false; }
+    iir->shift[stage] = bmp280IirShift[coeff[stage]];
+  }
+  iir->totalStage = totalStage;
+  bmp280_iir_reset(iir);
+  return true;
+}
+
+void bmp280_iir_reset(Bmp280Iir* iir) { iir->hasSample = false; }
+
+/**
+ * @brief the shift of a negative difference rounds down like the division of the datasheet, the
+ * compilers the driver is built with shift signed values arithmetically
+ *
+ */
+void bmp280_iir_add(Bmp280Iir* iir, const int32_t value) {
+  if (!iir->hasSample) {
+    for (uint8_t stage = 0; stage < iir->totalStage; ++stage) { iir->state[stage] = value; }
+    iir->hasSample = true;
+    return;
+  }
+  for (uint8_t stage = 0; stage < iir->totalStage; ++stage) {
+    iir->state[stage] += (value - iir->state[stage]) >> iir->shift[stage];
+  }
+}
+
+int32_t bmp280_iir_get(const Bmp280Iir* iir, const uint8_t stage) { return iir->state[stage]; }
@@ -0,0 +1,71 @@
+/**
+ * @brief compensation of many bmp280s at once, see BMP280_Multi.h
+ *
+ * Each lane runs the inline helpers of BMP280_Ware that bmp280_compensate_T_int32 and
+ * bmp280_compensate_P_int64 are built on, followed by the float conversion of
+ * bmp280_get_temp_press
+ *
+ * @file BMP280_Multi.c
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#include "include/BMP280_Multi.h"
+
+#include <stddef.h>
+
+void bmp280_multi_init(Bmp280MultiCalib* multi) { multi->totalSensor = 0; }
+
+bool bmp280_multi_add(Bmp280MultiCalib* multi, const Bmp280CalibParam* calibParam, uint16_t* lane) {
+  if (multi->totalSensor >= BMP280_MULTI_MAX_SENSOR) { return false; }
+  uint16_t index       = multi->totalSensor++;
+  multi->dig_t1[index] = calibParam->dig_t1;
+  multi->dig_t2[index] = calibParam->dig_t2;
+  multi->dig_t3[index] = calibParam->dig_t3;
+  multi->dig_p1[index] = calibParam->dig_p1;
+  multi->dig_p2[index] = calibParam->dig_p2;
+  multi->dig_p3[index] = calibParam->dig_p3;
+  multi->dig_p4[index] = calibParam->dig_p4;
+  multi->dig_p5[index] = calibParam->dig_p5;
+  multi->dig_p6[index] = calibParam->dig_p6;
+  multi->dig_p7[index] = calibParam->dig_p7;
+  multi->dig_p8[index] = calibParam->dig_p8;
+  multi->dig_p9[index] = calibParam->dig_p9;
+  multi->t_fine[index] = 0;
+  if (NULL != lane) { *lane = index; }
+  return true;
+}
+
+/**
+ * @brief two passes over the lanes, the pressure pass needs t_fine of every lane and its 64 bit
+ * division would keep the temperature pass from being vectorized if they were one loop
+ *
+ */
+void bmp280_multi_compensate(Bmp280MultiCalib* multi,
+                             const int32_t*    rawTemp,
+                             const int32_t*    rawPress,
+                             float*            temperatureC,
+                             float*            pressPa) {
+  const uint16_t totalSensor = multi->totalSensor;
+
+  for (uint16_t lane = 0; lane < totalSensor; ++lane) {
+    multi->t_fine[lane] = bmp280_calc_t_fine(
+        rawTemp[lane], multi->dig_t1[lane], multi->dig_t2[lane], multi->dig_t3[lane]);
+    temperatureC[lane]  = (float)bmp280_calc_centi_c(multi->t_fine[lane]) * 0.01;
+  }
+
+  for (uint16_t lane = 0; lane < totalSensor; ++lane) {
+    uint32_t pressQ24_8 = bmp280_calc_press_q24_8(rawPress[lane],
+                                                  multi->t_fine[lane],
+                                                  multi->dig_p1[lane],
+                                                  multi->dig_p2[lane],
+                                                  multi->dig_p3[lane],
+                                                  multi->dig_p4[lane],
+                                                  multi->dig_p5[lane],
+                                                  multi->dig_p6[lane],
+                                                  multi->dig_p7[lane],
+                                                  multi->dig_p8[lane],
+                                                  multi->dig_p9[lane]);
+    pressPa[lane]       = (float)pressQ24_8 / 256.0;
+  }
+}
@@ -0,0 +1,145 @@
+/**
+ * @brief packed log of raw bmp280 samples, see BMP280_RawLog.h for the format
+ *
+ * @file BMP280_RawLog.c
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#include "include/BMP280_RawLog.h"
+
+#include <string.h>
+
+#define BMP280_RAW_LOG_ADC_MASK 0xFFFFF
+#define BMP280_RAW_LOG_MAX_VARINT 5
+
+static const uint8_t bmp280RawLogMagic[3] = {'B', 'R', 'L'};
+
+static void bmp280_raw_log_put_u16(uint8_t* out, const uint16_t value) {
+  out[0] = (uint8_t)value;
+  out[1] = (uint8_t)(value >> 8);
+}
+
+static void bmp280_raw_log_put_u32(uint8_t* out, const uint32_t value) {
+  bmp280_raw_log_put_u16(&out[0], (uint16_t)value);
+  bmp280_raw_log_put_u16(&out[2], (uint16_t)(value >> 16));
+}
+
+static uint32_t bmp280_raw_log_get_u32(const uint8_t* in) {
+  return (uint32_t)in[0] | ((uint32_t)in[1] << 8) | ((uint32_t)in[2] << 16) |
+         ((uint32_t)in[3] << 24);
+}
+
+/**
+ * @brief calibration in the register layout, so bmp280_get_calib_param can read it back
+ *
+ */
+static void bmp280_raw_log_put_calib(uint8_t* out, const Bmp280CalibParam* calibParam) {
+  bmp280_raw_log_put_u16(&out[BMP280_DIG_T1_LSB_POS], calibParam->dig_t1);
+  bmp280_raw_log_put_u16(&out[BMP280_DIG_T2_LSB_POS], (uint16_t)calibParam->dig_t2);
+  bmp280_raw_log_put_u16(&out[BMP280_DIG_T3_LSB_POS], (uint16_t)calibParam->dig_t3);
+  bmp280_raw_log_put_u16(&out[BMP280_DIG_P1_LSB_POS], calibParam->dig_p1);
+  bmp280_raw_log_put_u16(&out[BMP280_DIG_P2_LSB_POS], (uint16_t)calibParam->dig_p2);
+  bmp280_raw_log_put_u16(&out[BMP280_DIG_P3_LSB_POS], (uint16_t)calibParam->dig_p3);
+  bmp280_raw_log_put_u16(&out[BMP280_DIG_P4_LSB_POS], (uint16_t)calibParam->dig_p4);
+  bmp280_raw_log_put_u16(&out[BMP280_DIG_P5_LSB_POS], (uint16_t)calibParam->dig_p5);
+  bmp280_raw_log_put_u16(&out[BMP280_DIG_P6_LSB_POS], (uint16_t)calibParam->dig_p6);
+  bmp280_raw_log_put_u16(&out[BMP280_DIG_P7_LSB_POS], (uint16_t)calibParam->dig_p7);
+  bmp280_raw_log_put_u16(&out[BMP280_DIG_P8_LSB_POS], (uint16_t)calibParam->dig_p8);
+  bmp280_raw_log_put_u16(&out[BMP280_DIG_P9_LSB_POS], (uint16_t)calibParam->dig_p9);
+}
+
+void bmp280_raw_log_start(Bmp280RawLogEncoder*    encoder,
+                          const Bmp280CalibParam* calibParam,
+                          const uint32_t          startUs,
+                          const uint32_t          tickUs,
+                          uint8_t                 header[BMP280_RAW_LOG_HEADER_SIZE]) {
+  encoder->tickUs = tickUs;
+  encoder->lastUs = startUs;
+
+  memcpy(header, bmp280RawLogMagic, sizeof(bmp280RawLogMagic));
+  header[3] = BMP280_RAW_LOG_VERSION;
+  bmp280_raw_log_put_u32(&header[4], tickUs);
+  bmp280_raw_log_put_u32(&header[8], startUs);
+  bmp280_raw_log_put_calib(&header[12], calibParam);
+}
+
+/**
+ * @brief the timestamp is rounded to the tick and the rounding is carried to the next record
+ *
+ */
+uint8_t bmp280_raw_log_encode(Bmp280RawLogEncoder*   encoder,
+                              const Bmp280RawSample* sample,
+                              uint8_t                record[BMP280_RAW_LOG_MAX_RECORD]) {
+  uint32_t deltaTick = (sample->timeUs - encoder->lastUs + encoder->tickUs / 2) / encoder->tickUs;
+  encoder->lastUs += deltaTick * encoder->tickUs;
+
+  uint8_t size = 0;
+  while (deltaTick >= 0x80) {
+    record[size++] = (uint8_t)(deltaTick | 0x80);
+    deltaTick >>= 7;
+  }
+  record[size++] = (uint8_t)deltaTick;
+
+  uint32_t rawPress = (uint32_t)sample->rawPress & BMP280_RAW_LOG_ADC_MASK;
+  uint32_t rawTemp  = (uint32_t)sample->rawTemp & BMP280_RAW_LOG_ADC_MASK;
+  record[size++]    = (uint8_t)(rawPress >> 12);
+  record[size++]    = (uint8_t)(rawPress >> 4);
+  record[size++]    = (uint8_t)((rawPress << 4) | (rawTemp >> 16));
+  record[size++]    = (uint8_t)(rawTemp >> 8);
+  record[size++]    = (uint8_t)rawTemp;
+  return size;
+}
+
+bool bmp280_raw_log_open(Bmp280RawLogDecoder* decoder, const uint8_t* log, const uint32_t size) {
+  if (size < BMP280_RAW_LOG_HEADER_SIZE ||
+      0 != memcmp(log, bmp280RawLogMagic, sizeof(bmp280RawLogMagic)) ||
+      BMP280_RAW_LOG_VERSION != log[3]) {
+    return false;
+  }
+  decoder->tickUs = bmp280_raw_log_get_u32(&log[4]);
+  decoder->lastUs = bmp280_raw_log_get_u32(&log[8]);
+
+  uint8_t rawCalibData[BMP280_CALIB_DATA_SIZE];
+  memcpy(rawCalibData, &log[12], sizeof(rawCalibData));
+  bmp280_get_calib_param(rawCalibData, &decoder->calibParam);
+  decoder->calibParam.t_fine = 0;
+  return 0 != decoder->tickUs;
+}
+
+uint32_t bmp280_raw_log_decode(Bmp280RawLogDecoder* decoder,
+                               const uint8_t*       log,
+                               const uint32_t       size,
+                               const uint32_t       offset,
+                               Bmp280RawSample*     sample) {
+  uint32_t cursor    = offset;
+  uint32_t deltaTick = 0;
+  for (uint8_t shift = 0;; shift += 7) {
+    if (cursor >= size || shift >= 7 * BMP280_RAW_LOG_MAX_VARINT) { return 0; }
+    uint8_t group = log[cursor++];
+    deltaTick |= (uint32_t)(group & 0x7F) << shift;
+    if (!(group & 0x80)) { break; }
+  }
+  if (cursor + BMP280_RAW_LOG_ADC_SIZE > size) { return 0; }
+
+  const uint8_t* adc = &log[cursor];
+  decoder->lastUs += deltaTick * decoder->tickUs;
+  sample->timeUs   = decoder->lastUs;
+  sample->rawPress = (int32_t)(((uint32_t)adc[0] << 12) | ((uint32_t)adc[1] << 4) | (adc[2] >> 4));
+  sample->rawTemp =
+      (int32_t)((((uint32_t)adc[2] & 0x0F) << 16) | ((uint32_t)adc[3] << 8) | adc[4]);
+  return cursor + BMP280_RAW_LOG_ADC_SIZE;
+}
+
+/**
+ * @brief same arithmetic as bmp280_get_temp_press, so a log decodes to the values the driver
+ * would have returned
+ *
+ */
+void bmp280_raw_log_compensate(Bmp280RawLogDecoder*   decoder,
+                               const Bmp280RawSample* sample,
+                               float*                 temperatureC,
+                               float*                 pressPa) {
+  *temperatureC = (float)bmp280_compensate_T_int32(sample->rawTemp, &decoder->calibParam) * 0.01;
+  *pressPa      = (float)bmp280_compensate_P_int64(sample->rawPress, &decoder->calibParam) / 256.0;
+}
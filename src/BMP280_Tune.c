@@ -0,0 +1,201 @@
+/**
+ * @brief settings from the needs of the consumer and predictions of any setting, see BMP280_Tune.h
+ *
+ * @file BMP280_Tune.c
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#include "include/BMP280_Tune.h"
+
+#include <math.h>
+#include <stddef.h>
+
+#include "include/BMP280_Utils.h"
+
+#define BMP280_TUNE_NOISE_X1_PA 6.6f
+#define BMP280_TUNE_TEMP_UA 325.0f  // start-up and temperature measurement
+#define BMP280_TUNE_PRESS_UA 720.0f
+#define BMP280_TUNE_STANDBY_UA 0.2f
+#define BMP280_TUNE_STARTUP_US 1000
+
+// indexed by Bmp280Coeff, the oversampling or IIR coefficient and the samples to 75% of a step
+static const uint8_t bmp280TuneFactor[] = {
+    [x0] = 0, [x1] = 1, [x2] = 2, [x4] = 4, [x8] = 8, [x16] = 16};
+static const uint8_t bmp280TuneSettle[] = {[x0] = 1, [x2] = 2, [x4] = 5, [x8] = 11, [x16] = 22};
+
+static const Bmp280Coeff bmp280TuneOsrs[] = {x1, x2, x4, x8, x16};
+static const Bmp280Coeff bmp280TuneIir[]  = {x0, x2, x4, x8, x16};
+
+#define BMP280_TUNE_TOTAL(table) (sizeof(table) / sizeof((table)[0]))
+
+/**
+ * @brief rate, latency, noise and current of the settings of sensor, checked by the caller
+ *
+ */
+static void bmp280_tune_fill(const bmp280* sensor, Bmp280TuneResult* result) {
+  uint32_t measureUs = bmp280_measure_time_us(sensor);
+  uint32_t periodUs  = measureUs + bmp280_standby_time_us(sensor);
+  float    tempUs    = BMP280_TUNE_STARTUP_US + 2000.0f * bmp280TuneFactor[sensor->tempSamp];
+  float    pressUs   = measureUs - tempUs;
+  float    osrsP     = bmp280TuneFactor[sensor->presSamp];  // 0 when pressure is skipped
+  float    coeff     = (x0 == sensor->iirFilter) ? 1 : bmp280TuneFactor[sensor->iirFilter];
+
+  result->tempSamp    = sensor->tempSamp;
+  result->presSamp    = sensor->presSamp;
+  result->iirFilter   = sensor->iirFilter;
+  result->samplSet    = sensor->samplSet;
+  result->mode        = sensor->mode;
+  result->standbyTime = sensor->standbyTime;
+
+  result->odrHz     = 1e6f / periodUs;
+  result->latencyMs = (bmp280TuneSettle[sensor->iirFilter] * periodUs + measureUs) * 1e-3f;
+  result->noisePa   = osrsP ? BMP280_TUNE_NOISE_X1_PA / sqrtf(osrsP * (2 * coeff - 1)) : 0;
+  result->currentUa = (BMP280_TUNE_TEMP_UA * tempUs + BMP280_TUNE_PRESS_UA * pressUs +
+                       BMP280_TUNE_STANDBY_UA * (periodUs - measureUs)) /
+                      periodUs;
+}
+
+// the datasheet pairs x16 on pressure with x2 on temperature and everything else with x1
+static Bmp280Coeff bmp280_tune_temp_samp(const Bmp280Coeff presSamp) {
+  return (x16 == presSamp) ? x2 : x1;
+}
+
+static Bmp280SamplSettings bmp280_tune_sampl_set(const Bmp280Coeff presSamp) {
+  switch (presSamp) {
+    case x1:
+      return UltraLow;
+    case x2:
+      return Low;
+    case x4:
+      return Standard;
+    default:
+      return UltraHigh;
+  }
+}
+
+// less of key first, then less current, then less noise
+static bool bmp280_tune_is_better(const float             key,
+                                  const float             bestKey,
+                                  const Bmp280TuneResult* candidate,
+                                  const Bmp280TuneResult* best) {
+  if (key != bestKey) { return key < bestKey; }
+  if (candidate->currentUa != best->currentUa) { return candidate->currentUa < best->currentUa; }
+  return candidate->noisePa < best->noisePa;
+}
+
+Bmp280TuneStatus bmp280_tune(const Bmp280TuneTarget* target, Bmp280TuneResult* result) {
+  Bmp280TuneResult best;
+  Bmp280TuneResult fastest;
+  Bmp280TuneResult quietest;
+  Bmp280TuneResult quickest;
+  Bmp280TuneResult quietestInTime;
+  bool             hasBest           = false;
+  bool             hasFastest        = false;
+  bool             hasQuietest       = false;
+  bool             hasQuickest       = false;
+  bool             hasQuietestInTime = false;
+
+  for (size_t osrsIndex = 0; osrsIndex < BMP280_TUNE_TOTAL(bmp280TuneOsrs); ++osrsIndex) {
+    Bmp280Coeff presSamp = bmp280TuneOsrs[osrsIndex];
+    for (size_t iirIndex = 0; iirIndex < BMP280_TUNE_TOTAL(bmp280TuneIir); ++iirIndex) {
+      for (Bmp280StandbyTime standby = t0_5ms; standby <= t4000ms; ++standby) {
+        bmp280           candidate;
+        Bmp280TuneResult predicted;
+        if (ERR_NO_ERR != bmp280_create_custom_setting(&candidate,
+                                                       bmp280_tune_temp_samp(presSamp),
+                                                       presSamp,
+                                                       bmp280TuneIir[iirIndex],
+                                                       bmp280_tune_sampl_set(presSamp),
+                                                       Normal,
+                                                       standby)) {
+          continue;
+        }
+        bmp280_tune_fill(&candidate, &predicted);
+
+        bool isRateMet    = predicted.odrHz >= target->odrHz;
+        bool isNoiseMet   = target->maxNoisePa <= 0 || predicted.noisePa <= target->maxNoisePa;
+        bool isLatencyMet =
+            target->maxLatencyMs <= 0 || predicted.latencyMs <= target->maxLatencyMs;
+
+        if (!hasFastest ||
+            bmp280_tune_is_better(-predicted.odrHz, -fastest.odrHz, &predicted, &fastest)) {
+          fastest    = predicted;
+          hasFastest = true;
+        }
+        if (!isRateMet) { continue; }
+        if (!hasQuietest ||
+            bmp280_tune_is_better(predicted.noisePa, quietest.noisePa, &predicted, &quietest)) {
+          quietest    = predicted;
+          hasQuietest = true;
+        }
+        if (!hasQuickest ||
+            bmp280_tune_is_better(predicted.latencyMs, quickest.latencyMs, &predicted, &quickest)) {
+          quickest    = predicted;
+          hasQuickest = true;
+        }
+        if (isLatencyMet &&
+            (!hasQuietestInTime || bmp280_tune_is_better(predicted.noisePa,
+                                                         quietestInTime.noisePa,
+                                                         &predicted,
+                                                         &quietestInTime))) {
+          quietestInTime    = predicted;
+          hasQuietestInTime = true;
+        }
+        if (isNoiseMet && isLatencyMet &&
+            (!hasBest ||
+             bmp280_tune_is_better(predicted.currentUa, best.currentUa, &predicted, &best))) {
+          best    = predicted;
+          hasBest = true;
+        }
+      }
+    }
+  }
+
+  if (hasBest) {
+    *result = best;
+    return TUNE_OK;
+  }
+  if (!hasQuietest) {
+    *result = fastest;
+    return TUNE_ODR_UNREACHABLE;
+  }
+  if (target->maxNoisePa > 0 && quietest.noisePa > target->maxNoisePa) {
+    *result = quietest;
+    return TUNE_NOISE_UNREACHABLE;
+  }
+  if (!hasQuietestInTime) {
+    *result = quickest;
+    return TUNE_LATENCY_UNREACHABLE;
+  }
+  *result = quietestInTime;
+  return TUNE_CONFLICT;
+}
+
+Bmp280ErrCode bmp280_tune_apply(bmp280* sensor, const Bmp280TuneResult* result) {
+  if (NULL == sensor) { return ERR_SENSOR_UNITIALIZED; }
+  return bmp280_create_custom_setting(sensor,
+                                      result->tempSamp,
+                                      result->presSamp,
+                                      result->iirFilter,
+                                      result->samplSet,
+                                      Normal,
+                                      result->standbyTime);
+}
+
+Bmp280ErrCode bmp280_tune_predict(bmp280* sensor, Bmp280TuneResult* result) {
+  BMP280_TRY_FUNC(bmp280_check_setting(sensor));
+  if ((uint32_t)sensor->tempSamp >= BMP280_TUNE_TOTAL(bmp280TuneFactor) ||
+      (uint32_t)sensor->presSamp >= BMP280_TUNE_TOTAL(bmp280TuneFactor) ||
+      (uint32_t)sensor->iirFilter >= BMP280_TUNE_TOTAL(bmp280TuneSettle) ||
+      x1 == sensor->iirFilter) {
+    return ERR_SETTING_UNRECOGNIZED;
+  }
+
+  bmp280 normal = *sensor;
+  // forced mode converts back to back at best, as normal mode without standby
+  if (Normal != sensor->mode) { normal.standbyTime = Uninitialized_standby; }
+  bmp280_tune_fill(&normal, result);
+  result->standbyTime = sensor->standbyTime;
+  return ERR_NO_ERR;
+}
@@ -14,8 +14,6 @@
 #include <stdio.h>
 
 #include "include/BMP280_Drv.h"
-#include "include/TivaC_I2C.h"
-#include "include/TivaC_SPI.h"
 
 /**
  * @brief check user settings to make sure they are among the supported options
@@ -29,7 +27,7 @@ Bmp280ErrCode bmp280_check_setting(bmp280* sensor) {
   else {
     if (sensor->mode == Uninitialized_mode || sensor->tempSamp == Uninitialized_coeff ||
         sensor->presSamp == Uninitialized_coeff || sensor->samplSet == Uninitialized ||
-        sensor->iirFilter == Uninitialized_coeff || sensor->standbyTime == -1) {
+        sensor->iirFilter == Uninitialized_coeff || sensor->standbyTime == Uninitialized_standby) {
       return ERR_SETTING_UNITIALIZED;
 
     } else {
@@ -43,101 +41,101 @@ Bmp280ErrCode bmp280_check_setting(bmp280* sensor) {
  *
  */
 Bmp280ErrCode bmp280_port_check(bmp280* sensor) {
-  if ((I2C == sensor->protocol && (I2C0_NO_ERR != i2c0_check_master_enabled())) ||
-      ((SPI == sensor->protocol) && (SPI_ERR_NO_ERR != spi_check_spi_enabled()))) {
-    return ERR_PORT_NOT_OPEN;
-  }
-
-  return ERR_NO_ERR;
+  bmp280_bus_lock(sensor->bus);
+  bool isOpen = sensor->bus->ops->is_open(sensor->bus->context);
+  bmp280_bus_unlock(sensor->bus);
+  return isOpen ? ERR_NO_ERR : ERR_PORT_NOT_OPEN;
 }
 
+// register codes indexed by the setting enums, BMP280_CODE_INVALID where there is none
+static const uint8_t bmp280OsrsCode[] = {[x0]  = BMP280_OSRS_SKIP,
+                                         [x1]  = BMP280_OSRS_X1,
+                                         [x2]  = BMP280_OSRS_X2,
+                                         [x4]  = BMP280_OSRS_X4,
+                                         [x8]  = BMP280_OSRS_X8,
+                                         [x16] = BMP280_OSRS_X16};
+
+static const uint8_t bmp280FilterCode[] = {[x0]  = BMP280_FILTER_OFF,
+                                           [x1]  = BMP280_CODE_INVALID,
+                                           [x2]  = BMP280_FILTER_X2,
+                                           [x4]  = BMP280_FILTER_X4,
+                                           [x8]  = BMP280_FILTER_X8,
+                                           [x16] = BMP280_FILTER_X16};
+
+static const uint8_t bmp280ModeCode[] = {
+    [Sleep] = BMP280_MODE_SLEEP, [Forced] = BMP280_MODE_FORCED, [Normal] = BMP280_MODE_NORMAL};
+
+static const uint8_t bmp280StandbyCode[] = {[t0_5ms]  = BMP280_STANDBY_0_5MS,
+                                            [t62_5ms] = BMP280_STANDBY_62_5MS,
+                                            [t125ms]  = BMP280_STANDBY_125MS,
+                                            [t250ms]  = BMP280_STANDBY_250MS,
+                                            [t500ms]  = BMP280_STANDBY_500MS,
+                                            [t1000ms] = BMP280_STANDBY_1000MS,
+                                            [t2000ms] = BMP280_STANDBY_2000MS,
+                                            [t4000ms] = BMP280_STANDBY_4000MS};
+
+// number of samples averaged and standby time in us, indexed like the tables above
+static const uint8_t bmp280OsrsFactor[] = {
+    [x0] = 0, [x1] = 1, [x2] = 2, [x4] = 4, [x8] = 8, [x16] = 16};
+
+static const uint32_t bmp280StandbyUs[] = {[t0_5ms]  = 500,
+                                           [t62_5ms] = 62500,
+                                           [t125ms]  = 125000,
+                                           [t250ms]  = 250000,
+                                           [t500ms]  = 500000,
+                                           [t1000ms] = 1000000,
+                                           [t2000ms] = 2000000,
+                                           [t4000ms] = 4000000};
+
+#define BMP280_TABLE_SIZE(table) (sizeof(table) / sizeof((table)[0]))
+
 /**
- * @brief create a byte corresponding to user option to be sent to the control register on the
- * BMP280
+ * @brief look up the register code of a setting, out of range settings give BMP280_CODE_INVALID
  *
  */
-Bmp280ErrCode bmp280_make_ctrl_byte(bmp280* sensor, uint8_t* controlByte) {
-  // start with all 1 and zero out the needed bits
-  uint8_t tempByte = 0xFF;
-  switch (sensor->tempSamp) {
-    case x0:
-      tempByte &= 0x1F;
-      break;
-
-    case x1:
-      tempByte &= 0x3F;
-      break;
-
-    case x2:
-      tempByte &= 0x5F;
-      break;
-
-    case x4:
-      tempByte &= 0x7F;
-      break;
-
-    case x8:
-      tempByte &= 0x9F;
-      break;
-
-    case x16:
-      tempByte &= 0xFF;
-      break;
+static uint8_t bmp280_lookup_code(const uint8_t* table, const uint32_t tableSize, const int value) {
+  // the cast turns the -1 of the Uninitialized values into a large index
+  return ((uint32_t)value < tableSize) ? table[value] : BMP280_CODE_INVALID;
+}
 
-    default:
-      return ERR_SETTING_UNRECOGNIZED;
-      break;
+/**
+ * @brief typical measurement time, 1 + 2 * osrs_t + 2 * osrs_p + 0.5 ms with the 0.5 ms only when
+ * pressure is measured
+ *
+ */
+uint32_t bmp280_measure_time_us(const bmp280* sensor) {
+  uint32_t tempFactor  = 0;
+  uint32_t pressFactor = 0;
+  if ((uint32_t)sensor->tempSamp < BMP280_TABLE_SIZE(bmp280OsrsFactor)) {
+    tempFactor = bmp280OsrsFactor[sensor->tempSamp];
   }
-
-  switch (sensor->presSamp) {
-    case x0:
-      tempByte &= 0xE3;
-      break;
-
-    case x1:
-      tempByte &= 0xE7;
-      break;
-
-    case x2:
-      tempByte &= 0xEB;
-      break;
-
-    case x4:
-      tempByte &= 0xEF;
-      break;
-
-    case x8:
-      tempByte &= 0xF3;
-      break;
-
-    case x16:
-      tempByte &= 0xFF;
-      break;
-
-    default:
-      return ERR_SETTING_UNRECOGNIZED;
-      break;
+  if ((uint32_t)sensor->presSamp < BMP280_TABLE_SIZE(bmp280OsrsFactor)) {
+    pressFactor = bmp280OsrsFactor[sensor->presSamp];
   }
+  return 1000 + 2000 * tempFactor + 2000 * pressFactor + (pressFactor ? 500 : 0);
+}
 
-  switch (sensor->mode) {
-    case Sleep:
-      tempByte &= 0xFC;
-      break;
-
-    case Forced:
-      tempByte &= 0xFD;
-      break;
-
-    case Normal:
-      tempByte &= 0xFF;
-      break;
-
-    default:
-      return ERR_SETTING_UNRECOGNIZED;
-      break;
-  }
+uint32_t bmp280_standby_time_us(const bmp280* sensor) {
+  if ((uint32_t)sensor->standbyTime >= BMP280_TABLE_SIZE(bmp280StandbyUs)) { return 0; }
+  return bmp280StandbyUs[sensor->standbyTime];
+}
 
-  *controlByte = tempByte;
+/**
+ * @brief create a byte corresponding to user option to be sent to the control register on the
+ * BMP280
+ *
+ */
+Bmp280ErrCode bmp280_make_ctrl_byte(bmp280* sensor, uint8_t* controlByte) {
+  uint8_t osrsT =
+      bmp280_lookup_code(bmp280OsrsCode, BMP280_TABLE_SIZE(bmp280OsrsCode), sensor->tempSamp);
+  uint8_t osrsP =
+      bmp280_lookup_code(bmp280OsrsCode, BMP280_TABLE_SIZE(bmp280OsrsCode), sensor->presSamp);
+  uint8_t mode =
+      bmp280_lookup_code(bmp280ModeCode, BMP280_TABLE_SIZE(bmp280ModeCode), sensor->mode);
+
+  // valid codes fit in 3 bits so the OR is only BMP280_CODE_INVALID if one of them is
+  if ((osrsT | osrsP | mode) == BMP280_CODE_INVALID) { return ERR_SETTING_UNRECOGNIZED; }
+  *controlByte = BMP280_CTRL_MEAS_BYTE(osrsT, osrsP, mode);
   return ERR_NO_ERR;
 }
 
@@ -146,87 +144,26 @@ Bmp280ErrCode bmp280_make_ctrl_byte(bmp280* sensor, uint8_t* controlByte) {
  * BMP280
  *
  */
-uint8_t bmp280_make_cfg_byte(bmp280* sensor, uint8_t* returnByte) {
-  // start with all 1 and zero out the needed bits
-  uint8_t tempByte = 0xFF;
-
-  // handle standby time
-  if (sensor->standbyTime == 0.5) {
-    tempByte &= 0x1F;
-  } else if (sensor->standbyTime == 62.5) {
-    tempByte &= 0x3F;
-  } else if (sensor->standbyTime == 125) {
-    tempByte &= 0x5F;
-  } else if (sensor->standbyTime == 250) {
-    tempByte &= 0x7F;
-  } else if (sensor->standbyTime == 500) {
-    tempByte &= 0x9F;
-  } else if (sensor->standbyTime == 1000) {
-    tempByte &= 0xBF;
-  } else if (sensor->standbyTime == 2000) {
-    tempByte &= 0xDF;
-  } else if (sensor->standbyTime == 4000) {
-    tempByte &= 0xFF;
-  } else {
-    return ERR_SETTING_UNRECOGNIZED;
-  }
-
-  // handle iir filter sampling
-  switch (sensor->iirFilter) {
-    case x0:
-      tempByte &= 0xE3;
-      break;
-
-    case x2:
-      tempByte &= 0xEB;
-      break;
-
-    case x4:
-      tempByte &= 0xEF;
-      break;
-
-    case x8:
-      tempByte &= 0xF3;
-      break;
-
-    case x16:
-      tempByte &= 0xFF;
-      break;
-
-    default:
-      return ERR_SETTING_UNRECOGNIZED;
-      return 1;
-      break;
-  }
-
-  // set protocol to be I2C or SPI
-  if (sensor->protocol == I2C) { tempByte &= 0xFE; }
-
+Bmp280ErrCode bmp280_make_cfg_byte(bmp280* sensor, uint8_t* returnByte) {
+  uint8_t standby = bmp280_lookup_code(
+      bmp280StandbyCode, BMP280_TABLE_SIZE(bmp280StandbyCode), sensor->standbyTime);
+  uint8_t filter =
+      bmp280_lookup_code(bmp280FilterCode, BMP280_TABLE_SIZE(bmp280FilterCode), sensor->iirFilter);
+
+  if ((standby | filter) == BMP280_CODE_INVALID) { return ERR_SETTING_UNRECOGNIZED; }
+  *returnByte = BMP280_CONFIG_BYTE(standby, filter);
   return ERR_NO_ERR;
-  *returnByte = tempByte;
 }
 
 /**
- * @brief open spi or i2c communications
+ * @brief open spi or i2c communications, ERR_BUS_FAIL when the bus refuses to open
  *
  */
 Bmp280ErrCode bmp280_open_i2c_spi(bmp280* sensor) {
-  if (I2C == sensor->protocol) {
-    i2c0_open();
-  } else if (SPI == sensor->protocol) {
-    const SpiSettings spiSetting = {.spiBitRateMbits = 0.3,
-                                    .cpuClockMHz     = 16,
-                                    .cpol            = 1,
-                                    .cpha            = 1,
-                                    .operMode        = Freescale,
-                                    .isLoopBack      = false,
-                                    .transferSizeBit = 8,
-                                    .role            = Master,
-                                    .clockSource     = Systemclock};
-
-    spi_open(spiSetting);
-  }
-  return ERR_NO_ERR;
+  bmp280_bus_lock(sensor->bus);
+  bool isOpen = sensor->bus->ops->open(sensor->bus->context);
+  bmp280_bus_unlock(sensor->bus);
+  return isOpen ? ERR_NO_ERR : ERR_BUS_FAIL;
 }
 
 /**
@@ -234,11 +171,9 @@ Bmp280ErrCode bmp280_open_i2c_spi(bmp280* sensor) {
  *
  */
 Bmp280ErrCode bmp280_close_i2c_spi(bmp280* sensor) {
-  if (I2C == sensor->protocol) {
-    i2c0_close();
-  } else if (SPI == sensor->protocol) {
-    spi_close();
-  }
+  bmp280_bus_lock(sensor->bus);
+  sensor->bus->ops->close(sensor->bus->context);
+  bmp280_bus_unlock(sensor->bus);
   return ERR_NO_ERR;
 }
 
@@ -251,79 +186,105 @@ Bmp280ErrCode bmp280_port_prep(bmp280* sensor) {
   return ERR_NO_ERR;
 }
 
+/**
+ * @brief one attempt at reading one or multiple registers
+ *
+ */
+static Bmp280ErrCode bmp280_get_register_once(bmp280*       sensor,
+                                              const uint8_t startAddr,
+                                              uint8_t*      regData,
+                                              const uint8_t totalRegister) {
+  bool isDone = sensor->bus->ops->read(
+      sensor->bus->context, sensor->address, startAddr, regData, totalRegister);
+  return isDone ? ERR_NO_ERR : ERR_BUS_FAIL;
+}
+
+/**
+ * @brief one attempt at writing one register
+ *
+ */
+static Bmp280ErrCode bmp280_write_register_once(bmp280*       sensor,
+                                                const uint8_t regAddr,
+                                                const uint8_t regData) {
+  bool isDone = sensor->bus->ops->write(sensor->bus->context, sensor->address, regAddr, regData);
+  return isDone ? ERR_NO_ERR : ERR_BUS_FAIL;
+}
+
+/**
+ * @brief get the bus ready for another attempt after a failed transfer
+ *
+ * On I2C a glitch can leave the bmp280 holding SDA low, so the bus is recovered before the retry.
+ * SPI has no bus state to recover, the transfer is only repeated
+ */
+static void bmp280_prepare_retry(bmp280* sensor) {
+  BUS_STATS_ADD(sensor->stats, retry, 1);
+  if (NULL != sensor->bus->ops->recover) { sensor->bus->ops->recover(sensor->bus->context); }
+}
+
+/**
+ * @brief record one register transfer in the trace of the sensor, if it has one
+ *
+ */
+static void bmp280_trace(bmp280*             sensor,
+                         const bool          isWrite,
+                         const Bmp280ErrCode errCode,
+                         const uint8_t       totalRetry,
+                         const uint8_t       regAddr,
+                         const uint8_t*      regData,
+                         const uint8_t       totalRegister) {
+  if (NULL == sensor->trace) { return; }
+  uint8_t flags = (totalRetry > BUS_TRACE_RETRY_M) ? BUS_TRACE_RETRY_M : totalRetry;
+  if (isWrite) { flags |= BUS_TRACE_WRITE; }
+  if (ERR_NO_ERR != errCode) { flags |= BUS_TRACE_ERROR; }
+  bus_trace_add(sensor->trace, flags, regAddr, regData, totalRegister);
+}
+
 /**
  * @brief protocol agnostic function to get data from one or multiple register
  *
+ * A failed transfer is tried again up to BMP280_BUS_MAX_RETRY times, ERR_BUS_FAIL is returned if
+ * none of them succeeds and regData must not be used then
  */
 Bmp280ErrCode bmp280_get_register(bmp280*       sensor,
                                   const uint8_t startAddr,
                                   uint8_t*      regData,
                                   const uint8_t totalRegister) {
-  if (I2C == sensor->protocol) {
-    I2C0_TRY_FUNC(i2c0_wait_bus());
-    if (totalRegister > 1) {
-      // write data with no stop signal
-      i2c0_single_data_write(sensor->address, startAddr, true);
-      i2c0_multiple_data_byte_read(sensor->address, regData, totalRegister);
-    } else if (totalRegister == 1) {
-      // write data with no stop signal
-      i2c0_single_data_write(sensor->address, startAddr, true);
-      I2C0_TRY_FUNC(i2c0_wait_bus());
-
-      // read 3 bytes bc reading single byte seems to create weird behaviours with this sensor
-      uint8_t inputBuffer[3];
-      i2c0_multiple_data_byte_read(sensor->address, inputBuffer, 3);
-      *regData = inputBuffer[0];
-    }
-  } else if (SPI == sensor->protocol) {
-    const SpiSettings spiSetting = {.spiBitRateMbits = 0.3,
-                                    .cpuClockMHz     = 16,
-                                    .cpol            = 1,
-                                    .cpha            = 1,
-                                    .operMode        = Freescale,
-                                    .isLoopBack      = false,
-                                    .transferSizeBit = 8,
-                                    .role            = Master,
-                                    .clockSource     = Systemclock};
-    uint8_t           addressList[1];
-    addressList[0] = startAddr;
-    spi_transfer(spiSetting, addressList, 1, regData, totalRegister);
+  bmp280_bus_lock(sensor->bus);
+  uint8_t       retryIndex = 0;
+  Bmp280ErrCode errCode    = bmp280_get_register_once(sensor, startAddr, regData, totalRegister);
+  for (; ERR_NO_ERR != errCode && retryIndex < BMP280_BUS_MAX_RETRY; ++retryIndex) {
+    bmp280_prepare_retry(sensor);
+    errCode = bmp280_get_register_once(sensor, startAddr, regData, totalRegister);
   }
-
-  return ERR_NO_ERR;
+  bmp280_bus_unlock(sensor->bus);
+  bmp280_trace(sensor, false, errCode, retryIndex, startAddr, regData, totalRegister);
+  return errCode;
 }
 
 /**
  * @brief protocol agnostic function to write data to one or multiple register
  *
+ * Every register is retried like in bmp280_get_register, the registers after a failing one are
+ * not written
  */
 Bmp280ErrCode bmp280_write_register(bmp280*        sensor,
                                     const uint8_t* registerList,
                                     const uint8_t  totalRegister,
                                     const uint8_t* registerDataList) {
-  if (I2C == sensor->protocol) {
-    uint8_t regDataPair[2];
-    for (int regIndex = 0; regIndex < totalRegister; ++regIndex) {
-      regDataPair[0] = registerList[regIndex];
-      regDataPair[1] = registerDataList[regIndex];
-      i2c0_multiple_data_byte_write(sensor->address, regDataPair, 2);
-    }
-  } else if (SPI == sensor->protocol) {
-    const SpiSettings spiSetting = {.spiBitRateMbits = 0.3,
-                                    .cpuClockMHz     = 16,
-                                    .cpol            = 1,
-                                    .cpha            = 1,
-                                    .operMode        = Freescale,
-                                    .isLoopBack      = false,
-                                    .transferSizeBit = 8,
-                                    .role            = Master,
-                                    .clockSource     = Systemclock};
-    uint8_t           regDataPair[2];
-    for (int regIndex = 0; regIndex < totalRegister; ++regIndex) {
-      regDataPair[0] = registerList[regIndex];
-      regDataPair[1] = registerDataList[regIndex];
-      spi_transfer(spiSetting, regDataPair, 2, NULL, 0);
+  for (int regIndex = 0; regIndex < totalRegister; ++regIndex) {
+    bmp280_bus_lock(sensor->bus);
+    uint8_t       retryIndex = 0;
+    Bmp280ErrCode errCode =
+        bmp280_write_register_once(sensor, registerList[regIndex], registerDataList[regIndex]);
+    for (; ERR_NO_ERR != errCode && retryIndex < BMP280_BUS_MAX_RETRY; ++retryIndex) {
+      bmp280_prepare_retry(sensor);
+      errCode =
+          bmp280_write_register_once(sensor, registerList[regIndex], registerDataList[regIndex]);
     }
+    bmp280_bus_unlock(sensor->bus);
+    bmp280_trace(
+        sensor, true, errCode, retryIndex, registerList[regIndex], &registerDataList[regIndex], 1);
+    if (ERR_NO_ERR != errCode) { return errCode; }
   }
   return ERR_NO_ERR;
 }
@@ -0,0 +1,77 @@
+/**
+ * @brief alpha-beta filter of the altitude stream, see BMP280_VSpeed.h
+ *
+ * @file BMP280_VSpeed.c
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#include "include/BMP280_VSpeed.h"
+
+#include <math.h>
+
+#define BMP280_VSPEED_ONE_Q16 65536
+#define BMP280_VSPEED_US_TO_S_Q32 4295  // 2^32 / 10^6, a multiply instead of dividing by 10^6
+
+bool bmp280_vspeed_init_gains(Bmp280VSpeed*  vspeed,
+                              const uint32_t periodUs,
+                              const uint32_t alphaQ16,
+                              const uint32_t betaQ16) {
+  if (0 == periodUs || 0 == alphaQ16 || alphaQ16 > BMP280_VSPEED_ONE_Q16) { return false; }
+  uint64_t maxGapUs        = (uint64_t)periodUs * BMP280_VSPEED_MAX_GAP_PERIOD;
+  vspeed->alphaQ16         = alphaQ16;
+  vspeed->betaPerSecondQ16 = (uint32_t)(((uint64_t)betaQ16 * 1000000) / periodUs);
+  vspeed->maxGapUs         = (maxGapUs > UINT32_MAX) ? UINT32_MAX : (uint32_t)maxGapUs;
+  vspeed->positionQ8       = 0;
+  vspeed->speedQ8          = 0;
+  vspeed->hasSample        = false;
+  return true;
+}
+
+/**
+ * @brief the only floating point of the module, run once
+ *
+ */
+bool bmp280_vspeed_init(Bmp280VSpeed*  vspeed,
+                        const uint32_t periodUs,
+                        const uint32_t accelNoiseMmS2,
+                        const uint32_t altitudeNoiseMm) {
+  if (0 == periodUs || 0 == accelNoiseMmS2 || 0 == altitudeNoiseMm) { return false; }
+  double periodS = periodUs * 1e-6;
+  double lambda  = accelNoiseMmS2 * periodS * periodS / altitudeNoiseMm;
+  double r       = (4 + lambda - sqrt(8 * lambda + lambda * lambda)) / 4;
+  double alpha   = 1 - r * r;
+  double beta    = 2 * (2 - alpha) - 4 * sqrt(1 - alpha);
+  return bmp280_vspeed_init_gains(vspeed,
+                                  periodUs,
+                                  (uint32_t)(alpha * BMP280_VSPEED_ONE_Q16 + 0.5),
+                                  (uint32_t)(beta * BMP280_VSPEED_ONE_Q16 + 0.5));
+}
+
+void bmp280_vspeed_update(Bmp280VSpeed*  vspeed,
+                          const int32_t  altitudeMm,
+                          const uint32_t elapsedUs) {
+  int64_t measured = (int64_t)altitudeMm * 256;
+  // the first sample, or one after a gap the prediction can't be trusted over nor computed for
+  if (!vspeed->hasSample || elapsedUs > vspeed->maxGapUs) {
+    vspeed->positionQ8 = measured;
+    vspeed->speedQ8    = 0;
+    vspeed->hasSample  = true;
+    return;
+  }
+
+  int64_t travel    = ((int64_t)vspeed->speedQ8 * elapsedUs * BMP280_VSPEED_US_TO_S_Q32) >> 32;
+  int64_t predicted = vspeed->positionQ8 + travel;
+  int64_t residual  = measured - predicted;
+
+  vspeed->positionQ8 = predicted + ((residual * vspeed->alphaQ16) >> 16);
+  vspeed->speedQ8    = (int32_t)(vspeed->speedQ8 + ((residual * vspeed->betaPerSecondQ16) >> 16));
+}
+
+int32_t bmp280_vspeed_altitude_mm(const Bmp280VSpeed* vspeed) {
+  return (int32_t)((vspeed->positionQ8 + 128) >> 8);
+}
+
+int32_t bmp280_vspeed_speed_mm_s(const Bmp280VSpeed* vspeed) {
+  return (vspeed->speedQ8 + 128) >> 8;
+}
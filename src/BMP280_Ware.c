@@ -61,16 +61,9 @@
  * @return Returns rawCalibDataerature in DegC, resolution is 0.01 DegC. Output value of “5123”
  * equals 51.23 DegC. calData->t_fine carries fine rawCalibDataerature as global value
  */
-float bmp280_compensate_T_int32(int32_t adc_T, Bmp280CalibParam* calData) {
-  int32_t var1, var2;
-  var1 = ((((adc_T >> 3) - ((int32_t)calData->dig_t1 << 1))) * ((int32_t)calData->dig_t2)) >> 11;
-  var2 = (((((adc_T >> 4) - ((int32_t)calData->dig_t1)) *
-            ((adc_T >> 4) - ((int32_t)calData->dig_t1))) >>
-           12) *
-          ((int32_t)calData->dig_t3)) >>
-         14;
-  calData->t_fine = var1 + var2;
-  return (float)((calData->t_fine * 5 + 128) >> 8);
+int32_t bmp280_compensate_T_int32(int32_t adc_T, Bmp280CalibParam* calData) {
+  calData->t_fine = bmp280_calc_t_fine(adc_T, calData->dig_t1, calData->dig_t2, calData->dig_t3);
+  return bmp280_calc_centi_c(calData->t_fine);
 }
 
 /**
@@ -81,24 +74,18 @@ float bmp280_compensate_T_int32(int32_t adc_T, Bmp280CalibParam* calData) {
  * @return Returns pressure in Pa as unsigned 32 bit integer in Q24.8 format (24 integer bits and
  * 8 fractional bits). Output value of “24674867” represents 24674867/256 = 96386.2 Pa = 963.862 hPa
  */
-float bmp280_compensate_P_int64(int32_t adc_P, Bmp280CalibParam* calData) {
-  int64_t var1, var2, p;
-  var1 = ((int64_t)calData->t_fine) - 128000;
-  var2 = var1 * var1 * (int64_t)calData->dig_p6;
-  var2 = var2 + ((var1 * (int64_t)calData->dig_p5) << 17);
-  var2 = var2 + (((int64_t)calData->dig_p4) << 35);
-  var1 =
-      ((var1 * var1 * (int64_t)calData->dig_p3) >> 8) + ((var1 * (int64_t)calData->dig_p2) << 12);
-  var1 = (((((int64_t)1) << 47) + var1)) * ((int64_t)calData->dig_p1) >> 33;
-  if (var1 == 0) {
-    return 0;  // avoid exception caused by division by zero
-  }
-  p    = 1048576 - adc_P;
-  p    = (((p << 31) - var2) * 3125) / var1;
-  var1 = (((int64_t)calData->dig_p9) * (p >> 13) * (p >> 13)) >> 25;
-  var2 = (((int64_t)calData->dig_p8) * p) >> 19;
-  p    = ((p + var1 + var2) >> 8) + (((int64_t)calData->dig_p7) << 4);
-  return (float)p;
+uint32_t bmp280_compensate_P_int64(int32_t adc_P, Bmp280CalibParam* calData) {
+  return bmp280_calc_press_q24_8(adc_P,
+                                 calData->t_fine,
+                                 calData->dig_p1,
+                                 calData->dig_p2,
+                                 calData->dig_p3,
+                                 calData->dig_p4,
+                                 calData->dig_p5,
+                                 calData->dig_p6,
+                                 calData->dig_p7,
+                                 calData->dig_p8,
+                                 calData->dig_p9);
 }
 
 /**
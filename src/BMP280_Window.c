@@ -0,0 +1,113 @@
+/**
+ * @brief windowed statistics of temperature and pressure, see BMP280_Window.h
+ *
+ * @file BMP280_Window.c
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#include "include/BMP280_Window.h"
+
+#include <stddef.h>
+#include <string.h>
+
+static void bmp280_window_sum_add(Bmp280WindowSum* sum, const int32_t value) {
+  if (0 == sum->count) {
+    sum->offset = value;
+    sum->min    = value;
+    sum->max    = value;
+  }
+  int64_t deviation = (int64_t)value - sum->offset;
+  sum->sum += deviation;
+  sum->sumSquare += (uint64_t)(deviation * deviation);
+  if (value < sum->min) { sum->min = value; }
+  if (value > sum->max) { sum->max = value; }
+  ++sum->count;
+}
+
+// rounded to the nearest, half away from 0
+static int64_t bmp280_window_divide(const int64_t dividend, const uint32_t divisor) {
+  int64_t half = divisor / 2;
+  return (dividend >= 0) ? (dividend + half) / divisor : -((-dividend + half) / divisor);
+}
+
+// rounded down, one bit of the result per iteration
+static uint32_t bmp280_window_sqrt(uint64_t value) {
+  uint64_t root = 0;
+  uint64_t bit  = 1ULL << 62;
+  while (bit > value) { bit >>= 2; }
+  while (0 != bit) {
+    if (value >= root + bit) {
+      value -= root + bit;
+      root = (root >> 1) + bit;
+    } else {
+      root >>= 1;
+    }
+    bit >>= 2;
+  }
+  return (uint32_t)root;
+}
+
+/**
+ * @brief the spread around the rounded mean m is sumSquare - m * (2 * sum - count * m), it exceeds
+ * the one around the exact mean by less than count / 4 units squared
+ *
+ */
+static void bmp280_window_stat(const Bmp280WindowSum* sum, Bmp280WindowStat* stat) {
+  if (NULL == stat) { return; }
+  memset(stat, 0, sizeof(*stat));
+  if (0 == sum->count) { return; }
+
+  int64_t meanDeviation = bmp280_window_divide(sum->sum, sum->count);
+  int64_t spread =
+      (int64_t)sum->sumSquare - meanDeviation * (2 * sum->sum - meanDeviation * sum->count);
+
+  stat->min    = sum->min;
+  stat->max    = sum->max;
+  stat->mean   = (int32_t)(sum->offset + meanDeviation);
+  stat->stdDev = (spread > 0) ? bmp280_window_sqrt((uint64_t)spread / sum->count) : 0;
+  stat->count  = sum->count;
+}
+
+bool bmp280_window_init(Bmp280Window* window, const uint32_t lengthUs) {
+  if (0 == lengthUs || lengthUs > (1UL << 31)) { return false; }
+  memset(window, 0, sizeof(*window));
+  window->lengthUs = lengthUs;
+  return true;
+}
+
+bool bmp280_window_add(Bmp280Window*  window,
+                       const uint32_t timeUs,
+                       const int32_t  temperatureCentiC,
+                       const uint32_t pressQ24_8) {
+  bool isClosed = false;
+  if (0 == window->temp.count) {
+    window->startUs = timeUs;
+  } else if (timeUs - window->startUs >= window->lengthUs) {
+    bmp280_window_stat(&window->temp, &window->lastTemp);
+    bmp280_window_stat(&window->press, &window->lastPress);
+    memset(&window->temp, 0, sizeof(window->temp));
+    memset(&window->press, 0, sizeof(window->press));
+    // skip the windows a gap left empty
+    window->startUs += (timeUs - window->startUs) / window->lengthUs * window->lengthUs;
+    isClosed = true;
+  }
+
+  bmp280_window_sum_add(&window->temp, temperatureCentiC);
+  bmp280_window_sum_add(&window->press, (int32_t)pressQ24_8);
+  return isClosed;
+}
+
+void bmp280_window_get_last(const Bmp280Window* window,
+                            Bmp280WindowStat*   temperature,
+                            Bmp280WindowStat*   pressure) {
+  if (NULL != temperature) { *temperature = window->lastTemp; }
+  if (NULL != pressure) { *pressure = window->lastPress; }
+}
+
+void bmp280_window_get_open(const Bmp280Window* window,
+                            Bmp280WindowStat*   temperature,
+                            Bmp280WindowStat*   pressure) {
+  bmp280_window_stat(&window->temp, temperature);
+  bmp280_window_stat(&window->press, pressure);
+}
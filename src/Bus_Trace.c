@@ -0,0 +1,212 @@
+/**
+ * @brief ring of register transactions, see Bus_Trace.h for the record format
+ *
+ * @file Bus_Trace.c
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#include "include/Bus_Trace.h"
+
+#include <stddef.h>
+#include <string.h>
+
+#define BUS_TRACE_RECORD_HEAD 3  // flags, register and length
+#define BUS_TRACE_MAX_VARINT 5   // a u32 takes at most 5 groups of 7 bits
+#define BUS_TRACE_MAX_RECORD (BUS_TRACE_RECORD_HEAD + BUS_TRACE_MAX_VARINT + BUS_TRACE_MAX_DATA)
+
+static const uint8_t busTraceMagic[3] = {'B', 'T', 'R'};
+
+/**
+ * @brief write a record to out, out must hold BUS_TRACE_MAX_RECORD bytes
+ * @return bytes written
+ */
+static uint32_t bus_trace_encode(uint8_t*       out,
+                                 const uint8_t  flags,
+                                 const uint8_t  reg,
+                                 uint32_t       deltaUs,
+                                 const uint8_t* data,
+                                 const uint8_t  length) {
+  uint32_t offset = 0;
+  out[offset++]   = flags;
+  out[offset++]   = reg;
+  out[offset++]   = length;
+  while (deltaUs >= 0x80) {
+    out[offset++] = (uint8_t)(deltaUs | 0x80);
+    deltaUs >>= 7;
+  }
+  out[offset++] = (uint8_t)deltaUs;
+  if (length > 0) { memcpy(&out[offset], data, length); }
+  return offset + length;
+}
+
+static void bus_trace_put_u32(uint8_t* out, const uint32_t value) {
+  for (uint8_t byteIndex = 0; byteIndex < 4; ++byteIndex) {
+    out[byteIndex] = (uint8_t)(value >> (8 * byteIndex));
+  }
+}
+
+static uint32_t bus_trace_get_u32(const uint8_t* in) {
+  return (uint32_t)in[0] | ((uint32_t)in[1] << 8) | ((uint32_t)in[2] << 16) |
+         ((uint32_t)in[3] << 24);
+}
+
+/**
+ * @brief copy the record starting offset bytes after the tail out of the ring, so it can be
+ * decoded like a dump
+ * @return bytes copied, the whole record or what is left of the ring
+ */
+static uint32_t bus_trace_ring_copy(const BusTrace* trace, const uint32_t offset, uint8_t* out) {
+  uint32_t totalByte = trace->used - offset;
+  if (totalByte > BUS_TRACE_MAX_RECORD) { totalByte = BUS_TRACE_MAX_RECORD; }
+  for (uint32_t byteIndex = 0; byteIndex < totalByte; ++byteIndex) {
+    out[byteIndex] = trace->buffer[(trace->tail + offset + byteIndex) % trace->size];
+  }
+  return totalByte;
+}
+
+/**
+ * @brief drop the oldest record, the time of the next one becomes the time of the ring
+ *
+ */
+static void bus_trace_drop_oldest(BusTrace* trace) {
+  uint8_t        recordBuffer[BUS_TRACE_MAX_RECORD];
+  BusTraceRecord record = {0};
+  uint32_t       recordSize =
+      bus_trace_parse_record(recordBuffer, bus_trace_ring_copy(trace, 0, recordBuffer), 0, &record);
+
+  trace->tail = (trace->tail + recordSize) % trace->size;
+  trace->used -= recordSize;
+  --trace->total;
+  ++trace->dropped;
+  if (0 == trace->total) { return; }
+
+  record.timeUs = trace->firstUs;
+  bus_trace_parse_record(recordBuffer, bus_trace_ring_copy(trace, 0, recordBuffer), 0, &record);
+  trace->firstUs = record.timeUs;
+}
+
+void bus_trace_init(BusTrace*         trace,
+                    uint8_t*          buffer,
+                    const uint32_t    size,
+                    const TimeSource* timeSource) {
+  trace->buffer     = buffer;
+  trace->size       = size;
+  trace->timeSource = timeSource;
+  bus_trace_clear(trace);
+}
+
+void bus_trace_clear(BusTrace* trace) {
+  trace->head    = 0;
+  trace->tail    = 0;
+  trace->used    = 0;
+  trace->firstUs = 0;
+  trace->lastUs  = 0;
+  trace->total   = 0;
+  trace->dropped = 0;
+}
+
+void bus_trace_add(BusTrace*      trace,
+                   const uint8_t  flags,
+                   const uint8_t  reg,
+                   const uint8_t* data,
+                   const uint8_t  length) {
+  uint32_t nowUs = (NULL != trace->timeSource) ? time_source_now_us(trace->timeSource) : 0;
+  uint8_t  recordBuffer[BUS_TRACE_MAX_RECORD];
+  uint8_t  recordLength = (length > BUS_TRACE_MAX_DATA) ? BUS_TRACE_MAX_DATA : length;
+  if (flags & BUS_TRACE_ERROR) { recordLength = 0; }
+
+  uint32_t deltaUs    = (0 == trace->total) ? 0 : nowUs - trace->lastUs;
+  uint32_t recordSize = bus_trace_encode(recordBuffer, flags, reg, deltaUs, data, recordLength);
+  if (recordSize > trace->size) {
+    ++trace->dropped;
+    return;
+  }
+
+  while (trace->used + recordSize > trace->size) { bus_trace_drop_oldest(trace); }
+  if (0 == trace->total) {
+    // the ring may have emptied above, the record restarts the time base with a delta of 0
+    trace->firstUs = nowUs;
+    recordSize     = bus_trace_encode(recordBuffer, flags, reg, 0, data, recordLength);
+  }
+
+  for (uint32_t byteIndex = 0; byteIndex < recordSize; ++byteIndex) {
+    trace->buffer[trace->head] = recordBuffer[byteIndex];
+    trace->head                = (trace->head + 1) % trace->size;
+  }
+  trace->used += recordSize;
+  trace->lastUs = nowUs;
+  ++trace->total;
+}
+
+bool bus_trace_dump(const BusTrace* trace, const BusTraceSink* sink) {
+  uint8_t header[BUS_TRACE_HEADER_SIZE];
+  memcpy(header, busTraceMagic, sizeof(busTraceMagic));
+  header[3] = BUS_TRACE_VERSION;
+  bus_trace_put_u32(&header[4], trace->firstUs);
+  bus_trace_put_u32(&header[8], trace->total);
+  bus_trace_put_u32(&header[12], trace->dropped);
+  if (!sink->write(sink->context, header, sizeof(header))) { return false; }
+
+  // the ring bytes are already in dump format apart from the wrap and the delta of the oldest
+  // record, which is relative to a record that was dropped and is written as 0
+  uint8_t recordBuffer[BUS_TRACE_MAX_RECORD];
+  uint8_t firstBuffer[BUS_TRACE_MAX_RECORD];
+  for (uint32_t offset = 0; offset < trace->used;) {
+    BusTraceRecord record = {0};
+    uint32_t       recordSize =
+        bus_trace_parse_record(recordBuffer,
+                               bus_trace_ring_copy(trace, offset, recordBuffer),
+                               0,
+                               &record);
+    if (0 == recordSize) { return false; }
+
+    const uint8_t* out     = recordBuffer;
+    uint32_t       outSize = recordSize;
+    if (0 == offset) {
+      out     = firstBuffer;
+      outSize = bus_trace_encode(
+          firstBuffer, record.flags, record.reg, 0, record.data, record.length);
+    }
+    if (!sink->write(sink->context, out, (uint16_t)outSize)) { return false; }
+    offset += recordSize;
+  }
+  return true;
+}
+
+bool bus_trace_parse_header(const uint8_t* dump, const uint32_t size, BusTraceHeader* header) {
+  if (size < BUS_TRACE_HEADER_SIZE || 0 != memcmp(dump, busTraceMagic, sizeof(busTraceMagic)) ||
+      BUS_TRACE_VERSION != dump[3]) {
+    return false;
+  }
+  header->version = dump[3];
+  header->firstUs = bus_trace_get_u32(&dump[4]);
+  header->total   = bus_trace_get_u32(&dump[8]);
+  header->dropped = bus_trace_get_u32(&dump[12]);
+  return true;
+}
+
+uint32_t bus_trace_parse_record(const uint8_t*  dump,
+                                const uint32_t  size,
+                                const uint32_t  offset,
+                                BusTraceRecord* record) {
+  uint32_t cursor = offset;
+  if (cursor + BUS_TRACE_RECORD_HEAD > size) { return 0; }
+  record->flags  = dump[cursor++];
+  record->reg    = dump[cursor++];
+  record->length = dump[cursor++];
+  if (record->length > BUS_TRACE_MAX_DATA) { return 0; }
+
+  uint32_t deltaUs = 0;
+  for (uint8_t shift = 0;; shift += 7) {
+    if (cursor >= size || shift >= 7 * BUS_TRACE_MAX_VARINT) { return 0; }
+    uint8_t group = dump[cursor++];
+    deltaUs |= (uint32_t)(group & 0x7F) << shift;
+    if (!(group & 0x80)) { break; }
+  }
+  record->timeUs += deltaUs;
+
+  if (cursor + record->length > size) { return 0; }
+  memcpy(record->data, &dump[cursor], record->length);
+  return cursor + record->length;
+}
@@ -0,0 +1,62 @@
+/**
+ * @brief fixed size log2 histogram of durations in microseconds
+ *
+ * @file Latency_Hist.c
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#include "include/Latency_Hist.h"
+
+#include <string.h>
+
+/**
+ * @brief bucket of a duration, the number of significant bits of the value
+ *
+ */
+static uint8_t latency_hist_bucket(const uint32_t durationUs) {
+  if (0 == durationUs) { return 0; }
+  uint8_t bucketIndex = 32 - __builtin_clz(durationUs);
+  return (bucketIndex < LATENCY_HIST_BUCKET) ? bucketIndex : LATENCY_HIST_BUCKET - 1;
+}
+
+void latency_hist_reset(LatencyHist* hist) { memset(hist, 0, sizeof(*hist)); }
+
+void latency_hist_add(LatencyHist* hist, const uint32_t durationUs) {
+  ++hist->bucket[latency_hist_bucket(durationUs)];
+  ++hist->count;
+  if (durationUs > hist->maxUs) { hist->maxUs = durationUs; }
+}
+
+void latency_hist_merge(LatencyHist* hist, const LatencyHist* other) {
+  for (uint8_t bucketIndex = 0; bucketIndex < LATENCY_HIST_BUCKET; ++bucketIndex) {
+    hist->bucket[bucketIndex] += other->bucket[bucketIndex];
+  }
+  hist->count += other->count;
+  if (other->maxUs > hist->maxUs) { hist->maxUs = other->maxUs; }
+}
+
+/**
+ * @brief walk the buckets until percent of the samples are covered
+ *
+ */
+uint32_t latency_hist_percentile_us(const LatencyHist* hist, const uint8_t percent) {
+  if (0 == hist->count) { return 0; }
+
+  // rank of the sample at the percentile, rounded up so that p100 is the last sample
+  uint64_t rank       = ((uint64_t)hist->count * percent + 99) / 100;
+  uint64_t totalCount = 0;
+  if (0 == rank) { rank = 1; }
+
+  for (uint8_t bucketIndex = 0; bucketIndex < LATENCY_HIST_BUCKET; ++bucketIndex) {
+    totalCount += hist->bucket[bucketIndex];
+    if (totalCount >= rank) {
+      // the last bucket is open ended, the largest value seen is its best upper edge
+      if (0 == bucketIndex) { return 0; }
+      if (LATENCY_HIST_BUCKET - 1 == bucketIndex) { return hist->maxUs; }
+      uint32_t upperUs = ((uint32_t)1 << bucketIndex) - 1;
+      return (upperUs < hist->maxUs) ? upperUs : hist->maxUs;
+    }
+  }
+  return hist->maxUs;
+}
@@ -0,0 +1,19 @@
+/**
+ * @brief helpers shared by every time source
+ *
+ * @file Time_Source.c
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#include "include/Time_Source.h"
+
+uint32_t time_source_now_us(const TimeSource* source) { return source->now_us(source->context); }
+
+uint32_t time_source_elapsed_us(const TimeSource* source, const uint32_t startUs) {
+  return time_source_now_us(source) - startUs;
+}
+
+int32_t time_source_diff_us(const uint32_t laterUs, const uint32_t earlierUs) {
+  return (int32_t)(laterUs - earlierUs);
+}
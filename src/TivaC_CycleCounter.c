@@ -0,0 +1,66 @@
+/**
+ * @brief Contain DWT cycle counter functions for TivaC
+ *
+ * @file TivaC_CycleCounter.c
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#include "include/TivaC_CycleCounter.h"
+
+#include "external/TivaC_Utils/include/tm4c123gh6pm.h"
+
+// the TI register header doesn't cover the Cortex-M4 debug blocks
+#ifndef DWT_CTRL_R
+#define DWT_CTRL_R (*((volatile uint32_t*)0xE0001000))
+#define DWT_CYCCNT_R (*((volatile uint32_t*)0xE0001004))
+#define CORE_DEMCR_R (*((volatile uint32_t*)0xE000EDFC))
+#endif
+
+#define DWT_CTRL_CYCCNTENA 0x00000001
+#define DWT_CTRL_NOCYCCNT 0x02000000  // set on parts built without the cycle counter
+#define CORE_DEMCR_TRCENA 0x01000000
+
+/**
+ * @brief set the enable bits only when they are clear, an enabled counter costs two reads
+ *
+ */
+bool cycle_counter_open(void) {
+  if (!(CORE_DEMCR_R & CORE_DEMCR_TRCENA)) { CORE_DEMCR_R |= CORE_DEMCR_TRCENA; }
+  uint32_t control = DWT_CTRL_R;
+  if (control & DWT_CTRL_NOCYCCNT) { return false; }
+  if (!(control & DWT_CTRL_CYCCNTENA)) { DWT_CTRL_R = control | DWT_CTRL_CYCCNTENA; }
+  return true;
+}
+
+uint32_t cycle_counter_get(void) { return DWT_CYCCNT_R; }
+
+/**
+ * @brief microseconds since startCycle, the subtraction wraps with the 32 bit counter
+ *
+ */
+uint32_t cycle_counter_elapsed_us(const uint32_t startCycle) {
+  return (cycle_counter_get() - startCycle) / CYCLE_COUNTER_CLOCK_MHZ;
+}
+
+/**
+ * @brief start a deadline now, the budget is capped so it can't outlast one wrap of the counter
+ *
+ */
+CycleDeadline cycle_deadline(const uint32_t budgetUs) {
+  CycleDeadline deadline;
+  deadline.budgetUs   = (budgetUs > CYCLE_COUNTER_MAX_US) ? CYCLE_COUNTER_MAX_US : budgetUs;
+  deadline.isTimed    = cycle_counter_open();
+  deadline.startCycle = deadline.isTimed ? cycle_counter_get() : 0;
+  deadline.pollLeft   = deadline.budgetUs * CYCLE_COUNTER_POLL_PER_US;
+  return deadline;
+}
+
+bool cycle_deadline_expired(CycleDeadline* deadline) {
+  if (deadline->isTimed) {
+    return cycle_counter_elapsed_us(deadline->startCycle) > deadline->budgetUs;
+  }
+  if (0 == deadline->pollLeft) { return true; }
+  --deadline->pollLeft;
+  return false;
+}
@@ -0,0 +1,121 @@
+/**
+ * @brief Contain EEPROM functions for TivaC
+ *
+ * @file TivaC_EEPROM.c
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#include "include/TivaC_EEPROM.h"
+
+#include <stdbool.h>
+
+#include "external/TivaC_Utils/include/tm4c123gh6pm.h"
+#include "include/TivaC_CycleCounter.h"
+
+#define EEPROM_WORD_PER_BLOCK 16
+#define EEPROM_WORD_SIZE 4
+
+// a program can take a few ms when the EEPROM has to copy out a full sector
+#define EEPROM_TIMEOUT_US 20000
+
+/**
+ * @brief check that the word range is inside the EEPROM
+ *
+ */
+static EepromErrCode eeprom_check_range(const uint32_t address, const uint32_t totalWord) {
+  uint32_t totalEepromWord = (EEPROM_EESIZE_R & EEPROM_EESIZE_WORDCNT_M) >> EEPROM_EESIZE_WORDCNT_S;
+  if ((address % EEPROM_WORD_SIZE) != 0 ||
+      (address / EEPROM_WORD_SIZE) + totalWord > totalEepromWord) {
+    return EEPROM_INVAL_ADDR;
+  }
+  return EEPROM_NO_ERR;
+}
+
+/**
+ * @brief point the EEPROM at the block and offset of a byte address
+ *
+ */
+static void eeprom_seek(const uint32_t wordIndex) {
+  EEPROM_EEBLOCK_R  = wordIndex / EEPROM_WORD_PER_BLOCK;
+  EEPROM_EEOFFSET_R = wordIndex % EEPROM_WORD_PER_BLOCK;
+}
+
+/**
+ * @brief enable the EEPROM clock and run the power up sequence from the datasheet
+ *
+ */
+EepromErrCode eeprom_open(void) {
+  SYSCTL_RCGCEEPROM_R |= SYSCTL_RCGCEEPROM_R0;
+  while (!(SYSCTL_PREEPROM_R & SYSCTL_PREEPROM_R0)) {
+    // wait until the module is ready
+  }
+  EEPROM_TRY_FUNC(eeprom_wait_done());
+  if (EEPROM_EESUPP_R & (EEPROM_EESUPP_PRETRY | EEPROM_EESUPP_ERETRY)) { return EEPROM_RETRY_FAIL; }
+
+  // reset the module so that it starts from a known state
+  SYSCTL_SREEPROM_R |= SYSCTL_SREEPROM_R0;
+  SYSCTL_SREEPROM_R &= ~SYSCTL_SREEPROM_R0;
+  while (!(SYSCTL_PREEPROM_R & SYSCTL_PREEPROM_R0)) {
+    // wait until the module is ready
+  }
+  EEPROM_TRY_FUNC(eeprom_wait_done());
+  if (EEPROM_EESUPP_R & (EEPROM_EESUPP_PRETRY | EEPROM_EESUPP_ERETRY)) { return EEPROM_RETRY_FAIL; }
+
+  return EEPROM_NO_ERR;
+}
+
+/**
+ * @brief read words from the EEPROM
+ * @param address byte address of the first word
+ *
+ */
+EepromErrCode eeprom_read(const uint32_t address, uint32_t* data, const uint32_t totalWord) {
+  EEPROM_TRY_FUNC(eeprom_check_range(address, totalWord));
+  EEPROM_TRY_FUNC(eeprom_wait_done());
+
+  uint32_t wordIndex = address / EEPROM_WORD_SIZE;
+  for (uint32_t dataIndex = 0; dataIndex < totalWord; ++dataIndex, ++wordIndex) {
+    // the offset wraps within the block so the block has to be set again at every boundary
+    if (0 == dataIndex || 0 == (wordIndex % EEPROM_WORD_PER_BLOCK)) { eeprom_seek(wordIndex); }
+    data[dataIndex] = EEPROM_EERDWRINC_R;
+  }
+  return EEPROM_NO_ERR;
+}
+
+/**
+ * @brief write words to the EEPROM, words that already hold the same value are skipped to save
+ * wear
+ * @param address byte address of the first word
+ *
+ */
+EepromErrCode eeprom_write(const uint32_t address, const uint32_t* data, const uint32_t totalWord) {
+  EEPROM_TRY_FUNC(eeprom_check_range(address, totalWord));
+  EEPROM_TRY_FUNC(eeprom_wait_done());
+
+  uint32_t wordIndex = address / EEPROM_WORD_SIZE;
+  for (uint32_t dataIndex = 0; dataIndex < totalWord; ++dataIndex, ++wordIndex) {
+    eeprom_seek(wordIndex);
+    if (EEPROM_EERDWR_R == data[dataIndex]) { continue; }
+
+    EEPROM_EERDWR_R = data[dataIndex];
+    EEPROM_TRY_FUNC(eeprom_wait_done());
+    if (EEPROM_EEDONE_R & (EEPROM_EEDONE_NOPERM | EEPROM_EEDONE_WRBUSY | EEPROM_EEDONE_INVPL)) {
+      return EEPROM_WRITE_FAIL;
+    }
+  }
+  return EEPROM_NO_ERR;
+}
+
+/**
+ * @brief used for waiting till the EEPROM is done with the current operation, at most
+ * EEPROM_TIMEOUT_US so a hung EEPROM costs a known time at start up
+ * @return whether the EEPROM is idle now or timeout happened
+ */
+EepromErrCode eeprom_wait_done(void) {
+  CycleDeadline deadline = cycle_deadline(EEPROM_TIMEOUT_US);
+  while (EEPROM_EEDONE_R & EEPROM_EEDONE_WORKING) {
+    if (cycle_deadline_expired(&deadline)) { return EEPROM_TIMEOUT; }
+  }
+  return EEPROM_NO_ERR;
+}
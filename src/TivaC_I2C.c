@@ -11,11 +11,57 @@
 #include <stdbool.h>
 
 #include "external/TivaC_Utils/include/tm4c123gh6pm.h"
+#include "include/TivaC_CycleCounter.h"
 
 #define SCL_LP 6
 #define SCL_HP 4
 
-#define I2C0_TIMEOUT_LIMIT 10000
+#define I2C0_SCL_PERIOD_NS 10000  // 100 kHz standard mode
+#define I2C0_CPU_PERIOD_NS 62.5   // 16 MHz system clock
+
+// wait budgets: 9 bits per byte with the ack, start and stop take one bit each, the result is
+// doubled for margin and every byte gets some time for the cpu to service the controller
+#define I2C0_BIT_PER_BYTE 9
+#define I2C0_FRAME_EXTRA_BIT 2
+#define I2C0_BUDGET_MARGIN 2
+#define I2C0_BYTE_SLACK_US 20
+
+#define I2C0_SCL_PIN 0x04      // PB2
+#define I2C0_SDA_PIN 0x08      // PB3
+#define I2C0_RECOVERY_PULSE 9  // a slave stuck mid byte lets go of SDA within 9 clocks
+
+static BusStats i2c0Stats;
+
+/**
+ * @brief deadline for an operation moving totalByte bytes on the bus, address byte included
+ *
+ */
+static CycleDeadline i2c0_deadline(const uint8_t totalByte) {
+  uint32_t totalBit = (uint32_t)totalByte * I2C0_BIT_PER_BYTE + I2C0_FRAME_EXTRA_BIT;
+  return cycle_deadline(totalBit * I2C0_SCL_PERIOD_NS / 1000 * I2C0_BUDGET_MARGIN +
+                          (uint32_t)totalByte * I2C0_BYTE_SLACK_US);
+}
+
+/**
+ * @brief spin until the controller is idle or the deadline has passed
+ * @return whether the bus is idle now or timeout happened
+ */
+static I2c0ErrCode i2c0_wait_bus_until(CycleDeadline* deadline) {
+  uint32_t spinCount  = 0;
+  bool     isTimedOut = false;
+  while ((I2C0_MCS_R & I2C_MCS_BUSY)) {
+    if (cycle_deadline_expired(deadline)) {
+      BUS_STATS_ADD(i2c0Stats, timeout, 1);
+      isTimedOut = true;
+      break;
+    }
+    ++spinCount;
+  }
+  BUS_STATS_ADD(i2c0Stats, waitCall, 1);
+  BUS_STATS_ADD(i2c0Stats, waitSpinTotal, spinCount);
+  BUS_STATS_MAX(i2c0Stats, waitSpinMax, spinCount);
+  return isTimedOut ? I2C0_TIMEOUT : I2C0_NO_ERR;
+}
 
 /**
  * @brief calculate the timer period for I2C
@@ -64,18 +110,78 @@ I2c0ErrCode i2c0_open(void) {
 
   // calculate the clock cycle and input into I2CMTPR
   uint8_t tpr;
-  i2c0_calculate_tpr(10000, 62.5, &tpr);
+  i2c0_calculate_tpr(I2C0_SCL_PERIOD_NS, I2C0_CPU_PERIOD_NS, &tpr);
   I2C0_MTPR_R &= ~(I2C_MTPR_TPR_M);
   I2C0_MTPR_R += tpr << I2C_MTPR_TPR_S;
   return I2C0_NO_ERR;
 }
 
+/**
+ * @brief hold for half an SCL period while bit banging the bus, at least that long on a part
+ * without the cycle counter, see CycleDeadline
+ *
+ */
+static void i2c0_half_period_delay(void) {
+  CycleDeadline deadline = cycle_deadline(I2C0_SCL_PERIOD_NS / 2000);
+  while (false == cycle_deadline_expired(&deadline)) {
+    // wait loop
+  }
+}
+
+/**
+ * @brief drive an open drain I2C pin low or release it to the pull-up
+ *
+ */
+static void i2c0_gpio_drive(const uint32_t pin, const bool isHigh) {
+  if (isHigh) {
+    GPIO_PORTB_DIR_R &= ~pin;  // input, the pull-up takes the line high unless a slave holds it
+  } else {
+    GPIO_PORTB_DATA_R &= ~pin;
+    GPIO_PORTB_DIR_R |= pin;
+  }
+  i2c0_half_period_delay();
+}
+
+/**
+ * @brief recover from a slave holding SDA low, for example after a brownout mid read
+ *
+ * PB2/PB3 are switched to GPIO and SCL is clocked until SDA is released, at most 9 times, a STOP
+ * condition is then generated by hand and the controller is set up again with i2c0_open
+ * @return I2C0_BUS_ERROR if SDA is still held low afterward
+ */
+I2c0ErrCode i2c0_recover_bus(void) {
+  BUS_STATS_ADD(i2c0Stats, recovery, 1);
+
+  GPIO_PORTB_AFSEL_R &= ~(I2C0_SCL_PIN | I2C0_SDA_PIN);
+  GPIO_PORTB_ODR_R |= I2C0_SCL_PIN | I2C0_SDA_PIN;
+  i2c0_gpio_drive(I2C0_SDA_PIN, true);
+  i2c0_gpio_drive(I2C0_SCL_PIN, true);
+
+  for (uint8_t pulseIndex = 0;
+       pulseIndex < I2C0_RECOVERY_PULSE && !(GPIO_PORTB_DATA_R & I2C0_SDA_PIN);
+       ++pulseIndex) {
+    i2c0_gpio_drive(I2C0_SCL_PIN, false);
+    i2c0_gpio_drive(I2C0_SCL_PIN, true);
+  }
+
+  // STOP: SDA goes from low to high while SCL is high
+  i2c0_gpio_drive(I2C0_SCL_PIN, false);
+  i2c0_gpio_drive(I2C0_SDA_PIN, false);
+  i2c0_gpio_drive(I2C0_SCL_PIN, true);
+  i2c0_gpio_drive(I2C0_SDA_PIN, true);
+  bool isSdaReleased = GPIO_PORTB_DATA_R & I2C0_SDA_PIN;
+
+  I2C0_TRY_FUNC(i2c0_open());
+  return isSdaReleased ? I2C0_NO_ERR : I2C0_BUS_ERROR;
+}
+
 /**
  * @brief Disable clock as well as the I2C pins
  *
  */
 I2c0ErrCode i2c0_close(void) {
-  I2C0_TRY_FUNC(i2c0_wait_bus());
+  CycleDeadline deadline = i2c0_deadline(1);
+  I2C0_TRY_FUNC(i2c0_wait_bus_until(&deadline));
 
   // turn off I2C0 clock first
   SYSCTL_RCGCI2C_R &= ~SYSCTL_RCGCI2C_R0;
@@ -101,8 +207,9 @@ I2c0ErrCode i2c0_single_data_read(const uint8_t slave_address,
                                   const bool    no_ack,
                                   const bool    no_stop,
                                   const bool    no_start) {
+  CycleDeadline deadline = i2c0_deadline(2);
   uint32_t i2c0_mcs_temp = 0;
-  I2C0_TRY_FUNC(i2c0_wait_bus());
+  I2C0_TRY_FUNC(i2c0_wait_bus_until(&deadline));
 
   // go into receive mode
   I2C0_MSA_R |= I2C_MSA_RS;
@@ -111,7 +218,7 @@ I2c0ErrCode i2c0_single_data_read(const uint8_t slave_address,
   I2C0_MSA_R &= ~I2C_MSA_SA_M;
   I2C0_MSA_R += (slave_address << I2C_MSA_SA_S) & (I2C_MSA_SA_M);
 
-  I2C0_TRY_FUNC(i2c0_wait_bus());
+  I2C0_TRY_FUNC(i2c0_wait_bus_until(&deadline));
 
   // option parsing
   if (no_start) {
@@ -134,10 +241,12 @@ I2c0ErrCode i2c0_single_data_read(const uint8_t slave_address,
   i2c0_mcs_temp |= I2C_MCS_RUN;
   I2C0_MCS_R = i2c0_mcs_temp;
 
-  I2C0_TRY_FUNC(i2c0_wait_bus());
+  I2C0_TRY_FUNC(i2c0_wait_bus_until(&deadline));
   I2C0_TRY_FUNC(i2c0_error_check());
 
   *returnData = ((I2C0_MDR_R) & (I2C_MDR_DATA_M)) >> I2C_MDR_DATA_S;
+  BUS_STATS_ADD(i2c0Stats, transaction, 1);
+  BUS_STATS_ADD(i2c0Stats, byteRx, 1);
   return I2C0_NO_ERR;
 }
 
@@ -149,7 +258,8 @@ I2c0ErrCode i2c0_single_data_read(const uint8_t slave_address,
 I2c0ErrCode i2c0_single_data_write(const uint8_t slave_address,
                                    const uint8_t data_byte,
                                    const bool    no_end_stop) {
-  I2C0_TRY_FUNC(i2c0_wait_bus());
+  CycleDeadline deadline = i2c0_deadline(2);
+  I2C0_TRY_FUNC(i2c0_wait_bus_until(&deadline));
 
   I2C0_MSA_R &= ~(I2C_MSA_SA_M);
   I2C0_MSA_R += (slave_address << I2C_MSA_SA_S);
@@ -157,9 +267,9 @@ I2c0ErrCode i2c0_single_data_write(const uint8_t slave_address,
   // go into write mode
   I2C0_MSA_R &= ~(I2C_MSA_RS);
 
-  I2C0_MDR_R |= I2C_MDR_DATA_M & (data_byte << I2C_MDR_DATA_S);
+  I2C0_MDR_R = I2C_MDR_DATA_M & (data_byte << I2C_MDR_DATA_S);
 
-  I2C0_TRY_FUNC(i2c0_wait_bus());
+  I2C0_TRY_FUNC(i2c0_wait_bus_until(&deadline));
 
   // write settings
   if (no_end_stop) {
@@ -168,9 +278,11 @@ I2c0ErrCode i2c0_single_data_write(const uint8_t slave_address,
     I2C0_MCS_R = (I2C_MCS_START | I2C_MCS_RUN | I2C_MCS_STOP) & (~I2C_MCS_HS);
   }
 
-  I2C0_TRY_FUNC(i2c0_wait_bus());
+  I2C0_TRY_FUNC(i2c0_wait_bus_until(&deadline));
 
   I2C0_TRY_FUNC(i2c0_error_check());
+  BUS_STATS_ADD(i2c0Stats, transaction, 1);
+  BUS_STATS_ADD(i2c0Stats, byteTx, 1);
   return I2C0_NO_ERR;
 }
 
@@ -179,13 +291,14 @@ I2c0ErrCode i2c0_single_data_write(const uint8_t slave_address,
  *
  */
 I2c0ErrCode i2c0_stop(void) {
-  I2C0_TRY_FUNC(i2c0_wait_bus());
+  CycleDeadline deadline = i2c0_deadline(1);
+  I2C0_TRY_FUNC(i2c0_wait_bus_until(&deadline));
   uint32_t i2c0_mcs_temp = 0;
   i2c0_mcs_temp &= ~I2C_MCS_RUN;
   i2c0_mcs_temp &= ~I2C_MCS_START;
   i2c0_mcs_temp |= I2C_MCS_STOP;
   I2C0_MCS_R = i2c0_mcs_temp;
-  I2C0_TRY_FUNC(i2c0_wait_bus());
+  I2C0_TRY_FUNC(i2c0_wait_bus_until(&deadline));
   I2C0_TRY_FUNC(i2c0_error_check());
   return I2C0_NO_ERR;
 }
@@ -195,13 +308,14 @@ I2c0ErrCode i2c0_stop(void) {
  *
  */
 I2c0ErrCode i2c0_keep_state(void) {
-  I2C0_TRY_FUNC(i2c0_wait_bus());
+  CycleDeadline deadline = i2c0_deadline(1);
+  I2C0_TRY_FUNC(i2c0_wait_bus_until(&deadline));
   uint32_t i2c0_mcs_temp = 0;
   i2c0_mcs_temp |= I2C_MCS_RUN;
   i2c0_mcs_temp &= ~I2C_MCS_START;
   i2c0_mcs_temp &= ~I2C_MCS_STOP;
   I2C0_MCS_R = i2c0_mcs_temp;
-  I2C0_TRY_FUNC(i2c0_wait_bus());
+  I2C0_TRY_FUNC(i2c0_wait_bus_until(&deadline));
   return I2C0_NO_ERR;
 }
 
@@ -215,7 +329,8 @@ I2c0ErrCode i2c0_multiple_data_byte_write(const uint8_t  slave_address,
   // check if there are actually multiple data bytes
   if (output_buffer_length < 2 || output_buffer == NULL) { return 2; }
 
-  I2C0_TRY_FUNC(i2c0_wait_bus());
+  CycleDeadline deadline = i2c0_deadline(output_buffer_length + 1);
+  I2C0_TRY_FUNC(i2c0_wait_bus_until(&deadline));
 
   // go into write mode
   I2C0_MSA_R &= ~(I2C_MSA_RS);
@@ -225,32 +340,34 @@ I2c0ErrCode i2c0_multiple_data_byte_write(const uint8_t  slave_address,
   // after first transmit remain in transmit state
   I2C0_MSA_R &= ~(I2C_MSA_SA_M);
   I2C0_MSA_R += (slave_address << I2C_MSA_SA_S);
-  I2C0_MDR_R |= I2C_MDR_DATA_M & ((*output_buffer++) << I2C_MDR_DATA_S);
+  I2C0_MDR_R = I2C_MDR_DATA_M & ((*output_buffer++) << I2C_MDR_DATA_S);
   I2C0_MCS_R = (I2C_MCS_START | I2C_MCS_RUN) & ((~I2C_MCS_STOP) & (~I2C_MCS_HS));
 
-  I2C0_TRY_FUNC(i2c0_wait_bus());
+  I2C0_TRY_FUNC(i2c0_wait_bus_until(&deadline));
 
   I2C0_TRY_FUNC(i2c0_error_check());
 
   for (int buffer_index = 1; buffer_index < output_buffer_length - 1; ++buffer_index) {
     // transmit until the element before the last one
-    I2C0_MDR_R |= I2C_MDR_DATA_M & ((*output_buffer++) << I2C_MDR_DATA_S);
+    I2C0_MDR_R = I2C_MDR_DATA_M & ((*output_buffer++) << I2C_MDR_DATA_S);
     I2C0_MSA_R &= ~(I2C_MSA_RS);
     I2C0_MCS_R = ((~I2C_MCS_START) & (~I2C_MCS_STOP) & (~I2C_MCS_HS)) | I2C_MCS_RUN;
 
-    I2C0_TRY_FUNC(i2c0_wait_bus());
+    I2C0_TRY_FUNC(i2c0_wait_bus_until(&deadline));
 
     I2C0_TRY_FUNC(i2c0_error_check());
   }
 
   // transmit the last element and return to idle state
-  I2C0_MDR_R |= I2C_MDR_DATA_M & ((*output_buffer) << I2C_MDR_DATA_S);
+  I2C0_MDR_R = I2C_MDR_DATA_M & ((*output_buffer) << I2C_MDR_DATA_S);
   I2C0_MSA_R &= ~(I2C_MSA_RS);
   I2C0_MCS_R = ((~I2C_MCS_START) & (~I2C_MCS_HS)) | ((I2C_MCS_STOP) | (I2C_MCS_RUN));
 
-  I2C0_TRY_FUNC(i2c0_wait_bus());
+  I2C0_TRY_FUNC(i2c0_wait_bus_until(&deadline));
 
   I2C0_TRY_FUNC(i2c0_error_check());
+  BUS_STATS_ADD(i2c0Stats, transaction, 1);
+  BUS_STATS_ADD(i2c0Stats, byteTx, output_buffer_length);
   return I2C0_NO_ERR;
 }
 
@@ -259,7 +376,8 @@ I2c0ErrCode i2c0_multiple_data_byte_read(const uint8_t slave_address,
                                          const uint8_t input_buffer_length) {
   if (input_buffer == NULL || input_buffer_length < 2) { return 2; }
 
-  I2C0_TRY_FUNC(i2c0_wait_bus());
+  CycleDeadline deadline = i2c0_deadline(input_buffer_length + 1);
+  I2C0_TRY_FUNC(i2c0_wait_bus_until(&deadline));
   int buffer_index = 0;
 
   // go into receive mode
@@ -269,13 +387,15 @@ I2c0ErrCode i2c0_multiple_data_byte_read(const uint8_t slave_address,
   I2C0_MSA_R &= ~(I2C_MSA_SA_M);
   I2C0_MSA_R += (slave_address << I2C_MSA_SA_S) & (I2C_MSA_SA_M);
 
-  I2C0_TRY_FUNC(i2c0_wait_bus());
+  I2C0_TRY_FUNC(i2c0_wait_bus_until(&deadline));
 
   // initiate the first read
 
   I2C0_MCS_R = (I2C_MCS_START | I2C_MCS_RUN | I2C_MCS_ACK) & (~I2C_MCS_STOP);
 
-  I2C0_TRY_FUNC(i2c0_wait_bus());
+  I2C0_TRY_FUNC(i2c0_wait_bus_until(&deadline));
+
+  I2C0_TRY_FUNC(i2c0_error_check());
 
   input_buffer[buffer_index] = (I2C0_MDR_R & I2C_MDR_DATA_M) << I2C_MDR_DATA_S;
 
@@ -284,7 +404,7 @@ I2c0ErrCode i2c0_multiple_data_byte_read(const uint8_t slave_address,
     I2C0_MSA_R |= I2C_MSA_RS;
     I2C0_MCS_R = (I2C_MCS_RUN | I2C_MCS_ACK) & (~I2C_MCS_STOP) & (~I2C_MCS_START);
 
-    I2C0_TRY_FUNC(i2c0_wait_bus());
+    I2C0_TRY_FUNC(i2c0_wait_bus_until(&deadline));
 
     I2C0_TRY_FUNC(i2c0_error_check());
 
@@ -295,16 +415,17 @@ I2c0ErrCode i2c0_multiple_data_byte_read(const uint8_t slave_address,
   I2C0_MSA_R |= I2C_MSA_RS;
   I2C0_MCS_R = (I2C_MCS_RUN | I2C_MCS_STOP) & ((~I2C_MCS_START) & (~I2C_MCS_ACK));
 
-  I2C0_TRY_FUNC(i2c0_wait_bus());
+  I2C0_TRY_FUNC(i2c0_wait_bus_until(&deadline));
 
   I2C0_TRY_FUNC(i2c0_error_check());
 
   input_buffer[buffer_index] = (I2C0_MDR_R & I2C_MDR_DATA_M);
 
-  I2C0_TRY_FUNC(i2c0_wait_bus());
+  I2C0_TRY_FUNC(i2c0_wait_bus_until(&deadline));
 
   I2C0_TRY_FUNC(i2c0_error_check());
-
+  BUS_STATS_ADD(i2c0Stats, transaction, 1);
+  BUS_STATS_ADD(i2c0Stats, byteRx, input_buffer_length);
   return I2C0_NO_ERR;
 }
 
@@ -314,6 +435,7 @@ I2c0ErrCode i2c0_multiple_data_byte_read(const uint8_t slave_address,
  */
 I2c0ErrCode i2c0_error_check(void) {
   if (I2C0_MCS_R & I2C_MCS_ERROR) {
+    BUS_STATS_ADD(i2c0Stats, busError, 1);
     return I2C0_BUS_ERROR;
   } else {
     return I2C0_NO_ERR;
@@ -329,14 +451,21 @@ I2c0ErrCode i2c0_check_master_enabled(void) {
 }
 
 /**
- * @brief used for waiting till the bus stops being busy
+ * @brief used for waiting till the bus stops being busy, gives up after the time one byte takes
  * @return whether the bus is idle now or timeout happened
  */
 I2c0ErrCode i2c0_wait_bus(void) {
-  uint32_t timeoutCounter = 0;
-  while ((I2C0_MCS_R & I2C_MCS_BUSY)) {
-    if (timeoutCounter > I2C0_TIMEOUT_LIMIT) { return I2C0_TIMEOUT; }
-    ++timeoutCounter;
-  }
-  return I2C0_NO_ERR;
+  CycleDeadline deadline = i2c0_deadline(1);
+  return i2c0_wait_bus_until(&deadline);
+}
+
+/**
+ * @brief copy the I2C0 counters
+ *
+ */
+void i2c0_get_stats(BusStats* stats) { *stats = i2c0Stats; }
+
+void i2c0_reset_stats(void) {
+  BusStats emptyStats = {0};
+  i2c0Stats           = emptyStats;
 }
@@ -9,6 +9,11 @@
 #include "external/TivaC_Utils/include/bit_manipulation.h"
 #include "external/TivaC_Utils/include/tm4c123gh6pm.h"
 #include "include/TivaC_SPI_utils.h"
+#include "include/TivaC_CycleCounter.h"
+
+#define SPI_FIFO_DEPTH 8  // frames spi_close may have to wait out
+
+static SpiSettings spiOpenSetting;  // kept so spi_close can size its wait from the bit rate
 
 /**
  * @brief set up spi bus, should be called first
@@ -23,6 +28,7 @@ SpiErrCode spi_open(const SpiSettings setting) {
 
   uint8_t preScalc = 0;
   uint8_t scr      = 0;
+  spiOpenSetting   = setting;
 
   /* Prepping GPIO pin for SPI functionalities */
   SYSCTL_RCGCSSI_R |= SYSCTL_RCGCSSI_R0;    // turn on SPI module
@@ -144,65 +150,106 @@ SpiErrCode spi_check_spi_enabled(void) {
  * Will wait to make sure that all SPI traffic is done before turning off the clock
  */
 SpiErrCode spi_close(void) {
-  SPI_TRY_FUNC(spi_bus_wait());
+  CycleDeadline deadline = spi_deadline(spiOpenSetting, SPI_FIFO_DEPTH);
+  SPI_TRY_FUNC(spi_bus_wait(&deadline));
   bit_clear(SYSCTL_RCGCSSI_R, SYSCTL_RCGCSSI_R0);
   return SPI_ERR_NO_ERR;
 }
 
 /**
- * @brief used for both rx and tx
+ * @brief clock the frames of one transfer, the caller releases CS and the SSI afterward
  *
- * enable SPI, and then send/receive based on the user inputs, after a transfer the SPI module would
- * be disabled to make sure no transfer erroneously happens, this is a soft disable with all the
- * clocks and pins still SPI-ready
  */
-SpiErrCode spi_transfer(const SpiSettings setting,
-                        uint8_t*          dataTx,
-                        const uint8_t     dataTxLenByte,
-                        uint8_t*          dataRx,
-                        const uint8_t     dataRxLenByte) {
-  /* Pre-Transfer Error Checking */
-  SPI_TRY_FUNC(spi_check_spi_enabled());
-
-  if ((dataTxLenByte) > 0) { assert(dataTx); }
-
-  if ((dataRxLenByte) > 0) { assert(dataRx); }
-
-  /* Begin Transfer */
+static SpiErrCode spi_transfer_frames(const SpiSettings setting,
+                                      CycleDeadline*    deadline,
+                                      uint8_t*          dataTx,
+                                      const uint8_t     dataTxLenByte,
+                                      uint8_t*          dataRx,
+                                      const uint8_t     dataRxLenByte) {
   uint8_t totalByteTxed = 0;
   uint8_t totalByteRxed = 0;
   bool    firstRun      = true;
 
-  spi_enable_spi();
-  spi_clear_rx_buffer();
   while (totalByteTxed < dataTxLenByte || totalByteRxed < dataRxLenByte) {
     spi_pull_cs_low();
 
     if ((totalByteTxed < dataTxLenByte)) {
-      spi_tx_one_data_unit(setting.transferSizeBit, &totalByteTxed, dataTx);
+      SPI_TRY_FUNC(
+          spi_tx_one_data_unit(deadline, setting.transferSizeBit, &totalByteTxed, dataTx));
     }
 
-    spi_data_delay();
     if (true == firstRun) {
-      // the slave won't send any data on the first run so
-      // clear rx buffer on first run since it's just rubbish data
+      // the slave won't send any data on the first run so wait for the byte clocked in with the
+      // first tx and clear the rx buffer, it's just rubbish data
+      if (totalByteTxed > 0) {
+        SPI_TRY_FUNC(spi_bus_wait(deadline));
+        SPI_TRY_FUNC(spi_rx_wait(deadline));
+      }
       spi_clear_rx_buffer();
       firstRun = false;
     }
 
     if ((totalByteRxed < dataRxLenByte)) {
-      if (dataTxLenByte == totalByteTxed) { spi_send_dummy_byte(); }
-      spi_rx_one_data_unit(setting, &totalByteRxed, dataRx);
+      if (dataTxLenByte == totalByteTxed) { SPI_TRY_FUNC(spi_send_dummy_byte(deadline)); }
+      SPI_TRY_FUNC(spi_rx_one_data_unit(deadline, &totalByteRxed, dataRx));
     }
-    SPI_TRY_FUNC(spi_bus_wait());
+    SPI_TRY_FUNC(spi_bus_wait(deadline));
     if ((setting.cpol == 0 && setting.cpha == 0) || (setting.cpol == 1 && setting.cpha == 0)) {
       spi_pull_cs_high();  // the spi module requires that cs is pulled high on these settings
                            // btween transfer
     }
   }
+  return SPI_ERR_NO_ERR;
+}
+
+/**
+ * @brief used for both rx and tx
+ *
+ * enable SPI, and then send/receive based on the user inputs, after a transfer the SPI module would
+ * be disabled to make sure no transfer erroneously happens, this is a soft disable with all the
+ * clocks and pins still SPI-ready
+ *
+ * Every wait in the transfer shares one deadline sized from the bit rate and the number of frames,
+ * a stuck bus returns SPI_ERR_TIMEOUT after that budget with CS released
+ */
+SpiErrCode spi_transfer(const SpiSettings setting,
+                        uint8_t*          dataTx,
+                        const uint8_t     dataTxLenByte,
+                        uint8_t*          dataRx,
+                        const uint8_t     dataRxLenByte) {
+  /* Pre-Transfer Error Checking */
+  SPI_TRY_FUNC(spi_check_spi_enabled());
+
+  if ((dataTxLenByte) > 0) { assert(dataTx); }
+
+  if ((dataRxLenByte) > 0) { assert(dataRx); }
+
+  /* Begin Transfer */
+  // a byte is either sent or clocked in with a dummy byte, a full duplex frame does both
+  CycleDeadline deadline = spi_deadline(setting, (uint16_t)dataTxLenByte + dataRxLenByte);
+
+  spi_enable_spi();
+  spi_clear_rx_buffer();
+  SpiErrCode errCode =
+      spi_transfer_frames(setting, &deadline, dataTx, dataTxLenByte, dataRx, dataRxLenByte);
+  if (SPI_ERR_NO_ERR == errCode) { errCode = spi_bus_wait(&deadline); }
 
-  SPI_TRY_FUNC(spi_bus_wait());
   spi_pull_cs_high();
   spi_disable_spi();
+  if (SPI_ERR_NO_ERR != errCode) { return errCode; }
+  BUS_STATS_ADD(spiStats, transaction, 1);
+  BUS_STATS_ADD(spiStats, byteTx, dataTxLenByte);
+  BUS_STATS_ADD(spiStats, byteRx, dataRxLenByte);
   return SPI_ERR_NO_ERR;
 }
+
+/**
+ * @brief copy the SPI counters
+ *
+ */
+void spi_get_stats(BusStats* stats) { *stats = spiStats; }
+
+void spi_reset_stats(void) {
+  BusStats emptyStats = {0};
+  spiStats            = emptyStats;
+}
@@ -11,19 +11,63 @@
 #define MAX_TIVAC_CLOCK 80
 #define MAX_SCR 255      // max SSI serial clock rate
 #define MAX_CPSDVSR 254  // max clock pre scaler
-#define SPI_TIMEOUT_COUNTER 500
+
+// wait budgets: the bit time of every frame doubled for margin, plus some time per frame for the
+// cpu to feed and drain the FIFOs
+#define SPI_BUDGET_MARGIN 2
+#define SPI_FRAME_SLACK_US 20
+
+BusStats spiStats;
 
 /**
- * @brief wait until the spi bus is not busy anymore
+ * @brief deadline for totalFrame frames at the configured bit rate
+ *
+ */
+CycleDeadline spi_deadline(const SpiSettings setting, const uint16_t totalFrame) {
+  float frameUs = (float)setting.transferSizeBit / setting.spiBitRateMbits;
+  return cycle_deadline((uint32_t)(totalFrame * frameUs * SPI_BUDGET_MARGIN) +
+                          (uint32_t)totalFrame * SPI_FRAME_SLACK_US);
+}
+
+/**
+ * @brief spin while the status bits in busyMask read as busy or until the deadline passes
  *
  */
-SpiErrCode spi_bus_wait(void) {
-  uint8_t timeoutCounter = 0;
-  while (SSI0_SR_R & SSI_SR_BSY) {
-    ++timeoutCounter;
-    if ((timeoutCounter) > SPI_TIMEOUT_COUNTER) { return SPI_ERR_TIMEOUT; }
+static SpiErrCode spi_spin(const uint32_t busyMask,
+                           const uint32_t busyValue,
+                           CycleDeadline* deadline) {
+  uint32_t spinCount  = 0;
+  bool     isTimedOut = false;
+  while ((SSI0_SR_R & busyMask) == busyValue) {
+    if (cycle_deadline_expired(deadline)) {
+      BUS_STATS_ADD(spiStats, timeout, 1);
+      isTimedOut = true;
+      break;
+    }
+    ++spinCount;
   }
-  return SPI_ERR_NO_ERR;
+  BUS_STATS_ADD(spiStats, waitCall, 1);
+  BUS_STATS_ADD(spiStats, waitSpinTotal, spinCount);
+  BUS_STATS_MAX(spiStats, waitSpinMax, spinCount);
+  return isTimedOut ? SPI_ERR_TIMEOUT : SPI_ERR_NO_ERR;
+}
+
+/**
+ * @brief wait until the spi bus is not busy anymore
+ *
+ */
+SpiErrCode spi_bus_wait(CycleDeadline* deadline) {
+  return spi_spin(SSI_SR_BSY, SSI_SR_BSY, deadline);
+}
+
+/**
+ * @brief wait until a received data unit has reached the receive FIFO
+ *
+ * The data shows up in the FIFO shortly after the bus goes idle, this replaces the fixed delay
+ * loop that used to sit between receiving and reading the data
+ */
+SpiErrCode spi_rx_wait(CycleDeadline* deadline) {
+  return spi_spin(SSI_SR_RNE, 0, deadline);
 }
 
 SpiErrCode spi_check_rx_full(void) {
@@ -94,14 +138,13 @@ SpiErrCode spi_check_rx_not_empty(void) {
  * @brief receive one data unit from the SPI buffer
  *
  */
-SpiErrCode spi_rx_one_data_unit(const SpiSettings setting,
-                                uint8_t*          totalByteRxed,
-                                uint8_t*          dataRx) {
-  SPI_TRY_FUNC(spi_bus_wait());
-  if (SPI_ERR_NO_ERR == spi_check_rx_not_empty()) {
-    dataRx[*totalByteRxed] = ((SSI0_DR_R)&SSI_DR_DATA_M) >> (SSI_DR_DATA_S);
-    *totalByteRxed         = *totalByteRxed + 1;
-  }
+SpiErrCode spi_rx_one_data_unit(CycleDeadline* deadline,
+                                uint8_t*       totalByteRxed,
+                                uint8_t*       dataRx) {
+  SPI_TRY_FUNC(spi_bus_wait(deadline));
+  SPI_TRY_FUNC(spi_rx_wait(deadline));
+  dataRx[*totalByteRxed] = ((SSI0_DR_R)&SSI_DR_DATA_M) >> (SSI_DR_DATA_S);
+  *totalByteRxed         = *totalByteRxed + 1;
   return SPI_ERR_NO_ERR;
 }
 
@@ -109,18 +152,18 @@ SpiErrCode spi_rx_one_data_unit(const SpiSettings setting,
  * @brief send 8 bits of data on the SPI interface
  *
  */
-SpiErrCode spi_tx_one_data_unit(const uint8_t  transferSize,
+SpiErrCode spi_tx_one_data_unit(CycleDeadline* deadline,
+                                const uint8_t  transferSize,
                                 uint8_t*       totalByteTxed,
                                 const uint8_t* dataTx) {
   if (SPI_ERR_NO_ERR == spi_check_tx_full()) {
-    SPI_TRY_FUNC(spi_bus_wait());
+    SPI_TRY_FUNC(spi_bus_wait(deadline));
     SSI0_DR_R      = (uint8_t)(dataTx[*totalByteTxed]) << (transferSize - SPI_TRF_SIZE);
     *totalByteTxed = *totalByteTxed + 1;
     return SPI_ERR_NO_ERR;
   } else {
     return SPI_ERR_TX_FULL;
   }
-  SPI_TRY_FUNC(spi_bus_wait());
 }
 
 /**
@@ -153,10 +196,10 @@ void spi_enable_spi(void) {
  * bytes that users want
  *
  */
-SpiErrCode spi_send_dummy_byte(void) {
-  SPI_TRY_FUNC(spi_bus_wait());
+SpiErrCode spi_send_dummy_byte(CycleDeadline* deadline) {
+  SPI_TRY_FUNC(spi_bus_wait(deadline));
   SSI0_DR_R = 0;  // used to stretch the transfer until all the data is received
-  SPI_TRY_FUNC(spi_bus_wait());
+  SPI_TRY_FUNC(spi_bus_wait(deadline));
   return SPI_ERR_NO_ERR;
 }
 
@@ -169,21 +212,15 @@ void spi_disable_spi(void) { bit_clear(SSI0_CR1_R, SSI_CR1_SSE); }
 /**
  * @brief pull chip select pin low to activate SPI, hardcoded to be pin 3 of port A
  *
+ * the read of the read-modify-write also tells whether CS was high, so counting the assertions
+ * costs no register access
  */
-void spi_pull_cs_low(void) { bit_clear(GPIO_PORTA_DATA_R, 0x8); }
+void spi_pull_cs_low(void) {
+  uint32_t portData = GPIO_PORTA_DATA_R;
+#if BUS_STATS_ENABLE
+  if (bit_get(portData, 0x8)) { ++spiStats.csAssert; }
+#endif
+  GPIO_PORTA_DATA_R = bit_clear(portData, 0x8);
+}
 
 void spi_pull_cs_high(void) { bit_set(GPIO_PORTA_DATA_R, 0x8); }
-
-/**
- * @brief used to create a really short delay that makes sure that the data received is available
- * for reading
- *
- * There seems to be a short delay between the SPI module receives the data and when that data is
- * available in the FIFO so a delay is necessary
- *
- */
-void __attribute__((optimize("O0"))) spi_data_delay(void) {
-  for (int waitIndex = 0; waitIndex < 50; ++waitIndex) {
-    // wait loop
-  }
-}
\ No newline at end of file
@@ -0,0 +1,53 @@
+/**
+ * @brief Contain SysTick functions for TivaC
+ *
+ * @file TivaC_SysTick.c
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#include "include/TivaC_SysTick.h"
+
+#include "external/TivaC_Utils/include/tm4c123gh6pm.h"
+
+/**
+ * @brief whether SysTick counts over its full 24 bit range from the system clock, the only setup
+ * the drivers can read it in without owning it
+ *
+ */
+bool systick_is_free_running(void) {
+  return (NVIC_ST_CTRL_R & (NVIC_ST_CTRL_CLK_SRC | NVIC_ST_CTRL_ENABLE)) ==
+             (NVIC_ST_CTRL_CLK_SRC | NVIC_ST_CTRL_ENABLE) &&
+         SYSTICK_MAX_TICK == (NVIC_ST_RELOAD_R & NVIC_ST_RELOAD_M);
+}
+
+/**
+ * @brief run SysTick over its full 24 bit range from the system clock
+ *
+ * the counter is left running if it is already set up this way so several users can share it
+ */
+void systick_open(void) {
+  if (systick_is_free_running()) { return; }
+
+  NVIC_ST_CTRL_R    = 0;
+  NVIC_ST_RELOAD_R  = SYSTICK_MAX_TICK;
+  NVIC_ST_CURRENT_R = 0;  // any write clears the counter
+  NVIC_ST_CTRL_R    = NVIC_ST_CTRL_CLK_SRC | NVIC_ST_CTRL_ENABLE;
+}
+
+/**
+ * @brief SysTick counts down, return the ticks elapsed since the last wrap instead
+ *
+ */
+uint32_t systick_get_tick(void) {
+  return SYSTICK_MAX_TICK - (NVIC_ST_CURRENT_R & NVIC_ST_CURRENT_M);
+}
+
+/**
+ * @brief microseconds since startTick, the subtraction is done modulo the 24 bit counter
+ *
+ */
+uint32_t systick_elapsed_us(const uint32_t startTick) {
+  return ((systick_get_tick() - startTick) & SYSTICK_MAX_TICK) / SYSTICK_CLOCK_MHZ;
+}
+
@@ -0,0 +1,60 @@
+/**
+ * @brief Contain SysTick and DWT time sources for TivaC
+ *
+ * @file TivaC_TimeSource.c
+ * @author Khoi Trinh
+ * @date 2026-10-19
+ */
+
+#include "include/TivaC_TimeSource.h"
+
+#include "include/TivaC_CycleCounter.h"
+#include "include/TivaC_SysTick.h"
+
+/**
+ * @brief move the microsecond clock forward by the cycles counted since the last read
+ *
+ */
+static uint32_t tivac_time_advance(TivaCTimeContext* context,
+                                   const uint32_t    count,
+                                   const uint32_t    countMask) {
+  uint32_t totalCycle     = ((count - context->lastCount) & countMask) + context->cycleRemainder;
+  context->lastCount      = count;
+  context->nowUs          = context->nowUs + totalCycle / SYSTICK_CLOCK_MHZ;
+  context->cycleRemainder = totalCycle % SYSTICK_CLOCK_MHZ;
+  return context->nowUs;
+}
+
+static uint32_t tivac_time_systick_now_us(void* context) {
+  return tivac_time_advance((TivaCTimeContext*)context, systick_get_tick(), SYSTICK_MAX_TICK);
+}
+
+static uint32_t tivac_time_dwt_now_us(void* context) {
+  return tivac_time_advance((TivaCTimeContext*)context, cycle_counter_get(), 0xFFFFFFFF);
+}
+
+/**
+ * @brief microsecond clock extended from the 24 bit SysTick counter
+ *
+ */
+void tivac_time_source_systick(TimeSource* source, TivaCTimeContext* context) {
+  systick_open();
+  context->lastCount      = systick_get_tick();
+  context->cycleRemainder = 0;
+  context->nowUs          = 0;
+  source->now_us          = tivac_time_systick_now_us;
+  source->context         = context;
+}
+
+/**
+ * @brief microsecond clock extended from the 32 bit DWT cycle counter, the counter is enabled here
+ *
+ */
+void tivac_time_source_dwt(TimeSource* source, TivaCTimeContext* context) {
+  cycle_counter_open();
+  context->lastCount      = cycle_counter_get();
+  context->cycleRemainder = 0;
+  context->nowUs          = 0;
+  source->now_us          = tivac_time_dwt_now_us;
+  source->context         = context;
+}
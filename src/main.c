@@ -19,11 +19,10 @@
 #define BMP280_ADDR 0x77
 
 int main(void) {
-  bmp280           sensor280;
-  Bmp280CalibParam calibParam;
-  float            temperature;
-  float            pressure;
-  uint8_t          ID;
+  bmp280  sensor280;
+  float   temperature;
+  float   pressure;
+  uint8_t ID;
 
   /*Prepare the ports as well as data structure for data BMP280 operation*/
 
@@ -31,12 +30,11 @@ int main(void) {
   bmp280_init(&sensor280, I2C, BMP280_ADDR);
   bmp280_open(&sensor280);
   bmp280_reset(&sensor280);
-  bmp280_get_calibration_data(&sensor280, &calibParam);
   bmp280_update_setting(&sensor280);
 
   for (;;) {
     printf("\n------------------------------");
-    bmp280_get_temp_press(&sensor280, &temperature, &pressure, calibParam);
+    bmp280_get_temp_press(&sensor280, &temperature, &pressure);
     printf("\nTemperature is %f, Pressure is %f", temperature, pressure);
 
     bmp280_get_id(&sensor280, &ID);